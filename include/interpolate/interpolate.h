@@ -55,6 +55,18 @@ struct intpl_xyc {
     float y2;   /**< Second derivative from the spline. */
 };
 
+/**
+ * Search cursor, remembering the last segment found in a table. Sorted or
+ * slowly changing queries usually land in the same or the next segment, so
+ * the cursor is checked before falling back to a full bisection search.
+ *
+ * Each task or thread should use its own cursor. Set idx to -1 before the
+ * first use, or whenever the table changes.
+ */
+struct intpl_cursor {
+    int idx;    /**< Last segment index, or -1 if unknown. */
+};
+
 /** @} */ /* End of STRUCT group */
 
 /**
@@ -109,6 +121,26 @@ int intpl_lerp(float v0, float v1, float t, float *v);
  */
 int intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx);
 
+/**
+ * Same as intpl_find_x, but starts from an estimate of the position of 'x',
+ * based on where it lies between xy[0].x and xy[n-1].x. This is faster than
+ * bisection for tables where x is close to uniformly spaced.
+ *
+ * The estimate is corrected by galloping (1, 2, 4, ... steps) away from it,
+ * then bisecting the bracket that was found. If the estimate is poor,
+ * galloping stops after a few steps and the rest of the array is bisected,
+ * so the worst case is still O(log n).
+ *
+ * @param xy  The array of float-based X,Y values to search.
+ * @param n   The number of elements in the X,Y array.
+ * @param x   The x value to search for.
+ * @param idx Pointer to the placeholder for the position of x in the X,Y array.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_find_x_guess(struct intpl_xy xy[], unsigned int n, float x,
+    int *idx);
+
 /**
  * Nearest neighbour (AKA 'piecewise constant') interpolation based on floats.
  *
@@ -176,6 +208,21 @@ int intpl_lin_y_arr(struct intpl_xy xy[], unsigned int n, float x, float *y);
 int intpl_lin_x(struct intpl_xy *xy1, struct intpl_xy *xy3,
                 float y2, float *x2);
 
+/**
+ * Linear interpolation for X from a Y value, over an array of XY pairs
+ * where y is monotonic (ascending or descending). This is the inverse of
+ * intpl_lin_y_arr. For tables where y is not monotonic, see
+ * intpl_lin_x_idx in interpolate_inv.h.
+ *
+ * @param xy  The array of XY pairs, with monotonic y (min two!).
+ * @param n   The number of elements in the XY array.
+ * @param y   The Y value to interpolate for.
+ * @param x   Pointer to the placeholder for the interpolated X value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_lin_x_arr(struct intpl_xy xy[], unsigned int n, float y, float *x);
+
 /**
  * Calculates xyc[n].y2 for natural cubic spline interpolation, based on the
  * assigned xyc[n].x and xyc[n].y values.
@@ -203,6 +250,91 @@ int intpl_cubic_calc (struct intpl_xyc xyc[], unsigned int n,
 int intpl_cubic_arr(struct intpl_xyc xyc[], unsigned int n,
     float x, float *y);
 
+/**
+ * Same as intpl_find_x, but checks the segment remembered in 'cur' (and the
+ * one after it) before searching the full array.
+ *
+ * @param xy  The array of float-based X,Y values to search.
+ * @param n   The number of elements in the X,Y array.
+ * @param x   The x value to search for.
+ * @param cur The search cursor, updated on success.
+ * @param idx Pointer to the placeholder for the position of x in the X,Y array.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_find_x_cur(struct intpl_xy xy[], unsigned int n, float x,
+    struct intpl_cursor *cur, int *idx);
+
+/**
+ * Nearest neighbour interpolation for an array of X values, using a search
+ * cursor to avoid a full search when consecutive values are close together.
+ *
+ * @param xy  The array of XY pairs to use when interpolating (min two!).
+ * @param n   The number of elements in the XY array.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the interpolated Y values.
+ * @param cnt The number of elements in the x and y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_nn_batch(struct intpl_xy xy[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur);
+
+/**
+ * Linear interpolation for an array of X values, using a search cursor to
+ * avoid a full search when consecutive values are close together.
+ *
+ * @param xy  The array of XY pairs to use when interpolating (min two!).
+ * @param n   The number of elements in the XY array.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the interpolated Y values.
+ * @param cnt The number of elements in the x and y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_lin_y_batch(struct intpl_xy xy[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur);
+
+/**
+ * intpl_lin_x_arr for an array of Y values, using a search cursor to
+ * avoid a full search when consecutive values are close together.
+ *
+ * @param xy  The array of XY pairs, with monotonic y (min two!).
+ * @param n   The number of elements in the XY array.
+ * @param y   The array of Y values to interpolate for.
+ * @param x   The array of placeholders for the interpolated X values.
+ * @param cnt The number of elements in the y and x arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; x[i] is set to NAN for each y[i] that failed.
+ */
+int intpl_lin_x_batch(struct intpl_xy xy[], unsigned int n, const float y[],
+    float x[], unsigned int cnt, struct intpl_cursor *cur);
+
+/**
+ * Natural cubic spline interpolation for an array of X values, using a
+ * search cursor to avoid a full search when consecutive values are close
+ * together. Unlike intpl_cubic_arr, X values outside of xyc[0].x and
+ * xyc[n-1].x are rejected rather than extrapolated.
+ *
+ * @param xyc The array of X,Y,Y2 values to use when interpolating (min four!).
+ * @param n   The number of elements in the X,Y,Y2 array.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the interpolated Y values.
+ * @param cnt The number of elements in the x and y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_cubic_batch(struct intpl_xyc xyc[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur);
+
 /** @} */ /* End of FUNC group */
 
 #ifdef __cplusplus
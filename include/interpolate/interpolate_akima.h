@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_AKIMA_H_
+#define _INTERPOLATE_AKIMA_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup AKIMA Akima splines
+ *
+ * Akima splines: piecewise cubic Hermite curves whose slope at each knot is
+ * a weighted mean of the neighbouring segment slopes, so a single outlier
+ * only bends the curve next to it, and flat runs stay flat. Unlike
+ * intpl_cubic_calc there is no global solve: each slope depends only on the
+ * two knots on either side, so building a table is O(n) with no heap, and
+ * changing one knot only needs five slopes to be updated.
+ *
+ * Segment slopes past the ends are extrapolated linearly, as in Akima's
+ * original paper.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** An Akima spline knot. Same layout as struct intpl_xyc. */
+struct intpl_xyd {
+    float x;
+    float y;
+    float d;    /**< Slope dy/dx at x, from intpl_akima_calc. */
+};
+
+/**
+ * Calculates xyd[n].d for Akima interpolation, based on the assigned x and
+ * y values.
+ *
+ * @param xyd The array of X,Y,D values, ascending in x.
+ * @param n   The number of elements in the X,Y,D array, at least three.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_akima_calc(struct intpl_xyd xyd[], unsigned int n);
+
+/**
+ * Updates the slopes after knot k has been moved or given a new y value.
+ * The result is the same as calling intpl_akima_calc again.
+ *
+ * @param xyd The array of X,Y,D values, ascending in x.
+ * @param n   The number of elements in the X,Y,D array, at least three.
+ * @param k   The index of the changed knot.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_akima_update(struct intpl_xyd xyd[], unsigned int n,
+    unsigned int k);
+
+/**
+ * Akima spline interpolation.
+ *
+ * @param xyd The array of X,Y,D values, set up by intpl_akima_calc.
+ * @param n   The number of elements in the X,Y,D array, at least three.
+ * @param x   The X value to interpolate for (x >= xyd[0].x, <= xyd[n-1].x).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_akima(const struct intpl_xyd xyd[], unsigned int n, float x,
+    float *y);
+
+/**
+ * intpl_akima for an array of X values, using a search cursor.
+ *
+ * @param xyd The array of X,Y,D values, set up by intpl_akima_calc.
+ * @param n   The number of elements in the X,Y,D array, at least three.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the interpolated Y values.
+ * @param cnt The number of elements in the x and y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_akima_batch(const struct intpl_xyd xyd[], unsigned int n,
+    const float x[], float y[], unsigned int cnt, struct intpl_cursor *cur);
+
+/** @} */ /* End of AKIMA group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_AKIMA_H_ */
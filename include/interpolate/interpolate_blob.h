@@ -0,0 +1,290 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_BLOB_H_
+#define _INTERPOLATE_BLOB_H_
+
+#include <stddef.h>
+#include "interpolate/interpolate.h"
+#include "interpolate/interpolate_mc.h"
+#include "interpolate/interpolate_cheb.h"
+#include "interpolate/interpolate_srch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup BLOB Serialized tables
+ *
+ * A versioned binary format for compiled tables (including precomputed
+ * spline data), designed to be used in place: memory mapped on Linux, or
+ * executed in place from flash on target. Opening a blob only checks the
+ * header, so start-up time does not depend on the size of the table.
+ *
+ * A blob consists of a struct intpl_blob_hdr followed by the table data
+ * and, optionally, a search index. All values are stored in native
+ * (little-endian) byte order, and the blob must be 4-byte aligned.
+ *
+ * The only index type is a bucket index (see the SRCH group), stored as
+ * uint32_t nb followed by the nb + 1 entries of intpl_bkt.first. Its x
+ * range and scale are taken from the table when the blob is opened.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** "INTB", the first four bytes of every blob. */
+#define INTPL_BLOB_MAGIC        (0x42544E49)
+/** Current version of the blob format. */
+#define INTPL_BLOB_VERSION      (1)
+
+/** Table data holds n rows of y2 values after the y values (MC only). */
+#define INTPL_BLOB_F_Y2         (0x01)
+
+/** Table types that can be stored in a blob. */
+enum intpl_blob_kind {
+    /** struct intpl_xy[n], for nearest neighbour and linear lookups. */
+    INTPL_BLOB_XY = 1,
+    /** struct intpl_xyc[n], with y2 already calculated. */
+    INTPL_BLOB_XYC = 2,
+    /** float x[n], float y[n * ch], then optionally float y2[n * ch]. */
+    INTPL_BLOB_MC = 3,
+    /**
+     * A piecewise polynomial fit: float x0, float x1, then float c[n * ch],
+     * with n segments of ch coefficients.
+     */
+    INTPL_BLOB_CHEB = 4,
+};
+
+/** Search index types. Unknown types are ignored by intpl_blob_open. */
+enum intpl_blob_idx {
+    INTPL_BLOB_IDX_NONE = 0,
+    /** Bucket index, for INTPL_BLOB_XY and INTPL_BLOB_XYC blobs. */
+    INTPL_BLOB_IDX_BKT = 1,
+};
+
+/** Blob header, at the start of every blob. */
+struct intpl_blob_hdr {
+    uint32_t magic;     /**< INTPL_BLOB_MAGIC. */
+    uint16_t version;   /**< INTPL_BLOB_VERSION. */
+    uint16_t hdr_len;   /**< Size of this header, in bytes. */
+    uint8_t kind;       /**< Table type, see enum intpl_blob_kind. */
+    uint8_t flags;      /**< INTPL_BLOB_F_* flags. */
+    uint16_t ch;        /**< Channels per row, or coefficients (CHEB). */
+    uint32_t n;         /**< Number of rows in the table. */
+    uint32_t data_off;  /**< Offset of the table data from the blob start. */
+    uint32_t data_len;  /**< Length of the table data, in bytes. */
+    uint16_t idx_kind;  /**< Search index type, see enum intpl_blob_idx. */
+    uint16_t reserved;  /**< Set to 0. */
+    uint32_t idx_off;   /**< Offset of the search index from the blob start. */
+    uint32_t idx_len;   /**< Length of the search index, in bytes. */
+    uint32_t crc;       /**< CRC-32 of everything after the header. */
+};
+
+/** An open blob. Every pointer refers to the blob itself (no copies). */
+struct intpl_blob {
+    const struct intpl_blob_hdr *hdr;
+    const void *data;   /**< The table data. */
+    const void *idx;    /**< The search index, or NULL if there is none. */
+    struct intpl_bkt bkt;   /**< The bucket index, if idx is not NULL. */
+};
+
+/**
+ * Calculates the CRC-32 (IEEE 802.3) of a buffer.
+ *
+ * @param crc  The CRC of any previous data, or 0 to start a new CRC.
+ * @param buf  The data to add to the CRC.
+ * @param len  The length of buf, in bytes.
+ *
+ * @return The updated CRC.
+ */
+uint32_t intpl_blob_crc32(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * Serializes an intpl_xy table into a blob.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param xy      The table to serialize.
+ * @param n       The number of elements in the XY array.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_xy(void *buf, size_t len, const struct intpl_xy xy[],
+    unsigned int n, size_t *out_len);
+
+/**
+ * Serializes an intpl_xy table into a blob, with a bucket index built by
+ * intpl_bkt_init_xy for the same table.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param xy      The table to serialize.
+ * @param n       The number of elements in the XY array.
+ * @param bkt     The bucket index over xy.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_xy_bkt(void *buf, size_t len, const struct intpl_xy xy[],
+    unsigned int n, const struct intpl_bkt *bkt, size_t *out_len);
+
+/**
+ * Serializes an intpl_xyc table, after intpl_cubic_calc, into a blob.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param xyc     The table to serialize.
+ * @param n       The number of elements in the X,Y,Y2 array.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_xyc(void *buf, size_t len, const struct intpl_xyc xyc[],
+    unsigned int n, size_t *out_len);
+
+/**
+ * Serializes an intpl_xyc table into a blob, with a bucket index built by
+ * intpl_bkt_init_xyc for the same table.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param xyc     The table to serialize.
+ * @param n       The number of elements in the X,Y,Y2 array.
+ * @param bkt     The bucket index over xyc.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_xyc_bkt(void *buf, size_t len,
+    const struct intpl_xyc xyc[], unsigned int n, const struct intpl_bkt *bkt,
+    size_t *out_len);
+
+/**
+ * Serializes a multi-channel table into a blob. mc->y2 is included if it
+ * is not NULL.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param mc      The table to serialize.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_mc(void *buf, size_t len, const struct intpl_mc *mc,
+    size_t *out_len);
+
+/**
+ * Serializes a piecewise polynomial fit from intpl_cheb_fit into a blob.
+ *
+ * @param buf     The 4-byte aligned output buffer.
+ * @param len     The size of buf, in bytes.
+ * @param cheb    The fit to serialize.
+ * @param out_len Pointer to the placeholder for the blob length.
+ *
+ * @return 0 on success, OS_ENOMEM if buf is too small, error code on error.
+ */
+int intpl_blob_write_cheb(void *buf, size_t len,
+    const struct intpl_cheb *cheb, size_t *out_len);
+
+/**
+ * Opens a blob in place. The header is always validated; the CRC is only
+ * checked if 'verify' is set, since that requires reading the whole blob.
+ * A bucket index is used by the lookups below; other index types are
+ * ignored.
+ *
+ * @param buf    The 4-byte aligned blob, in RAM, flash or a memory mapping.
+ * @param len    The number of bytes available at buf.
+ * @param verify Non-zero to check the CRC.
+ * @param blob   Pointer to the blob to initialise.
+ *
+ * @return 0 on success, OS_EINVAL if the blob is invalid.
+ */
+int intpl_blob_open(const void *buf, size_t len, int verify,
+    struct intpl_blob *blob);
+
+/**
+ * Nearest neighbour interpolation from an INTPL_BLOB_XY blob. The segment is
+ * located with the bucket index, if the blob has one.
+ *
+ * @param blob The open blob.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_blob_nn(const struct intpl_blob *blob, float x, float *y);
+
+/**
+ * Linear interpolation from an INTPL_BLOB_XY blob. The segment is located
+ * with the bucket index, if the blob has one.
+ *
+ * @param blob The open blob.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_blob_lin_y(const struct intpl_blob *blob, float x, float *y);
+
+/**
+ * Cubic spline interpolation from an INTPL_BLOB_XYC blob, using the stored
+ * y2 values (intpl_cubic_calc is not needed). The segment is located with
+ * the bucket index, if the blob has one. Unlike intpl_cubic_arr, x outside
+ * of the table is an error, with or without an index.
+ *
+ * @param blob The open blob.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_blob_cubic(const struct intpl_blob *blob, float x, float *y);
+
+/**
+ * Points a multi-channel table at the data in an INTPL_BLOB_MC blob, for
+ * use with the intpl_mc_* functions. mc->y2 is set to NULL if the blob has
+ * no y2 values. The y2 values must not be recalculated in place.
+ *
+ * @param blob The open blob.
+ * @param mc   Pointer to the table to initialise.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_blob_mc(const struct intpl_blob *blob, struct intpl_mc *mc);
+
+/**
+ * Points a piecewise polynomial fit at the data in an INTPL_BLOB_CHEB blob,
+ * for use with intpl_cheb and intpl_cheb_batch.
+ *
+ * @param blob The open blob.
+ * @param cheb Pointer to the fit to initialise.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_blob_cheb(const struct intpl_blob *blob, struct intpl_cheb *cheb);
+
+/** @} */ /* End of BLOB group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_BLOB_H_ */
@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_CHEB_H_
+#define _INTERPOLATE_CHEB_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CHEB Piecewise polynomial fits
+ *
+ * Compact approximations of smooth tabulated curves. intpl_cheb_fit splits
+ * the range of an intpl_xy table into a few equal segments and fits each
+ * one with a Chebyshev interpolant, choosing the smallest number of
+ * coefficients that keeps every table point within a given tolerance.
+ *
+ * The coefficients are stored in the power basis of the local variable
+ * u = -1..1 across each segment, so evaluation is a multiply to find the
+ * segment and a Horner loop of fixed length, with no search or branches
+ * that depend on the data.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** The highest polynomial degree tried by intpl_cheb_fit. */
+#define INTPL_CHEB_MAX_DEG      (8)
+
+/** A piecewise polynomial over uniform segments. */
+struct intpl_cheb {
+    float x0;           /**< Start of the range. */
+    float x1;           /**< End of the range. */
+    float inv_w;        /**< Segments per unit of x, nseg / (x1 - x0). */
+    unsigned int nseg;  /**< Number of segments. */
+    unsigned int nc;    /**< Coefficients per segment (degree + 1). */
+    /** nseg * nc coefficients, highest power of u first per segment. */
+    const float *c;
+};
+
+/**
+ * Fits a piecewise polynomial to an intpl_xy table. The curve between the
+ * table points is taken to be the cubic through the four nearest points.
+ *
+ * @param cheb  The fit to initialise. cheb->c is set to c.
+ * @param xy    The table to fit, ascending in x.
+ * @param n     The number of elements in the XY array (min two!).
+ * @param tol   The largest allowed error at any table point.
+ * @param c     The buffer for the coefficients.
+ * @param max_c The size of c, in floats.
+ *
+ * @return 0 on success, OS_ENOMEM if no fit within max_c coefficients meets
+ *         tol, error code on error.
+ */
+int intpl_cheb_fit(struct intpl_cheb *cheb, const struct intpl_xy xy[],
+    unsigned int n, float tol, float c[], unsigned int max_c);
+
+/**
+ * Evaluates a piecewise polynomial fit.
+ *
+ * @param cheb The fit, from intpl_cheb_fit or intpl_blob_cheb.
+ * @param x    The X value to evaluate for (x >= cheb->x0, <= cheb->x1).
+ * @param y    Pointer to the placeholder for the Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_cheb(const struct intpl_cheb *cheb, float x, float *y);
+
+/**
+ * intpl_cheb for an array of X values. The values do not need to be sorted.
+ *
+ * @param cheb The fit, from intpl_cheb_fit or intpl_blob_cheb.
+ * @param x    The array of X values to evaluate for.
+ * @param y    The array of placeholders for the Y values.
+ * @param cnt  The number of elements in the x and y arrays.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_cheb_batch(const struct intpl_cheb *cheb, const float x[],
+    float y[], unsigned int cnt);
+
+/** @} */ /* End of CHEB group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_CHEB_H_ */
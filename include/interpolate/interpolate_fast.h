@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_FAST_H_
+#define _INTERPOLATE_FAST_H_
+
+#include <math.h>
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup FAST Unchecked inline evaluators
+ *
+ * static inline evaluators for callers who have already validated their
+ * inputs, such as tables checked once at start-up. There are no error
+ * codes and no stats, so the compiler can inline them into the caller's
+ * loops and vectorise those loops. They use FMA when the target has it in
+ * hardware, and multiply by reciprocals rather than divide where the
+ * divisor can be shared.
+ *
+ * Out of range inputs are not detected: x outside a table extrapolates
+ * from the end segments, and a zero-width segment gives inf or NAN.
+ *
+ * When INTERPOLATE_FAST_CHECKED is set, as in debug builds, each
+ * evaluator does the same checks as the checked functions instead (calling
+ * them where they exist) and returns NAN for invalid input.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** a * b + c, fused when the target does that in hardware. */
+#if defined(FP_FAST_FMAF)
+#define INTPL_FAST_FMA(a, b, c)     fmaf((a), (b), (c))
+#else
+#define INTPL_FAST_FMA(a, b, c)     ((a) * (b) + (c))
+#endif
+
+/**
+ * Linear interpolation between two values.
+ *
+ * @param v0 The lower value.
+ * @param v1 The upper value.
+ * @param t  The interpolation factor between 0.0f and 1.0f.
+ *
+ * @return The interpolated value.
+ */
+static inline float
+intpl_fast_lerp(float v0, float v1, float t)
+{
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    float v;
+
+    intpl_lerp(v0, v1, t, &v);
+    return v;
+#else
+    return INTPL_FAST_FMA(t, v1 - v0, v0);
+#endif
+}
+
+/**
+ * Linear interpolation between two XY pairs.
+ *
+ * @param xy1 The lower XY pair.
+ * @param xy3 The upper XY pair.
+ * @param x   The X value to interpolate for.
+ *
+ * @return The interpolated Y value.
+ */
+static inline float
+intpl_fast_lin_y(const struct intpl_xy *xy1, const struct intpl_xy *xy3,
+    float x)
+{
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    float y;
+
+    intpl_lin_y((struct intpl_xy *)xy1, (struct intpl_xy *)xy3, x, &y);
+    return y;
+#else
+    return INTPL_FAST_FMA(x - xy1->x,
+        (xy3->y - xy1->y) / (xy3->x - xy1->x), xy1->y);
+#endif
+}
+
+/**
+ * Nearest neighbour interpolation between two XY pairs, switching at the
+ * midpoint and rounding up on it.
+ *
+ * @param xy1 The lower XY pair.
+ * @param xy3 The upper XY pair.
+ * @param x   The X value to interpolate for.
+ *
+ * @return The Y value of the nearest pair.
+ */
+static inline float
+intpl_fast_nn(const struct intpl_xy *xy1, const struct intpl_xy *xy3,
+    float x)
+{
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    /* intpl_nn rounds differently, so check here instead. */
+    if ((xy3->x - xy1->x < 1E-6F) || (x < xy1->x) || (x > xy3->x)) {
+        return NAN;
+    }
+#endif
+    return (x >= xy1->x + 0.5f * (xy3->x - xy1->x)) ? xy3->y : xy1->y;
+}
+
+/**
+ * Finds the segment of an ascending table containing x, without branches
+ * in the search loop. x below the table gives 0, and x above it gives
+ * n - 2.
+ *
+ * @param xy The array of XY pairs, ascending in x (min two!).
+ * @param n  The number of elements in the XY array.
+ * @param x  The X value to search for.
+ *
+ * @return The lower segment index.
+ */
+static inline unsigned int
+intpl_fast_find(const struct intpl_xy xy[], unsigned int n, float x)
+{
+    const struct intpl_xy *base;
+    unsigned int len;
+    unsigned int half;
+
+    base = xy;
+    len = n - 1;
+    while (len > 1) {
+        half = len >> 1;
+        base = (base[half].x <= x) ? base + half : base;
+        len -= half;
+    }
+
+    return (unsigned int)(base - xy);
+}
+
+/**
+ * Linear interpolation in an ascending table.
+ *
+ * @param xy The array of XY pairs, ascending in x (min two!).
+ * @param n  The number of elements in the XY array.
+ * @param x  The X value to interpolate for.
+ *
+ * @return The interpolated Y value.
+ */
+static inline float
+intpl_fast_lin_arr(const struct intpl_xy xy[], unsigned int n, float x)
+{
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    float y;
+
+    intpl_lin_y_arr((struct intpl_xy *)xy, n, x, &y);
+    return y;
+#else
+    unsigned int i;
+
+    i = intpl_fast_find(xy, n, x);
+    return intpl_fast_lin_y(&xy[i], &xy[i + 1], x);
+#endif
+}
+
+/**
+ * Linear interpolation on a uniform grid, y[i] at x0 + i * dx, with the
+ * division by dx done once by the caller.
+ *
+ * @param y      The Y values (min two!).
+ * @param n      The number of Y values.
+ * @param x0     The X value of y[0].
+ * @param inv_dx The reciprocal of the grid step, 1.0f / dx.
+ * @param x      The X value to interpolate for.
+ *
+ * @return The interpolated Y value.
+ */
+static inline float
+intpl_fast_lin_uni(const float y[], unsigned int n, float x0, float inv_dx,
+    float x)
+{
+    float u;
+    int i;
+
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    if ((n < 2) || !(inv_dx > 0.0f) || (x < x0) ||
+        ((x - x0) * inv_dx > (float)(n - 1))) {
+        return NAN;
+    }
+#endif
+    u = (x - x0) * inv_dx;
+    i = (int)u;
+    i = (i < 0) ? 0 : i;
+    i = (i > (int)n - 2) ? (int)n - 2 : i;
+
+    return INTPL_FAST_FMA(u - (float)i, y[i + 1] - y[i], y[i]);
+}
+
+/**
+ * Evaluates one segment of a cubic spline from intpl_cubic_calc.
+ *
+ * @param lo The lower knot; lo[1] is the upper knot.
+ * @param x  The X value to interpolate for.
+ *
+ * @return The interpolated Y value.
+ */
+static inline float
+intpl_fast_cubic_seg(const struct intpl_xyc *lo, float x)
+{
+    const struct intpl_xyc *hi;
+    float h;
+    float r;
+    float a;
+    float b;
+
+    hi = lo + 1;
+    h = hi->x - lo->x;
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    if ((h == 0.0f) || (x < lo->x) || (x > hi->x)) {
+        return NAN;
+    }
+#endif
+    /* One reciprocal, shared by both weights. */
+    r = 1.0f / h;
+    a = (hi->x - x) * r;
+    b = 1.0f - a;
+
+    return INTPL_FAST_FMA(a, lo->y, b * hi->y) +
+        INTPL_FAST_FMA(a * a - 1.0f, a * lo->y2, (b * b - 1.0f) * b * hi->y2) *
+        (h * h * (1.0f / 6.0f));
+}
+
+/** @} */ /* End of FAST group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_FAST_H_ */
@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_INV_H_
+#define _INTERPOLATE_INV_H_
+
+#include <stddef.h>
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup INV Inverse lookups
+ *
+ * Finds x for a given y. For tables where y is monotonic, the segment is
+ * found by searching the y values directly, see intpl_lin_x_arr.
+ *
+ * Where y is not monotonic, several x values can map to the same y. A
+ * y-range index, built once per table, stores the minimum and maximum y of
+ * every segment, and of every block of INTPL_YIDX_BLK segments, so that
+ * whole blocks can be skipped. For cubic splines the range includes any
+ * extremum inside the segment. Lookups through the index return the
+ * solution with the lowest x.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Number of segments per block in a y-range index. */
+#define INTPL_YIDX_BLK  (16)
+
+/** Per-segment y-range index, see intpl_yidx_init_xy. */
+struct intpl_yidx {
+    float *seg;         /**< n - 1 (min, max) pairs, one per segment. */
+    float *blk;         /**< (min, max) pairs, one per block of segments. */
+    unsigned int n;     /**< The number of values in the indexed table. */
+    unsigned int nblk;  /**< The number of blocks. */
+};
+
+/**
+ * Returns the number of bytes needed for the y-range index of a table with
+ * n values.
+ *
+ * @param n   The number of values in the table.
+ *
+ * @return The size in bytes.
+ */
+size_t intpl_yidx_size(unsigned int n);
+
+/**
+ * Builds a y-range index for a linear table.
+ *
+ * @param yi  The index to initialise.
+ * @param buf Storage for the index, at least intpl_yidx_size(n) bytes and
+ *            aligned for float. Must outlive the index.
+ * @param len The size of buf, in bytes.
+ * @param xy  The table, with ascending x values.
+ * @param n   The number of values in xy, at least two.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_yidx_init_xy(struct intpl_yidx *yi, void *buf, size_t len,
+    const struct intpl_xy xy[], unsigned int n);
+
+/**
+ * Builds a y-range index for a cubic spline. intpl_cubic_calc must have
+ * been called on xyc first, and the index rebuilt if it is called again.
+ *
+ * @param yi  The index to initialise.
+ * @param buf Storage for the index, at least intpl_yidx_size(n) bytes and
+ *            aligned for float. Must outlive the index.
+ * @param len The size of buf, in bytes.
+ * @param xyc The spline, with ascending x values.
+ * @param n   The number of values in xyc, at least three.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_yidx_init_xyc(struct intpl_yidx *yi, void *buf, size_t len,
+    const struct intpl_xyc xyc[], unsigned int n);
+
+/**
+ * Finds the lowest x where the linear table reaches y, using a y-range
+ * index built by intpl_yidx_init_xy.
+ *
+ * @param xy  The table, with ascending x values.
+ * @param n   The number of values in xy.
+ * @param yi  The y-range index for xy.
+ * @param y   The Y value to interpolate for.
+ * @param x   Pointer to the placeholder for the interpolated X value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_lin_x_idx(const struct intpl_xy xy[], unsigned int n,
+    const struct intpl_yidx *yi, float y, float *x);
+
+/**
+ * intpl_lin_x_idx for an array of Y values.
+ *
+ * @param xy  The table, with ascending x values.
+ * @param n   The number of values in xy.
+ * @param yi  The y-range index for xy.
+ * @param y   The array of Y values to interpolate for.
+ * @param x   The array of placeholders for the interpolated X values.
+ * @param cnt The number of elements in the y and x arrays.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; x[i] is set to NAN for each y[i] that failed.
+ */
+int intpl_lin_x_idx_batch(const struct intpl_xy xy[], unsigned int n,
+    const struct intpl_yidx *yi, const float y[], float x[],
+    unsigned int cnt);
+
+/**
+ * Finds x where the cubic spline reaches y.
+ *
+ * With a y-range index, the lowest such x is returned. Without one (yi is
+ * NULL), the y values at the knots must be monotonic; the segment is found
+ * by searching them, and its neighbours are also tried, in case the spline
+ * overshoots between knots.
+ *
+ * Within the segment, x is found by Newton's method, safeguarded by
+ * bisection, on a monotonic piece of the cubic.
+ *
+ * @param xyc The spline, with ascending x values.
+ * @param n   The number of values in xyc, at least three.
+ * @param yi  The y-range index for xyc, or NULL.
+ * @param y   The Y value to interpolate for.
+ * @param x   Pointer to the placeholder for the interpolated X value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_x(const struct intpl_xyc xyc[], unsigned int n,
+    const struct intpl_yidx *yi, float y, float *x);
+
+/**
+ * intpl_cubic_x for an array of Y values. Without a y-range index, a
+ * search cursor is used to avoid a full search when consecutive values are
+ * close together.
+ *
+ * @param xyc The spline, with ascending x values.
+ * @param n   The number of values in xyc, at least three.
+ * @param yi  The y-range index for xyc, or NULL.
+ * @param y   The array of Y values to interpolate for.
+ * @param x   The array of placeholders for the interpolated X values.
+ * @param cnt The number of elements in the y and x arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; x[i] is set to NAN for each y[i] that failed.
+ */
+int intpl_cubic_x_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const struct intpl_yidx *yi, const float y[], float x[],
+    unsigned int cnt, struct intpl_cursor *cur);
+
+/** @} */ /* End of INV group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_INV_H_ */
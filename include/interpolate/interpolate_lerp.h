@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_LERP_H_
+#define _INTERPOLATE_LERP_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup LERP Array lerp and easing
+ *
+ * intpl_lerp over whole arrays, such as blending frame buffers or moving
+ * arrays of positions, so that the cost is bound by memory rather than by
+ * one call and range check per value.
+ *
+ * The float kernels use SSE when the target supports it, and are written
+ * so that the compiler can vectorise them otherwise. The colour kernels
+ * use 8-bit fixed point factors, where t8 = 0 gives a and t8 = 256 gives
+ * b.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Easing curves for intpl_ease, mapping t in 0..1 to 0..1. */
+enum intpl_ease_kind {
+    INTPL_EASE_LINEAR = 0,          /**< t */
+    INTPL_EASE_IN_QUAD = 1,         /**< t^2 */
+    INTPL_EASE_OUT_QUAD = 2,        /**< 1 - (1 - t)^2 */
+    INTPL_EASE_IN_OUT_QUAD = 3,     /**< Quadratic in, then out. */
+    INTPL_EASE_IN_CUBIC = 4,        /**< t^3 */
+    INTPL_EASE_OUT_CUBIC = 5,       /**< 1 - (1 - t)^3 */
+    INTPL_EASE_IN_OUT_CUBIC = 6,    /**< Cubic in, then out. */
+    INTPL_EASE_SMOOTHSTEP = 7,      /**< 3t^2 - 2t^3 */
+    INTPL_EASE_SMOOTHERSTEP = 8,    /**< 6t^5 - 15t^4 + 10t^3 */
+};
+
+/**
+ * Interpolates between two arrays with a single factor,
+ * v[i] = (1 - t) * v0[i] + t * v1[i]. t is checked once for the whole
+ * array. v may be the same array as v0 or v1.
+ *
+ * @param v0  The lower values.
+ * @param v1  The upper values.
+ * @param t   The interpolation factor between 0.0f and 1.0f.
+ * @param v   The array of placeholders for the interpolated values.
+ * @param cnt The number of elements in each array.
+ *
+ * @return 0 on success, error code on error. All of v is set to NAN if t
+ *         is out of range.
+ */
+int intpl_lerp_arr(const float v0[], const float v1[], float t, float v[],
+    unsigned int cnt);
+
+/**
+ * Interpolates between two arrays, with a factor per element.
+ *
+ * @param v0  The lower values.
+ * @param v1  The upper values.
+ * @param t   The interpolation factors, each between 0.0f and 1.0f.
+ * @param v   The array of placeholders for the interpolated values.
+ * @param cnt The number of elements in each array.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; v[i] is set to NAN for each t[i] that is out of range.
+ */
+int intpl_lerp_arr_t(const float v0[], const float v1[], const float t[],
+    float v[], unsigned int cnt);
+
+/**
+ * Same as intpl_lerp_arr_t, but clamps each factor to 0.0f..1.0f instead
+ * of checking it, so that no value is ever set to NAN (except for NAN
+ * factors). This is the fastest variant.
+ *
+ * @param v0  The lower values.
+ * @param v1  The upper values.
+ * @param t   The interpolation factors.
+ * @param v   The array of placeholders for the interpolated values.
+ * @param cnt The number of elements in each array.
+ */
+void intpl_lerp_arr_clamp(const float v0[], const float v1[],
+    const float t[], float v[], unsigned int cnt);
+
+/**
+ * Applies an easing curve to t, clamped to 0.0f..1.0f.
+ *
+ * @param kind The easing curve, see enum intpl_ease_kind.
+ * @param t    The linear factor.
+ *
+ * @return The eased factor, or NAN if kind is unknown.
+ */
+float intpl_ease(uint8_t kind, float t);
+
+/**
+ * Applies an easing curve to an array of factors. t and out may be the
+ * same array.
+ *
+ * @param kind The easing curve, see enum intpl_ease_kind.
+ * @param t    The linear factors, clamped to 0.0f..1.0f.
+ * @param out  The array of placeholders for the eased factors.
+ * @param cnt  The number of elements in each array.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ease_arr(uint8_t kind, const float t[], float out[],
+    unsigned int cnt);
+
+/**
+ * Blends two RGB565 buffers. The factor is reduced to 5 bits, so that all
+ * three channels are blended at once in a 32-bit word.
+ *
+ * @param a   The first buffer (t8 = 0).
+ * @param b   The second buffer (t8 = 256).
+ * @param t8  The blend factor, from 0 to 256.
+ * @param out The output buffer, which may be the same as a or b.
+ * @param cnt The number of pixels.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_lerp_rgb565(const uint16_t a[], const uint16_t b[], uint16_t t8,
+    uint16_t out[], unsigned int cnt);
+
+/**
+ * Blends two buffers of 8-bit channels, such as RGB888 or RGBA8888, one
+ * byte at a time.
+ *
+ * @param a   The first buffer (t8 = 0).
+ * @param b   The second buffer (t8 = 256).
+ * @param t8  The blend factor, from 0 to 256.
+ * @param out The output buffer, which may be the same as a or b.
+ * @param cnt The number of bytes (3 per RGB888 pixel).
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_lerp_rgb888(const uint8_t a[], const uint8_t b[], uint16_t t8,
+    uint8_t out[], unsigned int cnt);
+
+/** @} */ /* End of LERP group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_LERP_H_ */
@@ -0,0 +1,116 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_MC_H_
+#define _INTERPOLATE_MC_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MC Multi-channel tables
+ *
+ * Tables where a single X value maps to several Y values (channels). The
+ * segment containing X is located once, and all channels are interpolated
+ * from the same segment.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Multi-channel table, where each x maps to 'ch' y values. */
+struct intpl_mc {
+    const float *x;     /**< n monotonic x values. */
+    const float *y;     /**< n rows of ch y values, stored row by row. */
+    float *y2;          /**< n rows of ch second derivatives (cubic only). */
+    unsigned int n;     /**< The number of rows (x values) in the table. */
+    unsigned int ch;    /**< The number of channels (y values) per row. */
+};
+
+/**
+ * Uses bisection to search the multi-channel table for the segment
+ * containing 'x'. See intpl_find_x for details.
+ *
+ * @param mc  The multi-channel table to search.
+ * @param x   The x value to search for.
+ * @param idx Pointer to the placeholder for the position of x in the table.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_mc_find_x(const struct intpl_mc *mc, float x, int *idx);
+
+/**
+ * Nearest neighbour interpolation of every channel in a multi-channel table.
+ *
+ * @param mc  The multi-channel table to use when interpolating (min two!).
+ * @param x   The X value to interpolate for (x >= x[0], <= x[n-1]).
+ * @param y   Array of mc->ch placeholders for the interpolated Y values.
+ *
+ * @return 0 on success, error code on error. All channels are set to NAN on
+ *         error.
+ */
+int intpl_mc_nn(const struct intpl_mc *mc, float x, float y[]);
+
+/**
+ * Linear interpolation of every channel in a multi-channel table.
+ *
+ * @param mc  The multi-channel table to use when interpolating (min two!).
+ * @param x   The X value to interpolate for (x >= x[0], <= x[n-1]).
+ * @param y   Array of mc->ch placeholders for the interpolated Y values.
+ *
+ * @return 0 on success, error code on error. All channels are set to NAN on
+ *         error.
+ */
+int intpl_mc_lin_y(const struct intpl_mc *mc, float x, float y[]);
+
+/**
+ * Calculates mc->y2 for natural cubic spline interpolation of every channel.
+ * The tridiagonal factorisation only depends on x, so it is computed once and
+ * shared by all channels.
+ *
+ * @param mc  The multi-channel table, where mc->y2 points to n * ch floats.
+ *
+ * @return 0 on success, error code on error.
+ *
+ * NOTE: This function must be called BEFORE using intpl_mc_cubic.
+ */
+int intpl_mc_cubic_calc(struct intpl_mc *mc);
+
+/**
+ * Natural cubic spline interpolation of every channel in a multi-channel
+ * table.
+ *
+ * @param mc  The multi-channel table to use when interpolating (min three!).
+ * @param x   The X value to interpolate for (x >= x[0], <= x[n-1]).
+ * @param y   Array of mc->ch placeholders for the interpolated Y values.
+ *
+ * @return 0 on success, error code on error. All channels are set to NAN on
+ *         error.
+ */
+int intpl_mc_cubic(const struct intpl_mc *mc, float x, float y[]);
+
+/** @} */ /* End of MC group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_MC_H_ */
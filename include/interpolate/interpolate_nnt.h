@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_NNT_H_
+#define _INTERPOLATE_NNT_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup NNT Nearest neighbour tables
+ *
+ * Nearest neighbour lookups with the midpoints between consecutive x
+ * values computed once, so that a lookup is a single search over the
+ * midpoints: the number of midpoints at or below x is the index of the
+ * nearest point. x values exactly on a midpoint round to the later point,
+ * like intpl_nn.
+ *
+ * Tables may be ascending or descending in x. Midpoints of descending
+ * tables are stored negated, so both orders share one search.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** A nearest neighbour table. */
+struct intpl_nnt {
+    const struct intpl_xy *xy;  /**< The XY pairs. */
+    float *mid;                 /**< The n - 1 midpoints, times sign. */
+    unsigned int n;             /**< The number of XY pairs. */
+    float sign;                 /**< 1.0f if ascending, -1.0f if not. */
+    float lo;                   /**< xy[0].x times sign. */
+    float hi;                   /**< xy[n-1].x times sign. */
+};
+
+/**
+ * Computes the midpoints of a table.
+ *
+ * @param nnt The table to initialise.
+ * @param xy  The XY pairs, monotonic in x, which must stay valid while nnt
+ *            is used.
+ * @param n   The number of XY pairs (min two!).
+ * @param mid Storage for n - 1 midpoints, owned by the caller.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_nnt_init(struct intpl_nnt *nnt, const struct intpl_xy xy[],
+    unsigned int n, float mid[]);
+
+/**
+ * Finds the index of the point nearest to x.
+ *
+ * @param nnt The table.
+ * @param x   The X value (between xy[0].x and xy[n-1].x).
+ * @param idx Pointer to the placeholder for the index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_nnt_idx(const struct intpl_nnt *nnt, float x, unsigned int *idx);
+
+/**
+ * Nearest neighbour interpolation from a table.
+ *
+ * @param nnt The table.
+ * @param x   The X value (between xy[0].x and xy[n-1].x).
+ * @param y   Pointer to the placeholder for the Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_nnt(const struct intpl_nnt *nnt, float x, float *y);
+
+/**
+ * Nearest neighbour interpolation from a table for an array of X values in
+ * any order.
+ *
+ * @param nnt The table.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the Y values.
+ * @param cnt The number of elements in x and y.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that fails.
+ */
+int intpl_nnt_batch(const struct intpl_nnt *nnt, const float x[], float y[],
+    unsigned int cnt);
+
+/**
+ * Same as intpl_nnt_batch, for X values sorted in the same direction as
+ * the table. The table and the X values are walked together, so the whole
+ * batch costs O(n + cnt) rather than O(cnt log n). An X value out of order
+ * falls back to a search, so the results are the same either way.
+ *
+ * @param nnt The table.
+ * @param x   The array of sorted X values to interpolate for.
+ * @param y   The array of placeholders for the Y values.
+ * @param cnt The number of elements in x and y.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that fails.
+ */
+int intpl_nnt_sorted(const struct intpl_nnt *nnt, const float x[], float y[],
+    unsigned int cnt);
+
+/** @} */ /* End of NNT group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_NNT_H_ */
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_PAR_H_
+#define _INTERPOLATE_PAR_H_
+
+#include "interpolate/interpolate.h"
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup PAR Parallel batch processing
+ *
+ * Splits large batches of X values across a pool of worker threads. Each
+ * worker uses its own search cursor, so no search state is shared between
+ * threads.
+ *
+ * Worker threads require INTERPOLATE_PTHREAD (native builds). Without it,
+ * a pool runs every part on the calling task, so the same code can be used
+ * on target.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/**
+ * Work function run by every thread in a pool.
+ *
+ * @param arg    The argument passed to intpl_pool_run.
+ * @param part   The index of the part to process (0..nparts-1).
+ * @param nparts The total number of parts.
+ */
+typedef void intpl_pool_fn(void *arg, unsigned int part, unsigned int nparts);
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+struct intpl_pool;
+
+/** Worker thread state, internal to intpl_pool. */
+struct intpl_pool_worker {
+    struct intpl_pool *pool;
+    pthread_t thread;
+    unsigned int part;
+};
+#endif
+
+/** Worker pool. The calling thread always processes part 0. */
+struct intpl_pool {
+    unsigned int nthreads;  /**< Number of parts, including the caller. */
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    struct intpl_pool_worker workers[MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS)];
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned int gen;       /**< Incremented for every run. */
+    unsigned int busy;      /**< Workers still processing the current run. */
+    int stop;
+    intpl_pool_fn *fn;
+    void *arg;
+#endif
+};
+
+/**
+ * Initialises a worker pool and starts its threads.
+ *
+ * @param pool     The pool to initialise.
+ * @param nthreads The number of threads, including the caller (1 or more,
+ *                 capped to INTERPOLATE_POOL_MAX_THREADS).
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_pool_init(struct intpl_pool *pool, unsigned int nthreads);
+
+/**
+ * Stops the threads in a worker pool.
+ *
+ * @param pool The pool to stop.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_pool_deinit(struct intpl_pool *pool);
+
+/**
+ * Calls fn(arg, part, nthreads) once for every part, in parallel, and waits
+ * for all of them to complete. Only one run may be active per pool.
+ *
+ * @param pool The pool to run on.
+ * @param fn   The work function.
+ * @param arg  The argument passed to fn.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_pool_run(struct intpl_pool *pool, intpl_pool_fn *fn, void *arg);
+
+/**
+ * Parallel version of intpl_nn_batch.
+ *
+ * @param pool   The pool to run on.
+ * @param xy     The array of XY pairs to use when interpolating (min two!).
+ * @param n      The number of elements in the XY array.
+ * @param x      The array of X values to interpolate for.
+ * @param y      The array of placeholders for the interpolated Y values.
+ * @param cnt    The number of elements in the x and y arrays.
+ * @param sorted Non-zero if x is sorted in the same order as the table. The
+ *               work is then split on table segment boundaries, so every
+ *               worker only walks its own segments.
+ *
+ * @return 0 on success, or the first error code encountered.
+ */
+int intpl_par_nn(struct intpl_pool *pool, struct intpl_xy xy[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted);
+
+/**
+ * Parallel version of intpl_lin_y_batch. See intpl_par_nn for parameters.
+ *
+ * @return 0 on success, or the first error code encountered.
+ */
+int intpl_par_lin_y(struct intpl_pool *pool, struct intpl_xy xy[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted);
+
+/**
+ * Parallel version of intpl_cubic_batch. See intpl_par_nn for parameters.
+ *
+ * @return 0 on success, or the first error code encountered.
+ */
+int intpl_par_cubic(struct intpl_pool *pool, struct intpl_xyc xyc[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted);
+
+/**
+ * Parallel version of intpl_cubic_calc, for very large tables.
+ *
+ * The table is split into one block of rows per pool thread. Each block is
+ * reduced on its own thread, leaving a small system in the values at the
+ * block edges that is solved on the calling thread, after which every block
+ * is solved in parallel again (partitioned Thomas algorithm). Scratch memory
+ * is n floats, the same as intpl_cubic_calc.
+ *
+ * The result matches intpl_cubic_calc within 1e-4 of the largest |y2|
+ * (float rounding differs, since the equations are solved in another
+ * order). Tables with fewer than four rows per thread are passed to
+ * intpl_cubic_calc directly.
+ *
+ * @param pool The pool to run on.
+ * @param xyc  The array of X,Y,Y2 values to use when interpolating.
+ * @param n    The number of elements in the X,Y,Y2 array.
+ * @param yp1  1st derivative at 1. Set to >= 1e30 for natural spline.
+ * @param ypn  1st derivative at n'th point. Set to >= 1e30 for natural spline.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_par_cubic_calc(struct intpl_pool *pool, struct intpl_xyc xyc[],
+    unsigned int n, float yp1, float ypn);
+
+/** @} */ /* End of PAR group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_PAR_H_ */
@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_PATH_H_
+#define _INTERPOLATE_PATH_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup PATH Bezier and polyline paths
+ *
+ * Evaluation of 2D motion paths, with struct intpl_xy used as a point.
+ *
+ * Bezier curves are evaluated directly from their Bernstein weights,
+ * rather than by repeated lerps between control points, so a cubic costs a
+ * handful of multiplies per point instead of six lerps.
+ *
+ * For constant-speed traversal, a path is reparameterised by arc length:
+ * a polyline keeps the cumulative length at each point, and a Bezier
+ * curve keeps a table of (length, t) pairs built once. A point at a given
+ * distance along the path then costs one table search, which the search
+ * cursor reduces to a step or two when distances are increasing.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Number of chords measured per arc length table interval. */
+#define INTPL_PATH_SUB          (4)
+
+/** A polyline parameterised by arc length. */
+struct intpl_poly {
+    const struct intpl_xy *pts;  /**< The points of the polyline. */
+    float *s;                   /**< Distance along the path per point. */
+    unsigned int n;             /**< The number of points. */
+    float len;                  /**< Total length of the path. */
+};
+
+/** A quadratic or cubic Bezier curve parameterised by arc length. */
+struct intpl_bez_arc {
+    struct intpl_xy p[4];       /**< The control points. */
+    uint8_t deg;                /**< The degree of the curve, 1 to 3. */
+    struct intpl_xy *lut;       /**< (x = length, y = t) table. */
+    unsigned int m;             /**< The number of table entries. */
+    float len;                  /**< Total length of the curve. */
+};
+
+/**
+ * Evaluates a quadratic Bezier curve.
+ *
+ * @param p  The three control points.
+ * @param t  The curve parameter between 0.0f and 1.0f.
+ * @param pt Pointer to the placeholder for the point on the curve.
+ *
+ * @return 0 on success, error code on error. pt is set to NAN on error.
+ */
+int intpl_bezier2(const struct intpl_xy p[3], float t, struct intpl_xy *pt);
+
+/**
+ * Evaluates a cubic Bezier curve.
+ *
+ * @param p  The four control points.
+ * @param t  The curve parameter between 0.0f and 1.0f.
+ * @param pt Pointer to the placeholder for the point on the curve.
+ *
+ * @return 0 on success, error code on error. pt is set to NAN on error.
+ */
+int intpl_bezier3(const struct intpl_xy p[4], float t, struct intpl_xy *pt);
+
+/**
+ * Evaluates a Bezier curve for an array of parameter values.
+ *
+ * @param p   The deg + 1 control points.
+ * @param deg The degree of the curve, 1 to 3.
+ * @param t   The curve parameters, each between 0.0f and 1.0f.
+ * @param out The array of placeholders for the points.
+ * @param cnt The number of elements in t and out.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; out[i] is set to NAN for each t[i] that fails.
+ */
+int intpl_bezier_batch(const struct intpl_xy p[], uint8_t deg,
+    const float t[], struct intpl_xy out[], unsigned int cnt);
+
+/**
+ * Fills a trajectory buffer with cnt points at evenly spaced values of t,
+ * from the first control point to the last.
+ *
+ * @param p   The deg + 1 control points.
+ * @param deg The degree of the curve, 1 to 3.
+ * @param out The array of placeholders for the points.
+ * @param cnt The number of points.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_bezier_fill(const struct intpl_xy p[], uint8_t deg,
+    struct intpl_xy out[], unsigned int cnt);
+
+/**
+ * Builds the arc length table of a Bezier curve. Each of the m - 1 table
+ * intervals is measured with INTPL_PATH_SUB chords; more entries give a
+ * more even speed.
+ *
+ * @param arc The arc length curve to initialise.
+ * @param p   The deg + 1 control points, copied into arc.
+ * @param deg The degree of the curve, 1 to 3.
+ * @param lut The table storage, owned by the caller.
+ * @param m   The number of entries in lut (min two!).
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_bez_arc_init(struct intpl_bez_arc *arc, const struct intpl_xy p[],
+    uint8_t deg, struct intpl_xy lut[], unsigned int m);
+
+/**
+ * Finds the point at a given distance along a Bezier curve.
+ *
+ * @param arc  The arc length curve.
+ * @param dist The distance from the first control point, 0 to arc->len.
+ * @param pt   Pointer to the placeholder for the point.
+ * @param cur  The search cursor, or NULL for a full search.
+ *
+ * @return 0 on success, error code on error. pt is set to NAN on error.
+ */
+int intpl_bez_arc_at(const struct intpl_bez_arc *arc, float dist,
+    struct intpl_xy *pt, struct intpl_cursor *cur);
+
+/**
+ * Fills a trajectory buffer with cnt points evenly spaced along a Bezier
+ * curve, from the first control point to the last.
+ *
+ * @param arc The arc length curve.
+ * @param out The array of placeholders for the points.
+ * @param cnt The number of points.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_bez_arc_fill(const struct intpl_bez_arc *arc,
+    struct intpl_xy out[], unsigned int cnt);
+
+/**
+ * Measures a polyline. Consecutive points may be the same.
+ *
+ * @param poly The polyline to initialise.
+ * @param pts  The points, which must stay valid while poly is used.
+ * @param n    The number of points (min two!).
+ * @param s    Storage for n distances, owned by the caller.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_poly_init(struct intpl_poly *poly, const struct intpl_xy pts[],
+    unsigned int n, float s[]);
+
+/**
+ * Finds the point at a given distance along a polyline.
+ *
+ * @param poly The polyline.
+ * @param dist The distance from the first point, 0 to poly->len.
+ * @param pt   Pointer to the placeholder for the point.
+ * @param cur  The search cursor, or NULL for a full search.
+ *
+ * @return 0 on success, error code on error. pt is set to NAN on error.
+ */
+int intpl_poly_at(const struct intpl_poly *poly, float dist,
+    struct intpl_xy *pt, struct intpl_cursor *cur);
+
+/**
+ * Fills a trajectory buffer with cnt points evenly spaced along a
+ * polyline, from the first point to the last.
+ *
+ * @param poly The polyline.
+ * @param out  The array of placeholders for the points.
+ * @param cnt  The number of points.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_poly_fill(const struct intpl_poly *poly, struct intpl_xy out[],
+    unsigned int cnt);
+
+/** @} */ /* End of PATH group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_PATH_H_ */
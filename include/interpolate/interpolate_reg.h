@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_REG_H_
+#define _INTERPOLATE_REG_H_
+
+#include <stddef.h>
+#include "interpolate/interpolate.h"
+#include "interpolate/interpolate_srch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup REG Table registry
+ *
+ * A registry of many compact source tables, such as calibration curves
+ * kept in flash, of which only a few are in use at any time. The spline
+ * second derivatives and a bucket search index of a table are built the
+ * first time it is looked up, into a block from a fixed-size os_mempool.
+ * When the pool is empty, the least recently used table is dropped to make
+ * room.
+ *
+ * The registry is not thread-safe: callers on more than one task must hold
+ * a mutex around every call, and an entry from intpl_reg_get is only valid
+ * until the next call that may build a table.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** A source table. Sources are passed to intpl_reg_init sorted by id. */
+struct intpl_reg_src {
+    uint32_t id;                /**< Unique table ID. */
+    const struct intpl_xy *xy;  /**< The table, monotonic in x. */
+    unsigned int n;             /**< The number of XY pairs, at least 2. */
+    float yp1;                  /**< Spline slope at xy[0], >= 1e30 natural. */
+    float ypn;                  /**< Spline slope at xy[n-1], >= 1e30 natural. */
+};
+
+/** A built table, in one pool block. */
+struct intpl_reg_ent {
+    struct intpl_reg_ent *prev;     /**< More recently used. */
+    struct intpl_reg_ent *next;     /**< Less recently used. */
+    const struct intpl_reg_src *src;
+    struct intpl_bkt bkt;           /**< Search index over xyc. */
+    struct intpl_xyc xyc[];         /**< Followed by the bucket storage. */
+};
+
+/** The registry. */
+struct intpl_reg {
+    const struct intpl_reg_src *src;
+    unsigned int nsrc;
+    unsigned int max_pts;       /**< Largest table that fits a block. */
+    unsigned int nb;            /**< Buckets per search index. */
+    struct os_mempool pool;
+    struct intpl_reg_ent *mru;  /**< Most recently used entry. */
+    struct intpl_reg_ent *lru;  /**< Least recently used entry. */
+    uint32_t hits;              /**< Lookups of a built table. */
+    uint32_t misses;            /**< Lookups that built a table. */
+    uint32_t evictions;         /**< Tables dropped to make room. */
+};
+
+/**
+ * The pool block size for tables of up to max_pts points, with nb buckets
+ * per index. It is rounded up to a multiple of sizeof(void *), so every
+ * block keeps the alignment of the pointers in intpl_reg_ent even where
+ * OS_ALIGNMENT is smaller. Use with OS_MEMPOOL_SIZE to size the pool
+ * buffer.
+ */
+#define INTPL_REG_BLOCK_SIZE(max_pts, nb)                           \
+    ((sizeof(struct intpl_reg_ent) +                                \
+      (max_pts) * sizeof(struct intpl_xyc) +                        \
+      ((nb) + 1) * sizeof(uint32_t) + sizeof(void *) - 1) /         \
+     sizeof(void *) * sizeof(void *))
+
+/**
+ * Initialises a registry.
+ *
+ * @param reg     The registry to initialise.
+ * @param src     The source tables, sorted by id, which must stay valid
+ *                while reg is used.
+ * @param nsrc    The number of source tables.
+ * @param buf     The pool buffer, OS_MEMPOOL_SIZE(nblocks,
+ *                INTPL_REG_BLOCK_SIZE(max_pts, nb)) os_membuf_t long.
+ * @param nblocks The number of tables that can be built at once.
+ * @param max_pts The largest source table, in points.
+ * @param nb      The number of buckets per search index, at least one.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_reg_init(struct intpl_reg *reg, const struct intpl_reg_src src[],
+    unsigned int nsrc, os_membuf_t *buf, uint16_t nblocks,
+    unsigned int max_pts, unsigned int nb);
+
+/**
+ * Finds a built table, building it if needed, and marks it as the most
+ * recently used.
+ *
+ * @param reg The registry.
+ * @param id  The table ID.
+ * @param ent Pointer to the placeholder for the entry.
+ *
+ * @return 0 on success, OS_ENOENT if there is no such table, or another
+ *         error code if it couldn't be built.
+ */
+int intpl_reg_get(struct intpl_reg *reg, uint32_t id,
+    const struct intpl_reg_ent **ent);
+
+/**
+ * Drops every built table, for example after the sources have changed.
+ *
+ * @param reg The registry.
+ */
+void intpl_reg_flush(struct intpl_reg *reg);
+
+/**
+ * Linear interpolation in a registered table.
+ *
+ * @param reg The registry.
+ * @param id  The table ID.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_reg_lin_y(struct intpl_reg *reg, uint32_t id, float x, float *y);
+
+/**
+ * Cubic spline interpolation in a registered table. Tables of fewer than
+ * three points have no spline, and fail with OS_EINVAL.
+ *
+ * @param reg The registry.
+ * @param id  The table ID.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_reg_cubic(struct intpl_reg *reg, uint32_t id, float x, float *y);
+
+/**
+ * Cubic spline interpolation in a registered table, for an array of X
+ * values. The table is looked up once for the whole batch. Tables of fewer
+ * than three points fail as in intpl_reg_cubic.
+ *
+ * @param reg The registry.
+ * @param id  The table ID.
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the Y values.
+ * @param cnt The number of elements in x and y.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that fails.
+ */
+int intpl_reg_cubic_batch(struct intpl_reg *reg, uint32_t id,
+    const float x[], float y[], unsigned int cnt);
+
+/** @} */ /* End of REG group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_REG_H_ */
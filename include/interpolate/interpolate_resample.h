@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_RESAMPLE_H_
+#define _INTERPOLATE_RESAMPLE_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup RESAMPLE Table resampling
+ *
+ * Resamples a source table onto a destination x grid in a single merged
+ * pass over both, costing O(n + m) for n source and m ascending
+ * destination values, rather than m independent searches. Destination
+ * values that go backwards are still handled, with a search for each one.
+ * No memory is allocated.
+ *
+ * The source x values must be strictly ascending. Destination values
+ * outside of the source range are set to NAN, and the first error code is
+ * returned once all values have been processed.
+ *
+ * The _uni variants take a uniform destination grid x0 + k * dx, which
+ * avoids reading an x array and checking the range of every value.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Resampling methods. */
+enum intpl_rs_mode {
+    INTPL_RS_NN = 0,    /**< Nearest neighbour, rounding up on 0.5. */
+    INTPL_RS_LIN = 1,   /**< Linear. */
+    INTPL_RS_MONO = 2,  /**< Monotone (PCHIP) cubic, no overshoot. */
+};
+
+/**
+ * Resamples an intpl_xy table onto the values in x[].
+ *
+ * The monotone cubic uses the local, shape preserving derivative estimate
+ * from Fritsch and Butland, as in PCHIP, which keeps the curve monotone
+ * wherever the data is, and needs no precalculation.
+ *
+ * @param src   The source table, with strictly ascending x values.
+ * @param n     The number of values in src, at least two.
+ * @param mode  The method, see enum intpl_rs_mode.
+ * @param x     The destination x values, ideally in ascending order.
+ * @param y     Pointer to the placeholder for the m resampled y values.
+ * @param m     The number of destination values.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_resample(const struct intpl_xy src[], unsigned int n, uint8_t mode,
+    const float x[], float y[], unsigned int m);
+
+/**
+ * Resamples an intpl_xy table onto the uniform grid x0 + k * dx, for k in
+ * 0..m-1. See intpl_resample.
+ *
+ * @param src   The source table, with strictly ascending x values.
+ * @param n     The number of values in src, at least two.
+ * @param mode  The method, see enum intpl_rs_mode.
+ * @param x0    The first destination x value.
+ * @param dx    The destination step, greater than zero.
+ * @param y     Pointer to the placeholder for the m resampled y values.
+ * @param m     The number of destination values.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_resample_uni(const struct intpl_xy src[], unsigned int n,
+    uint8_t mode, float x0, float dx, float y[], unsigned int m);
+
+/**
+ * Resamples a cubic spline onto the values in x[]. intpl_cubic_calc must
+ * have been called on src first. See intpl_resample.
+ *
+ * @param src   The source spline, with strictly ascending x values.
+ * @param n     The number of values in src, at least three.
+ * @param x     The destination x values, ideally in ascending order.
+ * @param y     Pointer to the placeholder for the m resampled y values.
+ * @param m     The number of destination values.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_resample_cubic(const struct intpl_xyc src[], unsigned int n,
+    const float x[], float y[], unsigned int m);
+
+/**
+ * Resamples a cubic spline onto the uniform grid x0 + k * dx, for k in
+ * 0..m-1. See intpl_resample_cubic.
+ *
+ * @param src   The source spline, with strictly ascending x values.
+ * @param n     The number of values in src, at least three.
+ * @param x0    The first destination x value.
+ * @param dx    The destination step, greater than zero.
+ * @param y     Pointer to the placeholder for the m resampled y values.
+ * @param m     The number of destination values.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_resample_cubic_uni(const struct intpl_xyc src[], unsigned int n,
+    float x0, float dx, float y[], unsigned int m);
+
+/**
+ * Same as intpl_resample_cubic_uni, but steps through each spline segment
+ * by forward differences, costing three additions per value rather than a
+ * full cubic evaluation. This suits rendering curves at a fixed step, such
+ * as plots or motion profiles.
+ *
+ * The differences are restarted from an exact value at every segment
+ * boundary, and at least every 64 values within a segment, which bounds
+ * the accumulated rounding error, typically to a few tens of ULP of the
+ * largest |y| in the segment. Use intpl_resample_cubic_uni where closer
+ * agreement with intpl_cubic_arr matters.
+ *
+ * @param src   The source spline, with strictly ascending x values.
+ * @param n     The number of values in src, at least three.
+ * @param x0    The first destination x value.
+ * @param dx    The destination step, greater than zero.
+ * @param y     Pointer to the placeholder for the m evaluated y values.
+ * @param m     The number of destination values.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_resample_cubic_fd(const struct intpl_xyc src[], unsigned int n,
+    float x0, float dx, float y[], unsigned int m);
+
+/** @} */ /* End of RESAMPLE group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_RESAMPLE_H_ */
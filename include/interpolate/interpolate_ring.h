@@ -0,0 +1,157 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_RING_H_
+#define _INTERPOLATE_RING_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup RING Ring buffer tables
+ *
+ * A table over the last 'cap' timestamped samples, kept in a ring buffer.
+ * Appending and evicting a sample are O(1), and lookups work on the ring
+ * in place, handling the wraparound without copying it into a linear
+ * intpl_xy array.
+ *
+ * Samples are addressed by their age order, where sample 0 is the oldest.
+ * Lookups keep a cursor on the last segment used, and walk forward from
+ * it, so queries that advance with time (the usual case when aligning two
+ * sensor streams) avoid a full search. The cursor is kept valid across
+ * appends and evictions.
+ *
+ * A ring buffer is not thread safe; a single task should push and query
+ * it, or access must be serialised by the caller.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Ring buffer of timestamped samples. */
+struct intpl_ring {
+    struct intpl_xy *buf;       /**< Storage for 'cap' samples. */
+    unsigned int cap;           /**< The capacity of buf, in samples. */
+    unsigned int head;          /**< The position of the oldest sample. */
+    unsigned int cnt;           /**< The number of samples held. */
+    struct intpl_cursor cur;    /**< The last segment, in age order. */
+};
+
+/**
+ * Initialises an empty ring buffer.
+ *
+ * @param ring The ring buffer to initialise.
+ * @param buf  Storage for the samples. Must outlive the ring buffer.
+ * @param cap  The number of samples buf can hold, at least two.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ring_init(struct intpl_ring *ring, struct intpl_xy buf[],
+    unsigned int cap);
+
+/**
+ * Appends a sample, evicting the oldest one if the ring buffer is full.
+ *
+ * @param ring The ring buffer.
+ * @param x    The timestamp, greater than that of the newest sample.
+ * @param y    The sample value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ring_push(struct intpl_ring *ring, float x, float y);
+
+/**
+ * Evicts the oldest sample.
+ *
+ * @param ring The ring buffer.
+ *
+ * @return 0 on success, OS_ENOENT if the ring buffer is empty.
+ */
+int intpl_ring_pop(struct intpl_ring *ring);
+
+/**
+ * Evicts all samples with a timestamp before x, for example to drop
+ * samples older than a time window. Amortised O(1) per sample evicted.
+ *
+ * @param ring The ring buffer.
+ * @param x    The oldest timestamp to keep.
+ *
+ * @return The number of samples evicted.
+ */
+unsigned int intpl_ring_evict(struct intpl_ring *ring, float x);
+
+/**
+ * Returns a sample from the ring buffer, where 0 is the oldest.
+ *
+ * @param ring The ring buffer.
+ * @param i    The sample, in age order.
+ *
+ * @return Pointer to the sample, or NULL if i is out of range.
+ */
+const struct intpl_xy *intpl_ring_at(const struct intpl_ring *ring,
+    unsigned int i);
+
+/**
+ * Nearest neighbour interpolation at x, rounding up on 0.5.
+ *
+ * @param ring The ring buffer, holding at least two samples.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ring_nn(struct intpl_ring *ring, float x, float *y);
+
+/**
+ * Linear interpolation at x.
+ *
+ * @param ring The ring buffer, holding at least two samples.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ring_lin_y(struct intpl_ring *ring, float x, float *y);
+
+/**
+ * Local cubic interpolation at x. The slope at each sample is taken from
+ * the parabola through it and its two neighbours (a one-sided difference
+ * for the oldest and newest samples), and the segment is a cubic Hermite
+ * curve between them. Only four samples are read, so nothing needs to be
+ * recalculated as samples come and go. The curve passes through every
+ * sample, has a continuous slope, and is exact for quadratic data away
+ * from the ends.
+ *
+ * @param ring The ring buffer, holding at least two samples.
+ * @param x    The X value to interpolate for.
+ * @param y    Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_ring_cubic(struct intpl_ring *ring, float x, float *y);
+
+/** @} */ /* End of RING group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_RING_H_ */
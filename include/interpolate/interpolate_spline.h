@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_SPLINE_H_
+#define _INTERPOLATE_SPLINE_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SPLINE Spline derivatives and integrals
+ *
+ * Analytic derivatives and definite integrals of the cubic spline set up
+ * by intpl_cubic_calc, using the existing y2 values. These are exact for
+ * the spline, unlike finite differences of intpl_cubic_arr.
+ *
+ * Integrals use a cumulative array, built once by intpl_cubic_cum, holding
+ * the integral from xyc[0].x to each knot. The integral between any a and
+ * b then costs two searches and a constant amount of work.
+ *
+ * X values outside of xyc[0].x and xyc[n-1].x are rejected.
+ *
+ * Periodic splines, for angles and other cyclic data, are set up by
+ * intpl_cubic_calc_periodic from one period of distinct knots, without
+ * repeating any of them. The last segment runs from xyc[n-1] back to
+ * xyc[0] one period later, and any x is wrapped into the period before it
+ * is looked up. (Clamped end slopes for non-periodic data are set with the
+ * yp1 and ypn arguments of intpl_cubic_calc.)
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/**
+ * Evaluates the first derivative of the cubic spline at x.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param x   The X value to evaluate at.
+ * @param dy  Pointer to the placeholder for dy/dx.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_d1(const struct intpl_xyc xyc[], unsigned int n, float x,
+    float *dy);
+
+/**
+ * Evaluates the second derivative of the cubic spline at x. The second
+ * derivative is linear between knots.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param x   The X value to evaluate at.
+ * @param d2y Pointer to the placeholder for d2y/dx2.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_d2(const struct intpl_xyc xyc[], unsigned int n, float x,
+    float *d2y);
+
+/**
+ * intpl_cubic_d1 for an array of X values, using a search cursor.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param x   The array of X values to evaluate at.
+ * @param dy  The array of placeholders for dy/dx.
+ * @param cnt The number of elements in the x and dy arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; dy[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_cubic_d1_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float x[], float dy[], unsigned int cnt, struct intpl_cursor *cur);
+
+/**
+ * intpl_cubic_d2 for an array of X values, using a search cursor.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param x   The array of X values to evaluate at.
+ * @param d2y The array of placeholders for d2y/dx2.
+ * @param cnt The number of elements in the x and d2y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; d2y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_cubic_d2_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float x[], float d2y[], unsigned int cnt, struct intpl_cursor *cur);
+
+/**
+ * Builds the cumulative integral array for intpl_cubic_integral, where
+ * cum[i] is the integral of the spline from xyc[0].x to xyc[i].x. The sum
+ * is accumulated in double precision. It must be rebuilt whenever
+ * intpl_cubic_calc is called again.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param cum The array of n placeholders for the cumulative integrals.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_cum(const struct intpl_xyc xyc[], unsigned int n,
+    float cum[]);
+
+/**
+ * Calculates the definite integral of the cubic spline from a to b. If
+ * b < a the result is negative.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param cum The cumulative integrals from intpl_cubic_cum.
+ * @param a   The lower limit of integration.
+ * @param b   The upper limit of integration.
+ * @param res Pointer to the placeholder for the integral.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_integral(const struct intpl_xyc xyc[], unsigned int n,
+    const float cum[], float a, float b, float *res);
+
+/**
+ * intpl_cubic_integral for arrays of limits.
+ *
+ * @param xyc The array of X,Y,Y2 values, set up by intpl_cubic_calc.
+ * @param n   The number of elements in the X,Y,Y2 array, at least three.
+ * @param cum The cumulative integrals from intpl_cubic_cum.
+ * @param a   The array of lower limits of integration.
+ * @param b   The array of upper limits of integration.
+ * @param res The array of placeholders for the integrals.
+ * @param cnt The number of elements in the a, b and res arrays.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; res[i] is set to NAN for each pair that failed.
+ */
+int intpl_cubic_integral_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float cum[], const float a[], const float b[], float res[],
+    unsigned int cnt);
+
+/**
+ * Calculates xyc[n].y2 for a periodic cubic spline, so that the spline and
+ * its first two derivatives are continuous where it wraps around. The
+ * cyclic tridiagonal system is solved with the Sherman-Morrison formula,
+ * using 2n floats of scratch memory.
+ *
+ * @param xyc    The array of X,Y,Y2 values, ascending in x, covering less
+ *               than one period.
+ * @param n      The number of elements in the X,Y,Y2 array, at least three.
+ * @param period The period, greater than xyc[n-1].x - xyc[0].x.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_calc_periodic(struct intpl_xyc xyc[], unsigned int n,
+    float period);
+
+/**
+ * Evaluates a periodic cubic spline from intpl_cubic_calc_periodic. x may
+ * be any finite value.
+ *
+ * @param xyc    The array of X,Y,Y2 values.
+ * @param n      The number of elements in the X,Y,Y2 array, at least three.
+ * @param period The period passed to intpl_cubic_calc_periodic.
+ * @param x      The X value to interpolate for.
+ * @param y      Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error. y is set to NAN on error.
+ */
+int intpl_cubic_periodic(const struct intpl_xyc xyc[], unsigned int n,
+    float period, float x, float *y);
+
+/**
+ * intpl_cubic_periodic for an array of X values, using a search cursor.
+ *
+ * @param xyc    The array of X,Y,Y2 values.
+ * @param n      The number of elements in the X,Y,Y2 array, at least three.
+ * @param period The period passed to intpl_cubic_calc_periodic.
+ * @param x      The array of X values to interpolate for.
+ * @param y      The array of placeholders for the interpolated Y values.
+ * @param cnt    The number of elements in the x and y arrays.
+ * @param cur    The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_cubic_periodic_batch(const struct intpl_xyc xyc[], unsigned int n,
+    float period, const float x[], float y[], unsigned int cnt,
+    struct intpl_cursor *cur);
+
+/** @} */ /* End of SPLINE group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_SPLINE_H_ */
@@ -0,0 +1,260 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_SRCH_H_
+#define _INTERPOLATE_SRCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SRCH Search strategies
+ *
+ * A search descriptor selects how the segment containing x is located, and
+ * holds any state the strategy needs. The same descriptor can be passed to
+ * the nearest neighbour, linear and cubic evaluators below. All strategies
+ * return the same segment as intpl_find_x.
+ *
+ * The bucket index suits large tables with strongly non-uniform x, such as
+ * log-spaced frequency tables. It splits the x range into 'nb' equal
+ * buckets, and records the first segment overlapping each one, so a lookup
+ * is one multiply followed by a bisection within a single bucket. It costs
+ * intpl_bkt_size(nb) bytes, and is built once for a given table.
+ *
+ * INTPL_SRCH_AUTO profiles the query stream in windows of
+ * INTPL_SRCH_WINDOW lookups, and picks the strategy for the next window:
+ *
+ * - INTPL_SRCH_CURSOR if at least 3/4 of the lookups landed in the last
+ *   segment or the one after it,
+ * - INTPL_SRCH_GALLOP if at least 3/4 landed within INTPL_SRCH_NEAR
+ *   segments of the last one, or at least 7/8 were in table order,
+ * - INTPL_SRCH_BUCKET if a bucket index was provided,
+ * - INTPL_SRCH_GUESS if at least 3/4 of the interpolation guesses were
+ *   within INTPL_SRCH_NEAR segments,
+ * - INTPL_SRCH_BISECT otherwise.
+ *
+ * The profile costs a few compares per lookup, plus the divide and
+ * multiply of an interpolation guess. The strategy in use and the last
+ * profile are available from intpl_srch_diag.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Search strategies. */
+enum intpl_srch_kind {
+    INTPL_SRCH_BISECT = 0,  /**< Bisection, as in intpl_find_x. */
+    INTPL_SRCH_CURSOR = 1,  /**< Last segment first, see intpl_find_x_cur. */
+    INTPL_SRCH_GUESS = 2,   /**< Interpolation search, intpl_find_x_guess. */
+    INTPL_SRCH_BUCKET = 3,  /**< Bucket index, see intpl_bkt_init_xy. */
+    INTPL_SRCH_GALLOP = 4,  /**< Galloping from the last segment. */
+    INTPL_SRCH_AUTO = 5,    /**< Chosen at runtime from a query profile. */
+};
+
+/** Number of lookups per INTPL_SRCH_AUTO profiling window. */
+#define INTPL_SRCH_WINDOW   (64)
+
+/** Distance in segments that INTPL_SRCH_AUTO considers near. */
+#define INTPL_SRCH_NEAR     (8)
+
+/** Query profile for INTPL_SRCH_AUTO. */
+struct intpl_srch_prof {
+    uint16_t nq;        /**< Lookups in the current window. */
+    uint16_t hit;       /**< ... in the last segment or the one after it. */
+    uint16_t near;      /**< ... within INTPL_SRCH_NEAR of the last segment. */
+    uint16_t sorted;    /**< ... at or after the last segment. */
+    uint16_t guess;     /**< ... within INTPL_SRCH_NEAR of the guess. */
+    uint8_t hit_pct;    /**< hit, in percent of the last complete window. */
+    uint8_t near_pct;   /**< near, in percent of the last complete window. */
+    uint8_t sorted_pct; /**< sorted, in percent of the last complete window. */
+    uint8_t guess_pct;  /**< guess, in percent of the last complete window. */
+    uint32_t queries;   /**< Total lookups. */
+    uint32_t switches;  /**< Total strategy changes. */
+};
+
+/** Diagnostics for a search descriptor, see intpl_srch_diag. */
+struct intpl_srch_diag {
+    uint8_t kind;       /**< The configured strategy. */
+    uint8_t active;     /**< The strategy in use. */
+    uint8_t hit_pct;    /**< Last window: cursor hit rate, in percent. */
+    uint8_t near_pct;   /**< Last window: near lookups, in percent. */
+    uint8_t sorted_pct; /**< Last window: lookups in table order, in percent. */
+    uint8_t guess_pct;  /**< Last window: good guesses, in percent. */
+    uint32_t queries;   /**< Total lookups (INTPL_SRCH_AUTO only). */
+    uint32_t switches;  /**< Total strategy changes (INTPL_SRCH_AUTO only). */
+};
+
+/** Bucket index over the x values of a single table. */
+struct intpl_bkt {
+    float x0;           /**< The first x value of the table. */
+    float scale;        /**< Buckets per unit of x (negative if descending). */
+    unsigned int n;     /**< The number of values in the indexed table. */
+    unsigned int nb;    /**< The number of buckets. */
+    uint32_t *first;    /**< nb + 1 entries, the first segment of each bucket. */
+};
+
+/** Search descriptor, see the SRCH group description. */
+struct intpl_srch {
+    uint8_t kind;                   /**< Strategy, see enum intpl_srch_kind. */
+    struct intpl_cursor cur;        /**< Last segment found. */
+    const struct intpl_bkt *bkt;    /**< Index, or NULL if there is none. */
+    uint8_t active;                 /**< Strategy in use. */
+    struct intpl_srch_prof prof;    /**< Profile (INTPL_SRCH_AUTO only). */
+};
+
+/**
+ * Returns the number of bytes needed for a bucket index with 'nb' buckets.
+ * This is the full memory overhead of the index, besides the intpl_bkt
+ * struct itself.
+ *
+ * @param nb  The number of buckets.
+ *
+ * @return The size in bytes.
+ */
+size_t intpl_bkt_size(unsigned int nb);
+
+/**
+ * Builds a bucket index for an intpl_xy table. 'nb' is typically between
+ * n / 4 and n; more buckets make lookups in dense regions of the table
+ * shorter, at the cost of memory.
+ *
+ * @param bkt  The bucket index to initialise.
+ * @param buf  Storage for the index, at least intpl_bkt_size(nb) bytes and
+ *             aligned for uint32_t. Must outlive the index.
+ * @param len  The size of buf, in bytes.
+ * @param xy   The monotonic table to index.
+ * @param n    The number of values in xy.
+ * @param nb   The number of buckets, at least one.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_bkt_init_xy(struct intpl_bkt *bkt, void *buf, size_t len,
+    const struct intpl_xy xy[], unsigned int n, unsigned int nb);
+
+/**
+ * Builds a bucket index for an intpl_xyc table. See intpl_bkt_init_xy.
+ *
+ * @param bkt  The bucket index to initialise.
+ * @param buf  Storage for the index, at least intpl_bkt_size(nb) bytes and
+ *             aligned for uint32_t. Must outlive the index.
+ * @param len  The size of buf, in bytes.
+ * @param xyc  The monotonic table to index.
+ * @param n    The number of values in xyc.
+ * @param nb   The number of buckets, at least one.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_bkt_init_xyc(struct intpl_bkt *bkt, void *buf, size_t len,
+    const struct intpl_xyc xyc[], unsigned int n, unsigned int nb);
+
+/**
+ * Initialises a search descriptor.
+ *
+ * @param srch  The search descriptor to initialise.
+ * @param kind  The strategy, see enum intpl_srch_kind.
+ * @param bkt   The bucket index, required for INTPL_SRCH_BUCKET and
+ *              optional for INTPL_SRCH_AUTO. Otherwise NULL.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_srch_init(struct intpl_srch *srch, uint8_t kind,
+    const struct intpl_bkt *bkt);
+
+/**
+ * Reads the diagnostics of a search descriptor. The percentages are from
+ * the last complete INTPL_SRCH_AUTO profiling window, and zero before the
+ * first one completes or for other strategies.
+ *
+ * @param srch  The search descriptor.
+ * @param diag  Pointer to the placeholder for the diagnostics.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_srch_diag(const struct intpl_srch *srch,
+    struct intpl_srch_diag *diag);
+
+/**
+ * Searches for the segment containing 'x' using the strategy in 'srch'.
+ * The result is identical to intpl_find_x.
+ *
+ * @param xy    The array of monotonic x and y values to search.
+ * @param n     The number of values in xy.
+ * @param x     The x value to search for.
+ * @param srch  The search descriptor.
+ * @param idx   Pointer to the placeholder for the position of x in xy.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_find_x_srch(struct intpl_xy xy[], unsigned int n, float x,
+    struct intpl_srch *srch, int *idx);
+
+/**
+ * Equivalent to intpl_nn_arr, locating the segment with 'srch'.
+ *
+ * @param xy    The array of monotonic x and y values.
+ * @param n     The number of values in xy.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ * @param srch  The search descriptor.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_nn_srch(struct intpl_xy xy[], unsigned int n, float x, float *y,
+    struct intpl_srch *srch);
+
+/**
+ * Equivalent to intpl_lin_y_arr, locating the segment with 'srch'.
+ *
+ * @param xy    The array of monotonic x and y values.
+ * @param n     The number of values in xy.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ * @param srch  The search descriptor.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_lin_y_srch(struct intpl_xy xy[], unsigned int n, float x, float *y,
+    struct intpl_srch *srch);
+
+/**
+ * Equivalent to intpl_cubic_arr, locating the segment with 'srch'.
+ * intpl_cubic_calc must have been called on xyc first.
+ *
+ * @param xyc   The array of ascending x, y and second derivative values.
+ * @param n     The number of values in xyc, at least three.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ * @param srch  The search descriptor.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_cubic_srch(struct intpl_xyc xyc[], unsigned int n, float x,
+    float *y, struct intpl_srch *srch);
+
+/** @} */ /* End of SRCH group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_SRCH_H_ */
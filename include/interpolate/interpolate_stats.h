@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_STATS_H_
+#define _INTERPOLATE_STATS_H_
+
+#include "os/mynewt.h"
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+#include "stats/stats.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup STATS Statistics
+ *
+ * Optional counters for the interpolation hot paths, enabled with the
+ * INTERPOLATE_STATS syscfg setting. The counters are a regular Mynewt stats
+ * section named "intpl", so they can be read with the usual stats tools on
+ * target. When INTERPOLATE_STATS is 0 the counters compile to nothing.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+
+/** Interpolation counters. */
+STATS_SECT_START(intpl_stats)
+    /* Calls per public function. */
+    STATS_SECT_ENTRY(lerp)
+    STATS_SECT_ENTRY(find_x)
+    STATS_SECT_ENTRY(nn)
+    STATS_SECT_ENTRY(nn_arr)
+    STATS_SECT_ENTRY(lin_y)
+    STATS_SECT_ENTRY(lin_y_arr)
+    STATS_SECT_ENTRY(lin_x)
+    STATS_SECT_ENTRY(cubic_calc)
+    STATS_SECT_ENTRY(cubic_arr)
+    STATS_SECT_ENTRY(batch)
+    /* Bisection searches, and the iterations they took. */
+    STATS_SECT_ENTRY(search)
+    STATS_SECT_ENTRY(search_iter)
+    /* Searches avoided (hit) or not (miss) by a cursor or pklo/pkhi. */
+    STATS_SECT_ENTRY(hint_hit)
+    STATS_SECT_ENTRY(hint_miss)
+    /* OS_EINVAL causes. */
+    STATS_SECT_ENTRY(einval_size)
+    STATS_SECT_ENTRY(einval_range)
+    STATS_SECT_ENTRY(einval_delta)
+    /* Out of memory errors. */
+    STATS_SECT_ENTRY(enomem)
+    /* Table registry lookups, and tables dropped to make room. */
+    STATS_SECT_ENTRY(cache_hit)
+    STATS_SECT_ENTRY(cache_miss)
+    STATS_SECT_ENTRY(cache_evict)
+    /* Total time spent in intpl_cubic_calc, in microseconds. */
+    STATS_SECT_ENTRY(cubic_calc_usecs)
+STATS_SECT_END
+
+/** The interpolation counters. */
+extern STATS_SECT_DECL(intpl_stats) g_intpl_stats;
+
+#endif
+
+/**
+ * Registers the "intpl" stats section. Called by sysinit.
+ */
+void intpl_stats_init(void);
+
+/**
+ * Resets every interpolation counter to zero.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_stats_reset(void);
+
+/**
+ * Prints every interpolation counter with printf, one per line. Intended
+ * for native builds and the simulator, where there is no stats client.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_stats_dump(void);
+
+/** @} */ /* End of STATS group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_STATS_H_ */
@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_SVC_H_
+#define _INTERPOLATE_SVC_H_
+
+#include "interpolate/interpolate.h"
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SVC Batched lookup service
+ *
+ * Collects one-off lookups from many tasks and runs them as batches.
+ * Requests are grouped by table, sorted by X and passed to the batch
+ * functions, so that lookups from different tasks share the search cursor
+ * instead of each paying for a full search.
+ *
+ * On target the service runs from an event on a caller-provided Mynewt
+ * event queue, normally served by a task of its own. With
+ * INTERPOLATE_PTHREAD it runs on a thread of its own instead, and the
+ * event queue is not used.
+ *
+ * Requests are owned by the caller and must stay valid until they
+ * complete. Completion is signalled by the request's callback, if any,
+ * which runs on the service task, after which intpl_svc_done returns
+ * non-zero. With INTERPOLATE_PTHREAD, intpl_svc_wait blocks until a
+ * request completes.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Lookups handled by the service. */
+enum intpl_svc_kind {
+    INTPL_SVC_NN = 0,       /**< intpl_nn_batch over struct intpl_xy. */
+    INTPL_SVC_LIN_Y = 1,    /**< intpl_lin_y_batch over struct intpl_xy. */
+    INTPL_SVC_CUBIC = 2,    /**< intpl_cubic_batch over struct intpl_xyc. */
+};
+
+struct intpl_svc_req;
+
+/**
+ * Completion callback, called on the service task once y and rc are set.
+ * The request is marked done after the callback returns, so the callback
+ * must not submit it again.
+ *
+ * @param req The completed request.
+ */
+typedef void intpl_svc_cb(struct intpl_svc_req *req);
+
+/** A lookup request. Fill in the fields up to arg before submitting. */
+struct intpl_svc_req {
+    void *tbl;              /**< The table, see enum intpl_svc_kind. */
+    unsigned int n;         /**< The number of elements in the table. */
+    uint8_t kind;           /**< The lookup, see enum intpl_svc_kind. */
+    float x;                /**< The X value to interpolate for. */
+    intpl_svc_cb *cb;       /**< Completion callback, or NULL. */
+    void *arg;              /**< For use by the callback. */
+    float y;                /**< Result, NAN on error. */
+    int rc;                 /**< 0 on success, error code on error. */
+    uint8_t done;           /**< Set once the request has completed. */
+    struct intpl_svc_req *next;
+};
+
+/** The service state. */
+struct intpl_svc {
+    struct intpl_svc_req *pending;  /**< Submitted, not yet taken. */
+    uint32_t reqs;          /**< Requests completed. */
+    uint32_t batches;       /**< Batch calls made for them. */
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    int stop;
+#else
+    struct os_eventq *evq;
+    struct os_event ev;
+#endif
+    /* Scratch for the batch being processed. */
+    struct intpl_svc_req *batch[MYNEWT_VAL(INTERPOLATE_SVC_BATCH)];
+    float x[MYNEWT_VAL(INTERPOLATE_SVC_BATCH)];
+    float y[MYNEWT_VAL(INTERPOLATE_SVC_BATCH)];
+};
+
+/**
+ * Initialises the service.
+ *
+ * @param svc The service to initialise.
+ * @param evq The event queue to run the service from. Not used, and may be
+ *            NULL, with INTERPOLATE_PTHREAD.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_svc_init(struct intpl_svc *svc, struct os_eventq *evq);
+
+/**
+ * Stops the service. With INTERPOLATE_PTHREAD, requests already submitted
+ * are completed first. On target, the caller must make sure none are
+ * pending.
+ *
+ * @param svc The service to stop.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_svc_deinit(struct intpl_svc *svc);
+
+/**
+ * Submits a lookup request. May be called from any task.
+ *
+ * @param svc The service.
+ * @param req The request, which must stay valid until it completes.
+ *
+ * @return 0 on success, error code on error. The request is not queued,
+ *         and its callback isn't called, on error.
+ */
+int intpl_svc_submit(struct intpl_svc *svc, struct intpl_svc_req *req);
+
+/**
+ * Checks if a request has completed, so that its result can be read.
+ *
+ * @param req The request.
+ *
+ * @return Non-zero if the request has completed.
+ */
+int intpl_svc_done(const struct intpl_svc_req *req);
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+/**
+ * Waits for a request to complete.
+ *
+ * @param svc The service the request was submitted to.
+ * @param req The request.
+ *
+ * @return The request's rc.
+ */
+int intpl_svc_wait(struct intpl_svc *svc, struct intpl_svc_req *req);
+#endif
+
+/** @} */ /* End of SVC group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_SVC_H_ */
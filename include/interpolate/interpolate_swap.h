@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_SWAP_H_
+#define _INTERPOLATE_SWAP_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SWAP Double-buffered tables
+ *
+ * A table handle with two buffers, allowing a table to be rebuilt (for
+ * example recalibrated, including the intpl_cubic_calc step) while other
+ * tasks keep reading it, without a lock.
+ *
+ * Readers pin the published buffer by incrementing its reader count, and
+ * check that it is still published afterwards, retrying otherwise. They
+ * never block. A single writer fills the other buffer off to the side, and
+ * publishes it with one atomic store. A buffer is only handed back to the
+ * writer once its reader count has dropped to zero, so readers never see
+ * a table that is being rewritten, and the writer is told to retry rather
+ * than waiting for them.
+ *
+ * All shared state is accessed with the compiler's __atomic builtins, in
+ * sequentially consistent order. On cores without atomic instructions
+ * (such as Cortex-M0) these are provided by libatomic, or the toolchain's
+ * equivalent.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Table types held by a double-buffered handle. */
+enum intpl_swap_kind {
+    INTPL_SWAP_XY = 0,  /**< struct intpl_xy tables. */
+    INTPL_SWAP_XYC = 1, /**< struct intpl_xyc tables. */
+};
+
+/** Double-buffered table handle. */
+struct intpl_swap {
+    void *buf[2];           /**< Table storage, cap entries each. */
+    unsigned int n[2];      /**< Number of values in each buffer. */
+    uint32_t readers[2];    /**< Readers holding each buffer. */
+    uint32_t gen[2];        /**< Version of each buffer. */
+    uint32_t front;         /**< The published buffer (0 or 1). */
+    unsigned int cap;       /**< Capacity of each buffer, in entries. */
+    uint8_t kind;           /**< Table type, see enum intpl_swap_kind. */
+};
+
+/** A reader's reference to the published table. */
+struct intpl_swap_ref {
+    const void *tbl;        /**< The table, valid until released. */
+    unsigned int n;         /**< The number of values in tbl. */
+    uint32_t gen;           /**< The version of tbl. */
+    uint8_t slot;           /**< The buffer holding tbl, internal. */
+};
+
+/**
+ * Initialises a double-buffered handle, with an empty published table.
+ *
+ * @param sw    The handle to initialise.
+ * @param kind  The table type, see enum intpl_swap_kind.
+ * @param buf0  Storage for the first buffer.
+ * @param buf1  Storage for the second buffer.
+ * @param cap   The capacity of each buffer, in entries.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_swap_init(struct intpl_swap *sw, uint8_t kind, void *buf0,
+    void *buf1, unsigned int cap);
+
+/**
+ * Starts writing a new version of the table. Only one writer may use a
+ * handle at a time.
+ *
+ * @param sw    The handle.
+ * @param tbl   Pointer to the placeholder for the buffer to fill, an array
+ *              of cap struct intpl_xy or struct intpl_xyc entries.
+ *
+ * @return 0 on success, OS_EBUSY if readers still hold the buffer from
+ *         two versions ago; try again later.
+ */
+int intpl_swap_begin(struct intpl_swap *sw, void **tbl);
+
+/**
+ * Publishes the buffer filled since intpl_swap_begin. New readers see the
+ * new table immediately; readers holding the previous one are unaffected.
+ *
+ * @param sw    The handle.
+ * @param n     The number of values written, at most cap.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_swap_publish(struct intpl_swap *sw, unsigned int n);
+
+/**
+ * Takes a reference to the published table. Never blocks. The reference
+ * must be released with intpl_swap_release, and should not be held for
+ * long, as it keeps the writer from reusing the buffer.
+ *
+ * @param sw    The handle.
+ * @param ref   Pointer to the placeholder for the reference.
+ */
+void intpl_swap_acquire(struct intpl_swap *sw, struct intpl_swap_ref *ref);
+
+/**
+ * Releases a reference taken by intpl_swap_acquire.
+ *
+ * @param sw    The handle.
+ * @param ref   The reference to release.
+ */
+void intpl_swap_release(struct intpl_swap *sw, struct intpl_swap_ref *ref);
+
+/**
+ * Linear interpolation on the published INTPL_SWAP_XY table, see
+ * intpl_lin_y_arr.
+ *
+ * @param sw    The handle.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_swap_lin_y(struct intpl_swap *sw, float x, float *y);
+
+/**
+ * Nearest neighbour interpolation on the published INTPL_SWAP_XY table,
+ * see intpl_nn_arr.
+ *
+ * @param sw    The handle.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_swap_nn(struct intpl_swap *sw, float x, float *y);
+
+/**
+ * Cubic spline interpolation on the published INTPL_SWAP_XYC table. Unlike
+ * intpl_cubic_arr, this keeps no static search state, so it is safe to call
+ * from several tasks, and X values outside of the table are rejected.
+ *
+ * @param sw    The handle.
+ * @param x     The X value to interpolate for.
+ * @param y     Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_swap_cubic(struct intpl_swap *sw, float x, float *y);
+
+/** @} */ /* End of SWAP group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_SWAP_H_ */
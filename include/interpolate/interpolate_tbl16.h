@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _INTERPOLATE_TBL16_H_
+#define _INTERPOLATE_TBL16_H_
+
+#include "interpolate/interpolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TBL16 Reduced precision tables
+ *
+ * Tables that store x and/or y in 16 bits, halving (or, with both
+ * narrowed, quartering compared to two floats) the size of an intpl_xy
+ * table. Values are widened to float as they are read.
+ *
+ * Error bounds for a single stored value v:
+ *
+ * - INTPL_FMT_F16: |error| <= |v| * 2^-11 (about 0.05%) for
+ *   6.1e-5 <= |v| <= 65504, and <= 2^-25 below that. Values above 65504
+ *   can not be stored.
+ * - INTPL_FMT_U16: |error| <= scale / 2, where scale = (max - min) / 65535.
+ *
+ * Linear interpolation between stored values adds no further error in y,
+ * but an error in x shifts the result by up to |slope| * (x error). See
+ * intpl_tbl16_pick to choose a format for a given tolerance.
+ *
+ * \ingroup INTERPOLATE
+ *  @{ */
+
+/** Storage formats for table values. */
+enum intpl_fmt {
+    INTPL_FMT_F32 = 0,  /**< 32-bit float. */
+    INTPL_FMT_F16 = 1,  /**< IEEE 754 half precision float. */
+    INTPL_FMT_U16 = 2,  /**< uint16_t, where value = raw * scale + off. */
+};
+
+/** A table where x and y are stored in separate, possibly 16-bit, arrays. */
+struct intpl_tbl16 {
+    const void *x;      /**< n ascending x values, in fmt_x. */
+    const void *y;      /**< n y values, in fmt_y. */
+    unsigned int n;     /**< The number of values in the table. */
+    uint8_t fmt_x;      /**< Format of x, see enum intpl_fmt. */
+    uint8_t fmt_y;      /**< Format of y, see enum intpl_fmt. */
+    float x_scale;      /**< x scale (INTPL_FMT_U16 only). */
+    float x_off;        /**< x offset (INTPL_FMT_U16 only). */
+    float y_scale;      /**< y scale (INTPL_FMT_U16 only). */
+    float y_off;        /**< y offset (INTPL_FMT_U16 only). */
+};
+
+/**
+ * Converts an IEEE 754 half precision value to float.
+ *
+ * @param h The half precision value.
+ *
+ * @return The value as a float.
+ */
+float intpl_f16_to_f32(uint16_t h);
+
+/**
+ * Converts a float to IEEE 754 half precision, rounding to nearest even.
+ * Values too large for half precision become infinity.
+ *
+ * @param f The float value.
+ *
+ * @return The half precision value.
+ */
+uint16_t intpl_f32_to_f16(float f);
+
+/**
+ * Widens an array of stored values to float. This is the bulk conversion
+ * used to decompress tables, and uses the F16C instructions when they are
+ * available.
+ *
+ * @param fmt   The format of src, see enum intpl_fmt.
+ * @param src   The stored values.
+ * @param scale The scale (INTPL_FMT_U16 only).
+ * @param off   The offset (INTPL_FMT_U16 only).
+ * @param dst   The output array.
+ * @param n     The number of values to convert.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_tbl16_widen(uint8_t fmt, const void *src, float scale, float off,
+    float dst[], unsigned int n);
+
+/**
+ * Encodes an intpl_xy table into reduced precision arrays.
+ *
+ * @param xy    The table to encode (ascending x).
+ * @param n     The number of elements in the XY array.
+ * @param fmt_x The format for x, see enum intpl_fmt.
+ * @param fmt_y The format for y, see enum intpl_fmt.
+ * @param xbuf  Output buffer for n x values (2 or 4 bytes each).
+ * @param ybuf  Output buffer for n y values (2 or 4 bytes each).
+ * @param tbl   Pointer to the table to initialise, pointing at xbuf/ybuf.
+ *
+ * @return 0 on success, OS_EINVAL if a value can not be represented or the
+ *         encoded x values are no longer increasing.
+ */
+int intpl_tbl16_encode(const struct intpl_xy xy[], unsigned int n,
+    uint8_t fmt_x, uint8_t fmt_y, void *xbuf, void *ybuf,
+    struct intpl_tbl16 *tbl);
+
+/**
+ * Chooses the smallest storage formats for which linear interpolation of
+ * the encoded table stays within 'tol' of the original table.
+ *
+ * @param xy    The table to encode (ascending x).
+ * @param n     The number of elements in the XY array.
+ * @param tol   The maximum allowed absolute error in y.
+ * @param fmt_x Pointer to the placeholder for the x format.
+ * @param fmt_y Pointer to the placeholder for the y format.
+ * @param err   Pointer to the placeholder for the error bound of the chosen
+ *              formats, or NULL.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_tbl16_pick(const struct intpl_xy xy[], unsigned int n, float tol,
+    uint8_t *fmt_x, uint8_t *fmt_y, float *err);
+
+/**
+ * Nearest neighbour interpolation on a reduced precision table.
+ *
+ * @param tbl The table to use when interpolating (min two!).
+ * @param x   The X value to interpolate for (x >= x[0], <= x[n-1]).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_tbl16_nn(const struct intpl_tbl16 *tbl, float x, float *y);
+
+/**
+ * Linear interpolation on a reduced precision table.
+ *
+ * @param tbl The table to use when interpolating (min two!).
+ * @param x   The X value to interpolate for (x >= x[0], <= x[n-1]).
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_tbl16_lin_y(const struct intpl_tbl16 *tbl, float x, float *y);
+
+/**
+ * Linear interpolation of an array of X values on a reduced precision
+ * table, using a search cursor.
+ *
+ * @param tbl The table to use when interpolating (min two!).
+ * @param x   The array of X values to interpolate for.
+ * @param y   The array of placeholders for the interpolated Y values.
+ * @param cnt The number of elements in the x and y arrays.
+ * @param cur The search cursor to use, or NULL for a private cursor.
+ *
+ * @return 0 on success, or the first error code encountered. Every value is
+ *         processed; y[i] is set to NAN for each x[i] that failed.
+ */
+int intpl_tbl16_lin_y_batch(const struct intpl_tbl16 *tbl, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur);
+
+/** @} */ /* End of TBL16 group */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INTERPOLATE_TBL16_H_ */
@@ -28,8 +28,11 @@ intpl_lerp(float v0, float v1, float t, float *v)
 {
     int rc;
 
+    INTPL_STATS_INC(lerp);
+
     /* Ensure t = 0.0..1.0 */
     if ((t < 0.0f) || (t > 1.0f)) {
+        INTPL_STATS_INC(einval_range);
         rc = OS_EINVAL;
         *v = NAN;
         goto err;
@@ -43,7 +46,8 @@ err:
 }
 
 int
-intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx)
+intpl_priv_find(const float *x, unsigned int stride, unsigned int n,
+    float xv, int *idx)
 {
     int rc;
     unsigned int idx_upper;  /* Upper limit */
@@ -51,28 +55,33 @@ intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx)
     unsigned int idx_lower;  /* Lower limit */
     int order;              /* Ascending (1) or descending (0) */
 
+    INTPL_STATS_INC(search);
+
     /* Init lower and upper limits. */
     idx_lower = 0;
     idx_upper = n;
 
     /* Make sure we have an appropriately large dataset. */
     if (n < 2) {
+        INTPL_STATS_INC(einval_size);
         *idx = -1;
         rc = OS_EINVAL;
         goto err;
     }
 
     /* Determine order (1 = ascending, 0 = descending). */
-    order = (xy[n-1].x >= xy[0].x);
+    order = (x[(n-1)*stride] >= x[0]);
 
-    /* xy[0] and xy[n-1] bounds checks. */
-    if ((x > xy[n-1].x && order) || (x < xy[n-1].x && !order)) {
+    /* x[0] and x[n-1] bounds checks. */
+    if ((xv > x[(n-1)*stride] && order) || (xv < x[(n-1)*stride] && !order)) {
         /* Out of bounds on the high end. */
+        INTPL_STATS_INC(einval_range);
         *idx = n;
         rc = OS_EINVAL;
         goto err;
-    } else if ((x < xy[0].x && order) || (x > xy[0].x && !order)) {
+    } else if ((xv < x[0] && order) || (xv > x[0] && !order)) {
         /* Out of bounds on the low end. */
+        INTPL_STATS_INC(einval_range);
         *idx = -1;
         rc = OS_EINVAL;
         goto err;
@@ -80,8 +89,10 @@ intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx)
 
     /* Repetitive mid-point computation until a match is made. */
     while (idx_upper - idx_lower > 1) {
+        INTPL_STATS_INC(search_iter);
         idx_mid = (idx_upper + idx_lower) >> 1;
-        if ((x >= xy[idx_mid].x && order) || (x <= xy[idx_mid].x && !order))
+        if ((xv >= x[idx_mid*stride] && order) ||
+            (xv <= x[idx_mid*stride] && !order))
         {
             /* Set lower limit to current mid-point. */
             idx_lower = idx_mid;
@@ -92,10 +103,10 @@ intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx)
     }
 
     /* Set the output index value. */
-    if (x == xy[0].x) {
+    if (xv == x[0]) {
         /* Return absolute lower limit. */
         *idx = 0;
-    } else if(x == xy[n-1].x) {
+    } else if(xv == x[(n-1)*stride]) {
         /* Return absolute upper limit. */
         *idx = n - 2;
     } else {
@@ -108,15 +119,217 @@ err:
     return rc;
 }
 
+int
+intpl_find_x(struct intpl_xy xy[], unsigned int n, float x, int *idx)
+{
+    INTPL_STATS_INC(find_x);
+
+    return intpl_priv_find(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, idx);
+}
+
+/* Maximum number of galloping steps before intpl_priv_find_gallop falls back
+ * to bisection over the rest of the array. */
+#define INTPL_GUESS_GALLOP_MAX  (4)
+
+int
+intpl_priv_find_gallop(const float *x, unsigned int stride, unsigned int n,
+    float xv, unsigned int start, int *idx)
+{
+    int order;              /* Ascending (1) or descending (0) */
+    unsigned int lo;        /* Lower limit, x[lo] <= xv */
+    unsigned int hi;        /* Upper limit, xv < x[hi] */
+    unsigned int mid;
+    unsigned int step;
+    unsigned int gallop;
+    float x0;
+    float xn;
+
+    /* Let the bisection search handle all of the edge cases. */
+    if (n < 3) {
+        return intpl_priv_find(x, stride, n, xv, idx);
+    }
+
+    x0 = x[0];
+    xn = x[(n-1)*stride];
+    order = (xn >= x0);
+    if ((xv >= xn && order) || (xv <= xn && !order) ||
+        (xv <= x0 && order) || (xv >= x0 && !order) || xv != xv) {
+        return intpl_priv_find(x, stride, n, xv, idx);
+    }
+
+    INTPL_STATS_INC(search);
+
+    mid = start;
+    if (mid > n - 2) {
+        mid = n - 2;
+    }
+
+    /* Gallop away from the starting segment until xv is bracketed. */
+    step = 1;
+    gallop = 0;
+    if ((xv >= x[mid*stride] && order) || (xv <= x[mid*stride] && !order)) {
+        lo = mid;
+        hi = mid + 1;
+        while (hi < n - 1 &&
+               ((xv >= x[hi*stride] && order) ||
+                (xv <= x[hi*stride] && !order))) {
+            INTPL_STATS_INC(search_iter);
+            lo = hi;
+            if (++gallop > INTPL_GUESS_GALLOP_MAX) {
+                /* Poor start, bisect the rest of the array. */
+                hi = n - 1;
+                break;
+            }
+            step <<= 1;
+            hi = lo + step < n - 1 ? lo + step : n - 1;
+        }
+    } else {
+        hi = mid;
+        lo = mid > 0 ? mid - 1 : 0;
+        while (lo > 0 &&
+               ((xv < x[lo*stride] && order) ||
+                (xv > x[lo*stride] && !order))) {
+            INTPL_STATS_INC(search_iter);
+            hi = lo;
+            if (++gallop > INTPL_GUESS_GALLOP_MAX) {
+                /* Poor start, bisect the rest of the array. */
+                lo = 0;
+                break;
+            }
+            step <<= 1;
+            lo = hi > step ? hi - step : 0;
+        }
+    }
+
+    /* Bisection within the bracket. */
+    while (hi - lo > 1) {
+        INTPL_STATS_INC(search_iter);
+        mid = (hi + lo) >> 1;
+        if ((xv >= x[mid*stride] && order) || (xv <= x[mid*stride] && !order)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *idx = lo;
+
+    return 0;
+}
+
+unsigned int
+intpl_priv_guess(const float *x, unsigned int stride, unsigned int n, float xv)
+{
+    float x0;
+    float xn;
+    float pos;
+
+    if (n < 3) {
+        return 0;
+    }
+
+    /* Guess the segment from the position of xv between x0 and xn. */
+    x0 = x[0];
+    xn = x[(n-1)*stride];
+    pos = (xv - x0) / (xn - x0) * (float)(n - 1);
+    if (!(pos > 0.0f)) {
+        return 0;
+    }
+    if (pos >= (float)(n - 2)) {
+        return n - 2;
+    }
+
+    return (unsigned int)pos;
+}
+
+int
+intpl_priv_find_guess(const float *x, unsigned int stride, unsigned int n,
+    float xv, int *idx)
+{
+    return intpl_priv_find_gallop(x, stride, n, xv,
+        intpl_priv_guess(x, stride, n, xv), idx);
+}
+
+int
+intpl_find_x_guess(struct intpl_xy xy[], unsigned int n, float x, int *idx)
+{
+    INTPL_STATS_INC(find_x);
+
+    return intpl_priv_find_guess(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, idx);
+}
+
+/* Checks if xv is in segment i, using the same rules as the bisection in
+ * intpl_priv_find (x[i] <= xv < x[i+1] for ascending data). */
+static int
+intpl_priv_in_seg(const float *x, unsigned int stride, unsigned int i,
+    float xv, int order)
+{
+    if (order) {
+        return x[i*stride] <= xv && xv < x[(i+1)*stride];
+    }
+
+    return x[i*stride] >= xv && xv > x[(i+1)*stride];
+}
+
+int
+intpl_priv_find_cur(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_cursor *cur, int *idx)
+{
+    int rc;
+    int i;
+    int order;
+
+    /* Check the last segment and its upper neighbour first. */
+    i = cur->idx;
+    if (n >= 2 && i >= 0 && i < (int)n - 1) {
+        order = (x[(n-1)*stride] >= x[0]);
+        if (intpl_priv_in_seg(x, stride, i, xv, order)) {
+            INTPL_STATS_INC(hint_hit);
+            *idx = i;
+            return 0;
+        }
+        if (i + 1 < (int)n - 1 &&
+            intpl_priv_in_seg(x, stride, i + 1, xv, order)) {
+            INTPL_STATS_INC(hint_hit);
+            *idx = cur->idx = i + 1;
+            return 0;
+        }
+    }
+
+    /* Fall back to a full search. */
+    INTPL_STATS_INC(hint_miss);
+    rc = intpl_priv_find(x, stride, n, xv, idx);
+    if (rc) {
+        goto err;
+    }
+
+    cur->idx = *idx;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_find_x_cur(struct intpl_xy xy[], unsigned int n, float x,
+    struct intpl_cursor *cur, int *idx)
+{
+    return intpl_priv_find_cur(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, cur,
+        idx);
+}
+
 int
 intpl_nn(struct intpl_xy *xy1, struct intpl_xy *xy3, float x2, float *y2)
 {
     int rc;
     float delta;
 
+    INTPL_STATS_INC(nn);
+
     /* Make sure there is a delta x between xy1 and xy3. */
     delta = xy3->x - xy1->x;
     if (delta < 1E-6F && -delta < 1E-6F) {
+        INTPL_STATS_INC(einval_delta);
         rc = OS_EINVAL;
         *y2 = NAN;
         goto err;
@@ -124,6 +337,7 @@ intpl_nn(struct intpl_xy *xy1, struct intpl_xy *xy3, float x2, float *y2)
 
     /* Ensure that x1 <= x2 <= x3. */
     if ((x2 < xy1->x) || (x2 > xy3->x)) {
+        INTPL_STATS_INC(einval_range);
         rc = OS_EINVAL;
         goto err;
     }
@@ -142,6 +356,8 @@ intpl_nn_arr(struct intpl_xy xy[], unsigned int n, float x, float *y)
     int rc;
     int idx;
 
+    INTPL_STATS_INC(nn_arr);
+
     /* Find the starting position in xy[] for x. */
     rc = intpl_find_x(xy, n, x, &idx);
     if (rc) {
@@ -167,9 +383,12 @@ intpl_lin_y(struct intpl_xy *xy1, struct intpl_xy *xy3, float x2, float *y2)
     int rc;
     float delta;
 
+    INTPL_STATS_INC(lin_y);
+
     /* Make sure there is a delta on x between xy1 and xy3. */
     delta = xy3->x - xy1->x;
     if (delta < 1E-6F && -delta < 1E-6F) {
+        INTPL_STATS_INC(einval_delta);
         rc = OS_EINVAL;
         *y2 = NAN;
         goto err;
@@ -177,6 +396,7 @@ intpl_lin_y(struct intpl_xy *xy1, struct intpl_xy *xy3, float x2, float *y2)
 
     /* Ensure that x2 >= x1 && x2 <= x3. */
     if ((x2 < xy1->x) || (x2 > xy3->x)) {
+        INTPL_STATS_INC(einval_range);
         rc = OS_EINVAL;
         *y2 = NAN;
         goto err;
@@ -201,6 +421,8 @@ intpl_lin_y_arr(struct intpl_xy xy[], unsigned int n, float x, float *y)
    int rc;
    int idx;
 
+   INTPL_STATS_INC(lin_y_arr);
+
    /* Find the starting position in xy[] for x. */
    rc = intpl_find_x(xy, n, x, &idx);
    if (rc) {
@@ -226,9 +448,12 @@ intpl_lin_x(struct intpl_xy *xy1, struct intpl_xy *xy3, float y2, float *x2)
     int rc;
     float min, max, delta;
 
+    INTPL_STATS_INC(lin_x);
+
     /* Make sure there is a delta on x between xy1 and xy3. */
     delta = xy3->x - xy1->x;
     if (delta < 1E-6F && -delta < 1E-6F) {
+        INTPL_STATS_INC(einval_delta);
         rc = OS_EINVAL;
         *x2 = NAN;
         goto err;
@@ -238,6 +463,7 @@ intpl_lin_x(struct intpl_xy *xy1, struct intpl_xy *xy3, float y2, float *x2)
     min = xy1->y < xy3->y ? xy1->y : xy3->y;
     max = xy1->y < xy3->y ? xy3->y : xy1->y;
     if ((y2 <  min) || (y2 > max)) {
+        INTPL_STATS_INC(einval_range);
         rc = OS_EINVAL;
         *x2 = NAN;
         goto err;
@@ -256,6 +482,44 @@ err:
     return rc;
 }
 
+/* Inverts segment idx for y, where xy[] has been searched by y. */
+static int
+intpl_priv_lin_x_seg(struct intpl_xy xy[], int idx, float y, float *x)
+{
+    /* A flat segment maps all of its x values to y; use the lowest one. */
+    if (xy[idx].y == xy[idx+1].y) {
+        *x = xy[idx].x;
+        return 0;
+    }
+
+    return intpl_lin_x(&xy[idx], &xy[idx+1], y, x);
+}
+
+int
+intpl_lin_x_arr(struct intpl_xy xy[], unsigned int n, float y, float *x)
+{
+    int rc;
+    int idx;
+
+    /* Find the starting position in xy[] for y, searching by y. */
+    rc = intpl_priv_find(&xy[0].y, INTPL_PRIV_STRIDE(xy), n, y, &idx);
+    if (rc) {
+        *x = NAN;
+        goto err;
+    }
+
+    /* Perform linear interpolation of y between xy[idx] and xy[idx+1]. */
+    rc = intpl_priv_lin_x_seg(xy, idx, y, x);
+    if (rc) {
+        *x = NAN;
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
 int
 intpl_cubic_calc (struct intpl_xyc xyc[], unsigned int n, float yp1, float ypn)
 {
@@ -267,15 +531,24 @@ intpl_cubic_calc (struct intpl_xyc xyc[], unsigned int n, float yp1, float ypn)
     float qn;
     float un;
     float *u;
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+    int64_t start;
+
+    start = os_get_uptime_usec();
+#endif
+
+    INTPL_STATS_INC(cubic_calc);
 
     /* Make sure we have at least three values. */
     if (n < 3) {
+        INTPL_STATS_INC(einval_size);
         rc = OS_EINVAL;
         goto err;
     }
 
     u = (float *)os_malloc((n-1) * sizeof(float));
     if (u == NULL) {
+        INTPL_STATS_INC(enomem);
         rc = OS_ENOMEM;
         goto err;
     }
@@ -316,6 +589,9 @@ intpl_cubic_calc (struct intpl_xyc xyc[], unsigned int n, float yp1, float ypn)
 
     os_free(u);
 
+    INTPL_STATS_INCN(cubic_calc_usecs,
+        (uint32_t)(os_get_uptime_usec() - start));
+
     return 0;
 err:
     return rc;
@@ -330,15 +606,15 @@ intpl_cubic_arr(struct intpl_xyc xyc[], unsigned int n, float x, float *y)
     int khi;            /* Array index value for high point. */
     static int pklo;    /* Persisted low point for repeat bisection search. */
     static int pkhi;    /* Persisted high point for repeat bisection search. */
-    float h;            /* xyc[j+1].x - xyc[j].x */
-    float a;            /* (xyc[j+1].x - x) / h */
-    float b;            /* (x - xyc[j].x) / h */
+
+    INTPL_STATS_INC(cubic_arr);
 
     pklo = 0;
     pkhi = 1;
 
     /* Make sure we have at least three values. */
     if (n < 3) {
+        INTPL_STATS_INC(einval_size);
         rc = OS_EINVAL;
         goto err;
     }
@@ -347,13 +623,17 @@ intpl_cubic_arr(struct intpl_xyc xyc[], unsigned int n, float x, float *y)
      * The static values are maintained across calls to this function, allowing
      * us to avoid unnecessarily performing a full array search. */
     if(xyc[pklo].x <= x && xyc[pkhi].x > x) {
+        INTPL_STATS_INC(hint_hit);
         klo = pklo;
         khi = pkhi;
     } else {
         /* Search the full array for x using bisection. */
+        INTPL_STATS_INC(hint_miss);
+        INTPL_STATS_INC(search);
         klo = 0;
         khi = n - 1;
         while(khi - klo > 1) {
+            INTPL_STATS_INC(search_iter);
             /* Set the midpoint based on the current high/low points.. */
             k = (khi + klo) >> 1;
             /* Determine whether we need to search in upper or lower half. */
@@ -374,23 +654,188 @@ intpl_cubic_arr(struct intpl_xyc xyc[], unsigned int n, float x, float *y)
         pkhi = khi;
     }
 
-    h = xyc[khi].x - xyc[klo].x;
+    /* Interpolate for y between xyc[klo] and xyc[khi]. */
+    rc = intpl_priv_cubic_seg(&xyc[klo], x, y);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_priv_cubic_seg(const struct intpl_xyc *lo, float x, float *y)
+{
+    int rc;
+    const struct intpl_xyc *hi;
+    float h;            /* hi->x - lo->x */
+    float a;            /* (hi->x - x) / h */
+    float b;            /* (x - lo->x) / h */
+
+    hi = lo + 1;
+
+    h = hi->x - lo->x;
     if(h == 0) {
         /* No diff = invalid x input! */
+        INTPL_STATS_INC(einval_delta);
         rc = OS_EINVAL;
         goto err;
     }
 
     /* Calculate coefficients for hi-x (a) and x-lo (b). */
-    a = (xyc[khi].x - x) / h;
-    b = (x - xyc[klo].x) / h;
+    a = (hi->x - x) / h;
+    b = (x - lo->x) / h;
 
     /* Interpolate for y based on a, b using previously calculated y2 vals. */
-    *y = a * xyc[klo].y + b * xyc[khi].y +
-        ((a * a * a - a) * xyc[klo].y2 + (b * b * b - b) *
-        xyc[khi].y2) * (h * h) / 6.0f;
+    *y = a * lo->y + b * hi->y +
+        ((a * a * a - a) * lo->y2 + (b * b * b - b) *
+        hi->y2) * (h * h) / 6.0f;
 
     return 0;
 err:
     return rc;
 }
+
+int
+intpl_nn_batch(struct intpl_xy xy[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_priv_find_cur(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x[i],
+            cur, &idx);
+        if (rc == 0) {
+            rc = intpl_nn(&xy[idx], &xy[idx+1], x[i], &y[i]);
+        }
+        if (rc) {
+            y[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_lin_y_batch(struct intpl_xy xy[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_priv_find_cur(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x[i],
+            cur, &idx);
+        if (rc == 0) {
+            rc = intpl_lin_y(&xy[idx], &xy[idx+1], x[i], &y[i]);
+        }
+        if (rc) {
+            y[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_cubic_batch(struct intpl_xyc xyc[], unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        /* Make sure we have at least three values. */
+        if (n < 3) {
+            INTPL_STATS_INC(einval_size);
+            rc = OS_EINVAL;
+        } else {
+            rc = intpl_priv_find_cur(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n,
+                x[i], cur, &idx);
+        }
+        if (rc == 0) {
+            rc = intpl_priv_cubic_seg(&xyc[idx], x[i], &y[i]);
+        }
+        if (rc) {
+            y[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_lin_x_batch(struct intpl_xy xy[], unsigned int n, const float y[],
+    float x[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_priv_find_cur(&xy[0].y, INTPL_PRIV_STRIDE(xy), n, y[i],
+            cur, &idx);
+        if (rc == 0) {
+            rc = intpl_priv_lin_x_seg(xy, idx, y[i], &x[i]);
+        }
+        if (rc) {
+            x[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_akima.h"
+#include "interpolate_priv.h"
+
+/*
+ * Slope of segment j (from knot j to j + 1), for j = -2..n. The two
+ * segments past each end are extrapolated linearly:
+ *
+ *     m[-1] = 2 m[0] - m[1],           m[-2] = 2 m[-1] - m[0]
+ *     m[n-1] = 2 m[n-2] - m[n-3],      m[n] = 2 m[n-1] - m[n-2]
+ */
+static float
+intpl_akima_m(const struct intpl_xyd xyd[], int n, int j)
+{
+    if (j < 0) {
+        return 2.0f * intpl_akima_m(xyd, n, j + 1) -
+            intpl_akima_m(xyd, n, j + 2);
+    }
+    if (j > n - 2) {
+        return 2.0f * intpl_akima_m(xyd, n, j - 1) -
+            intpl_akima_m(xyd, n, j - 2);
+    }
+
+    return (xyd[j + 1].y - xyd[j].y) / (xyd[j + 1].x - xyd[j].x);
+}
+
+/* Sets the slopes of knots lo..hi. */
+static void
+intpl_akima_slopes(struct intpl_xyd xyd[], int n, int lo, int hi)
+{
+    int i;
+    float m0;
+    float m1;
+    float m2;
+    float m3;
+    float w0;
+    float w1;
+
+    for (i = lo; i <= hi; i++) {
+        m0 = intpl_akima_m(xyd, n, i - 2);
+        m1 = intpl_akima_m(xyd, n, i - 1);
+        m2 = intpl_akima_m(xyd, n, i);
+        m3 = intpl_akima_m(xyd, n, i + 1);
+
+        /* Weight each side by how much the slopes change on the other. */
+        w0 = fabsf(m3 - m2);
+        w1 = fabsf(m1 - m0);
+        if (w0 + w1 > 0.0f) {
+            xyd[i].d = (w0 * m1 + w1 * m2) / (w0 + w1);
+        } else {
+            xyd[i].d = 0.5f * (m1 + m2);
+        }
+    }
+}
+
+/* Checks that knots lo..hi are strictly ascending. */
+static int
+intpl_akima_check(const struct intpl_xyd xyd[], unsigned int n,
+    unsigned int lo, unsigned int hi)
+{
+    unsigned int i;
+
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        return OS_EINVAL;
+    }
+
+    for (i = lo + 1; i <= hi; i++) {
+        if (!(xyd[i].x > xyd[i - 1].x)) {
+            INTPL_STATS_INC(einval_delta);
+            return OS_EINVAL;
+        }
+    }
+
+    return 0;
+}
+
+int
+intpl_akima_calc(struct intpl_xyd xyd[], unsigned int n)
+{
+    int rc;
+
+    rc = intpl_akima_check(xyd, n, 0, n - 1);
+    if (rc) {
+        goto err;
+    }
+
+    intpl_akima_slopes(xyd, n, 0, n - 1);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_akima_update(struct intpl_xyd xyd[], unsigned int n, unsigned int k)
+{
+    int rc;
+    unsigned int lo;
+    unsigned int hi;
+
+    if (k >= n) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /*
+     * Knot k is in segments k - 1 and k, which are used by the slopes of
+     * knots k - 2..k + 2. Near the ends the extrapolated segments depend
+     * on the first and last two, which that range also covers.
+     */
+    lo = (k >= 2) ? k - 2 : 0;
+    hi = (k + 2 < n) ? k + 2 : n - 1;
+
+    rc = intpl_akima_check(xyd, n, (k >= 1) ? k - 1 : 0,
+        (k + 1 < n) ? k + 1 : n - 1);
+    if (rc) {
+        goto err;
+    }
+
+    intpl_akima_slopes(xyd, n, lo, hi);
+
+    return 0;
+err:
+    return rc;
+}
+
+/* Cubic Hermite interpolation on the segment starting at lo. */
+static float
+intpl_akima_seg(const struct intpl_xyd *lo, float x)
+{
+    const struct intpl_xyd *hi;
+    float h;
+    float t;
+    float m0;
+    float m1;
+
+    hi = lo + 1;
+    h = hi->x - lo->x;
+    t = (x - lo->x) / h;
+    m0 = lo->d * h;
+    m1 = hi->d * h;
+
+    /* Cubic Hermite basis functions. */
+    return (2.0f * t * t * t - 3.0f * t * t + 1.0f) * lo->y +
+        (t * t * t - 2.0f * t * t + t) * m0 +
+        (-2.0f * t * t * t + 3.0f * t * t) * hi->y +
+        (t * t * t - t * t) * m1;
+}
+
+/* Akima interpolation at x, searching with cur if it is not NULL. */
+static int
+intpl_akima_eval(const struct intpl_xyd xyd[], unsigned int n, float x,
+    struct intpl_cursor *cur, float *y)
+{
+    int rc;
+    int idx;
+
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (cur != NULL) {
+        rc = intpl_priv_find_cur(&xyd[0].x, INTPL_PRIV_STRIDE(xyd), n, x,
+            cur, &idx);
+    } else {
+        rc = intpl_priv_find(&xyd[0].x, INTPL_PRIV_STRIDE(xyd), n, x, &idx);
+    }
+    if (rc) {
+        goto err;
+    }
+
+    *y = intpl_akima_seg(&xyd[idx], x);
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+int
+intpl_akima(const struct intpl_xyd xyd[], unsigned int n, float x, float *y)
+{
+    return intpl_akima_eval(xyd, n, x, NULL, y);
+}
+
+int
+intpl_akima_batch(const struct intpl_xyd xyd[], unsigned int n,
+    const float x[], float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_akima_eval(xyd, n, x[i], cur, &y[i]);
+        if (rc) {
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
@@ -0,0 +1,460 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "interpolate/interpolate_blob.h"
+#include "interpolate_priv.h"
+
+/* CRC-32 (reflected, polynomial 0xEDB88320), one nibble at a time. */
+static const uint32_t intpl_blob_crc_tbl[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t
+intpl_blob_crc32(uint32_t crc, const void *buf, size_t len)
+{
+    const uint8_t *p;
+
+    p = (const uint8_t *)buf;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ intpl_blob_crc_tbl[crc & 0x0F];
+        crc = (crc >> 4) ^ intpl_blob_crc_tbl[crc & 0x0F];
+    }
+
+    return ~crc;
+}
+
+/*
+ * Fills in the header and copies up to three data sections after it,
+ * followed by the bucket index if bkt is not NULL. The CRC covers
+ * everything after the header.
+ */
+static int
+intpl_blob_write(void *buf, size_t len, uint8_t kind, uint8_t flags,
+    unsigned int ch, unsigned int n, const void *s0, size_t l0,
+    const void *s1, size_t l1, const void *s2, size_t l2,
+    const struct intpl_bkt *bkt, size_t *out_len)
+{
+    int rc;
+    size_t total;
+    size_t li;
+    uint8_t *p;
+    uint32_t nb;
+    struct intpl_blob_hdr *hdr;
+
+    li = bkt ? sizeof(nb) + intpl_bkt_size(bkt->nb) : 0;
+    total = sizeof(*hdr) + l0 + l1 + l2 + li;
+    if (((uintptr_t)buf & 3) != 0) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+    if (len < total) {
+        rc = OS_ENOMEM;
+        goto err;
+    }
+
+    hdr = (struct intpl_blob_hdr *)buf;
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic = INTPL_BLOB_MAGIC;
+    hdr->version = INTPL_BLOB_VERSION;
+    hdr->hdr_len = sizeof(*hdr);
+    hdr->kind = kind;
+    hdr->flags = flags;
+    hdr->ch = ch;
+    hdr->n = n;
+    hdr->data_off = sizeof(*hdr);
+    hdr->data_len = l0 + l1 + l2;
+    hdr->idx_kind = INTPL_BLOB_IDX_NONE;
+
+    p = (uint8_t *)buf + sizeof(*hdr);
+    memcpy(p, s0, l0);
+    p += l0;
+    if (l1) {
+        memcpy(p, s1, l1);
+        p += l1;
+    }
+    if (l2) {
+        memcpy(p, s2, l2);
+        p += l2;
+    }
+    if (bkt) {
+        hdr->idx_kind = INTPL_BLOB_IDX_BKT;
+        hdr->idx_off = p - (uint8_t *)buf;
+        hdr->idx_len = li;
+        nb = bkt->nb;
+        memcpy(p, &nb, sizeof(nb));
+        memcpy(p + sizeof(nb), bkt->first, intpl_bkt_size(bkt->nb));
+    }
+
+    hdr->crc = intpl_blob_crc32(0, (uint8_t *)buf + sizeof(*hdr),
+        total - sizeof(*hdr));
+    *out_len = total;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_blob_write_xy(void *buf, size_t len, const struct intpl_xy xy[],
+    unsigned int n, size_t *out_len)
+{
+    if (n < 2) {
+        return OS_EINVAL;
+    }
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_XY, 0, 1, n,
+        xy, n * sizeof(xy[0]), NULL, 0, NULL, 0, NULL, out_len);
+}
+
+int
+intpl_blob_write_xy_bkt(void *buf, size_t len, const struct intpl_xy xy[],
+    unsigned int n, const struct intpl_bkt *bkt, size_t *out_len)
+{
+    /* The index must have been built for this table. */
+    if (n < 2 || bkt->n != n || bkt->nb < 1 || bkt->x0 != xy[0].x) {
+        return OS_EINVAL;
+    }
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_XY, 0, 1, n,
+        xy, n * sizeof(xy[0]), NULL, 0, NULL, 0, bkt, out_len);
+}
+
+int
+intpl_blob_write_xyc(void *buf, size_t len, const struct intpl_xyc xyc[],
+    unsigned int n, size_t *out_len)
+{
+    if (n < 3) {
+        return OS_EINVAL;
+    }
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_XYC, 0, 1, n,
+        xyc, n * sizeof(xyc[0]), NULL, 0, NULL, 0, NULL, out_len);
+}
+
+int
+intpl_blob_write_xyc_bkt(void *buf, size_t len, const struct intpl_xyc xyc[],
+    unsigned int n, const struct intpl_bkt *bkt, size_t *out_len)
+{
+    /* The index must have been built for this table. */
+    if (n < 3 || bkt->n != n || bkt->nb < 1 || bkt->x0 != xyc[0].x) {
+        return OS_EINVAL;
+    }
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_XYC, 0, 1, n,
+        xyc, n * sizeof(xyc[0]), NULL, 0, NULL, 0, bkt, out_len);
+}
+
+int
+intpl_blob_write_mc(void *buf, size_t len, const struct intpl_mc *mc,
+    size_t *out_len)
+{
+    size_t rows;
+
+    if (mc->n < 2 || mc->ch < 1 || mc->ch > 0xFFFF) {
+        return OS_EINVAL;
+    }
+
+    rows = (size_t)mc->n * mc->ch * sizeof(float);
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_MC,
+        mc->y2 ? INTPL_BLOB_F_Y2 : 0, mc->ch, mc->n,
+        mc->x, mc->n * sizeof(float), mc->y, rows,
+        mc->y2, mc->y2 ? rows : 0, NULL, out_len);
+}
+
+int
+intpl_blob_write_cheb(void *buf, size_t len, const struct intpl_cheb *cheb,
+    size_t *out_len)
+{
+    float range[2];
+
+    if (cheb->nseg < 1 || cheb->nc < 1 || cheb->nc > 0xFFFF ||
+        !(cheb->x1 > cheb->x0)) {
+        return OS_EINVAL;
+    }
+
+    range[0] = cheb->x0;
+    range[1] = cheb->x1;
+
+    return intpl_blob_write(buf, len, INTPL_BLOB_CHEB, 0, cheb->nc,
+        cheb->nseg, range, sizeof range, cheb->c,
+        (size_t)cheb->nseg * cheb->nc * sizeof(float), NULL, 0, NULL,
+        out_len);
+}
+
+/*
+ * Points blob->bkt at a stored bucket index. The x range and scale are
+ * calculated from the table as in intpl_bkt_init, so the stored entries
+ * line up with the buckets they were built for.
+ */
+static int
+intpl_blob_open_bkt(const void *buf, const struct intpl_blob_hdr *hdr,
+    struct intpl_blob *blob)
+{
+    unsigned int stride;
+    const uint32_t *p;
+    const float *x;
+    float x0;
+    float xn;
+
+    p = (const uint32_t *)((const uint8_t *)buf + hdr->idx_off);
+    if (hdr->idx_len < 3 * sizeof(uint32_t) || (hdr->idx_len & 3) != 0 ||
+        p[0] != hdr->idx_len / sizeof(uint32_t) - 2) {
+        return OS_EINVAL;
+    }
+
+    stride = (hdr->kind == INTPL_BLOB_XY) ?
+        sizeof(struct intpl_xy) / sizeof(float) :
+        sizeof(struct intpl_xyc) / sizeof(float);
+    x = (const float *)((const uint8_t *)buf + hdr->data_off);
+    x0 = x[0];
+    xn = x[(hdr->n - 1) * stride];
+    if (!(xn > x0 || xn < x0)) {
+        return OS_EINVAL;
+    }
+
+    blob->bkt.x0 = x0;
+    blob->bkt.scale = (float)p[0] / (xn - x0);
+    blob->bkt.n = hdr->n;
+    blob->bkt.nb = p[0];
+    blob->bkt.first = (uint32_t *)(p + 1);
+    if (!isfinite(blob->bkt.scale) || blob->bkt.scale == 0.0f) {
+        return OS_EINVAL;
+    }
+    blob->idx = p;
+
+    return 0;
+}
+
+int
+intpl_blob_open(const void *buf, size_t len, int verify,
+    struct intpl_blob *blob)
+{
+    int rc;
+    size_t need;
+    size_t row;
+    size_t lead;
+    const struct intpl_blob_hdr *hdr;
+
+    hdr = (const struct intpl_blob_hdr *)buf;
+
+    /* Check the header, which is all that is needed to use the blob. */
+    if (((uintptr_t)buf & 3) != 0 || len < sizeof(*hdr) ||
+        hdr->magic != INTPL_BLOB_MAGIC ||
+        hdr->version != INTPL_BLOB_VERSION ||
+        hdr->hdr_len < sizeof(*hdr) ||
+        (hdr->data_off & 3) != 0 || hdr->data_off < hdr->hdr_len ||
+        hdr->data_off > len || hdr->data_len > len - hdr->data_off) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (hdr->ch < 1) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Make sure the table data matches the table type and size. */
+    lead = 0;
+    switch (hdr->kind) {
+    case INTPL_BLOB_XY:
+        row = sizeof(struct intpl_xy);
+        break;
+    case INTPL_BLOB_XYC:
+        row = sizeof(struct intpl_xyc);
+        break;
+    case INTPL_BLOB_MC:
+        row = sizeof(float) * (1 + (size_t)hdr->ch *
+            ((hdr->flags & INTPL_BLOB_F_Y2) ? 2 : 1));
+        break;
+    case INTPL_BLOB_CHEB:
+        lead = 2 * sizeof(float);
+        row = (size_t)hdr->ch * sizeof(float);
+        break;
+    default:
+        rc = OS_EINVAL;
+        goto err;
+    }
+    /*
+     * A fit can be a single segment; every other kind needs two rows. The
+     * rows are counted by dividing data_len, which is already known to fit
+     * in the blob, so a crafted n or ch cannot wrap the size around.
+     */
+    if (hdr->n < ((hdr->kind == INTPL_BLOB_CHEB) ? 1 : 2) ||
+        hdr->data_len < lead || (hdr->data_len - lead) % row != 0 ||
+        (hdr->data_len - lead) / row != hdr->n) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* The search index is optional, so unknown types are ignored. */
+    blob->idx = NULL;
+    if (hdr->idx_kind != INTPL_BLOB_IDX_NONE) {
+        if ((hdr->idx_off & 3) != 0 || hdr->idx_off > len ||
+            hdr->idx_len > len - hdr->idx_off) {
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+    if (hdr->idx_kind == INTPL_BLOB_IDX_BKT &&
+        (hdr->kind == INTPL_BLOB_XY || hdr->kind == INTPL_BLOB_XYC)) {
+        rc = intpl_blob_open_bkt(buf, hdr, blob);
+        if (rc) {
+            goto err;
+        }
+    }
+
+    if (verify) {
+        need = hdr->data_off + hdr->data_len;
+        if (hdr->idx_kind != INTPL_BLOB_IDX_NONE &&
+            hdr->idx_off + hdr->idx_len > need) {
+            need = hdr->idx_off + hdr->idx_len;
+        }
+        if (intpl_blob_crc32(0, (const uint8_t *)buf + hdr->hdr_len,
+                             need - hdr->hdr_len) != hdr->crc) {
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+
+    blob->hdr = hdr;
+    blob->data = (const uint8_t *)buf + hdr->data_off;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_blob_nn(const struct intpl_blob *blob, float x, float *y)
+{
+    struct intpl_srch srch;
+
+    if (blob->hdr->kind != INTPL_BLOB_XY) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    /* The table is only read, so it is safe to use it straight from flash. */
+    if (blob->idx != NULL) {
+        intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &blob->bkt);
+        return intpl_nn_srch((struct intpl_xy *)blob->data, blob->hdr->n, x,
+            y, &srch);
+    }
+
+    return intpl_nn_arr((struct intpl_xy *)blob->data, blob->hdr->n, x, y);
+}
+
+int
+intpl_blob_lin_y(const struct intpl_blob *blob, float x, float *y)
+{
+    struct intpl_srch srch;
+
+    if (blob->hdr->kind != INTPL_BLOB_XY) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    if (blob->idx != NULL) {
+        intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &blob->bkt);
+        return intpl_lin_y_srch((struct intpl_xy *)blob->data, blob->hdr->n,
+            x, y, &srch);
+    }
+
+    return intpl_lin_y_arr((struct intpl_xy *)blob->data, blob->hdr->n, x,
+        y);
+}
+
+int
+intpl_blob_cubic(const struct intpl_blob *blob, float x, float *y)
+{
+    struct intpl_srch srch;
+
+    if (blob->hdr->kind != INTPL_BLOB_XYC) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    /*
+     * Both searches reject x outside of the table. intpl_cubic_arr would
+     * extrapolate instead, so the lookup would depend on the index.
+     */
+    if (blob->idx != NULL) {
+        intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &blob->bkt);
+    } else {
+        intpl_srch_init(&srch, INTPL_SRCH_BISECT, NULL);
+    }
+
+    return intpl_cubic_srch((struct intpl_xyc *)blob->data, blob->hdr->n, x,
+        y, &srch);
+}
+
+int
+intpl_blob_mc(const struct intpl_blob *blob, struct intpl_mc *mc)
+{
+    const float *p;
+
+    if (blob->hdr->kind != INTPL_BLOB_MC) {
+        return OS_EINVAL;
+    }
+
+    p = (const float *)blob->data;
+    mc->n = blob->hdr->n;
+    mc->ch = blob->hdr->ch;
+    mc->x = p;
+    mc->y = p + mc->n;
+    if (blob->hdr->flags & INTPL_BLOB_F_Y2) {
+        mc->y2 = (float *)(p + mc->n + mc->n * mc->ch);
+    } else {
+        mc->y2 = NULL;
+    }
+
+    return 0;
+}
+
+int
+intpl_blob_cheb(const struct intpl_blob *blob, struct intpl_cheb *cheb)
+{
+    const float *p;
+
+    if (blob->hdr->kind != INTPL_BLOB_CHEB) {
+        return OS_EINVAL;
+    }
+
+    p = (const float *)blob->data;
+    if (!(p[1] > p[0])) {
+        return OS_EINVAL;
+    }
+
+    cheb->x0 = p[0];
+    cheb->x1 = p[1];
+    cheb->nseg = blob->hdr->n;
+    cheb->nc = blob->hdr->ch;
+    cheb->inv_w = (float)cheb->nseg / (cheb->x1 - cheb->x0);
+    cheb->c = p + 2;
+
+    return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_cheb.h"
+#include "interpolate_priv.h"
+
+#define INTPL_CHEB_PI   (3.14159265358979323846)
+
+/* Evaluates the fit at x, which has already been checked to be in range. */
+static inline float
+intpl_cheb_eval(const struct intpl_cheb *cheb, float x)
+{
+    unsigned int s;
+    unsigned int i;
+    float t;
+    float u;
+    float y;
+    const float *c;
+
+    t = (x - cheb->x0) * cheb->inv_w;
+    s = (unsigned int)t;
+    s = (s < cheb->nseg) ? s : cheb->nseg - 1;
+    u = 2.0f * (t - (float)s) - 1.0f;
+
+    c = &cheb->c[s * cheb->nc];
+    y = c[0];
+    for (i = 1; i < cheb->nc; i++) {
+        y = y * u + c[i];
+    }
+
+    return y;
+}
+
+/*
+ * The table value at x, from the cubic through the four nearest points
+ * (linear if the table has fewer than four).
+ */
+static double
+intpl_cheb_src(const struct intpl_xy xy[], unsigned int n, double x)
+{
+    int idx;
+    int i;
+    int j;
+    float xf;
+    double l;
+    double y;
+
+    /* Keep rounding from taking x just outside the table. */
+    xf = (float)x;
+    xf = (xf < xy[0].x) ? xy[0].x : xf;
+    xf = (xf > xy[n - 1].x) ? xy[n - 1].x : xf;
+
+    intpl_priv_find(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, xf, &idx);
+    if (n < 4) {
+        l = ((double)xf - xy[idx].x) / ((double)xy[idx + 1].x - xy[idx].x);
+        return xy[idx].y + l * ((double)xy[idx + 1].y - xy[idx].y);
+    }
+
+    /* Lagrange form over points idx - 1..idx + 2, kept inside the table. */
+    idx = (idx < 1) ? 1 : idx;
+    idx = (idx > (int)n - 3) ? (int)n - 3 : idx;
+    y = 0.0;
+    for (i = idx - 1; i <= idx + 2; i++) {
+        l = xy[i].y;
+        for (j = idx - 1; j <= idx + 2; j++) {
+            if (j != i) {
+                l *= ((double)xf - xy[j].x) / ((double)xy[i].x - xy[j].x);
+            }
+        }
+        y += l;
+    }
+
+    return y;
+}
+
+/*
+ * Fits the table between a and b with the Chebyshev interpolant through nc
+ * Chebyshev nodes, and writes it to c in the power basis of u = -1..1.
+ */
+static void
+intpl_cheb_seg(const struct intpl_xy xy[], unsigned int n, double a,
+    double b, unsigned int nc, float c[])
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    double f[INTPL_CHEB_MAX_DEG + 1];
+    double a_j;
+    double p[INTPL_CHEB_MAX_DEG + 1];
+    double t0[INTPL_CHEB_MAX_DEG + 1];
+    double t1[INTPL_CHEB_MAX_DEG + 1];
+    double t2;
+
+    for (k = 0; k < nc; k++) {
+        f[k] = intpl_cheb_src(xy, n, 0.5 * (a + b) + 0.5 * (b - a) *
+            cos(INTPL_CHEB_PI * (k + 0.5) / nc));
+    }
+
+    /*
+     * Sum a_j T_j(u) in the power basis, building T_j from
+     * T_j = 2 u T_j-1 - T_j-2 as we go. t0 holds T_j-1 and t1 holds T_j.
+     */
+    for (i = 0; i < nc; i++) {
+        p[i] = 0.0;
+        t0[i] = 0.0;
+        t1[i] = 0.0;
+    }
+    t1[0] = 1.0;
+    for (j = 0; j < nc; j++) {
+        if (j == 1) {
+            t0[0] = 1.0;
+            t1[0] = 0.0;
+            t1[1] = 1.0;
+        } else if (j > 1) {
+            for (i = j; i > 0; i--) {
+                t2 = 2.0 * t1[i - 1] - t0[i];
+                t0[i] = t1[i];
+                t1[i] = t2;
+            }
+            t2 = -t0[0];
+            t0[0] = t1[0];
+            t1[0] = t2;
+        }
+
+        a_j = 0.0;
+        for (k = 0; k < nc; k++) {
+            a_j += f[k] * cos(INTPL_CHEB_PI * j * (k + 0.5) / nc);
+        }
+        a_j *= (j == 0) ? 1.0 / nc : 2.0 / nc;
+
+        for (i = 0; i <= j; i++) {
+            p[i] += a_j * t1[i];
+        }
+    }
+
+    for (i = 0; i < nc; i++) {
+        c[i] = (float)p[nc - 1 - i];
+    }
+}
+
+/*
+ * Fits every segment of a candidate and returns the largest error at any
+ * table point.
+ */
+static float
+intpl_cheb_try(struct intpl_cheb *cheb, const struct intpl_xy xy[],
+    unsigned int n, float c[])
+{
+    unsigned int i;
+    unsigned int s;
+    double w;
+    float err;
+    float e;
+
+    w = ((double)cheb->x1 - cheb->x0) / cheb->nseg;
+    for (s = 0; s < cheb->nseg; s++) {
+        intpl_cheb_seg(xy, n, cheb->x0 + s * w, cheb->x0 + (s + 1) * w,
+            cheb->nc, &c[s * cheb->nc]);
+    }
+    cheb->c = c;
+
+    err = 0.0f;
+    for (i = 0; i < n; i++) {
+        e = fabsf(intpl_cheb_eval(cheb, xy[i].x) - xy[i].y);
+        err = (e > err) ? e : err;
+    }
+
+    return err;
+}
+
+int
+intpl_cheb_fit(struct intpl_cheb *cheb, const struct intpl_xy xy[],
+    unsigned int n, float tol, float c[], unsigned int max_c)
+{
+    int rc;
+    unsigned int i;
+    unsigned int nseg;
+    unsigned int nc;
+    unsigned int best_seg;
+    unsigned int best_nc;
+
+    if (n < 2) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+    for (i = 1; i < n; i++) {
+        if (!(xy[i].x > xy[i - 1].x)) {
+            INTPL_STATS_INC(einval_delta);
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+    if (!(tol >= 0.0f)) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    cheb->x0 = xy[0].x;
+    cheb->x1 = xy[n - 1].x;
+
+    /*
+     * Try 1, 2, 4, ... segments, each with the lowest degree that meets
+     * the tolerance, and keep the smallest. Doubling the segments only
+     * pays off while two coefficients each is less than the best so far.
+     */
+    best_seg = 0;
+    best_nc = 0;
+    for (nseg = 1; nseg * 2 <= max_c; nseg *= 2) {
+        if (best_seg && nseg * 2 >= best_seg * best_nc) {
+            break;
+        }
+        cheb->nseg = nseg;
+        cheb->inv_w = (float)nseg / (cheb->x1 - cheb->x0);
+        for (nc = 2; nc <= INTPL_CHEB_MAX_DEG + 1; nc++) {
+            if (nseg * nc > max_c ||
+                (best_seg && nseg * nc >= best_seg * best_nc)) {
+                break;
+            }
+            cheb->nc = nc;
+            if (intpl_cheb_try(cheb, xy, n, c) <= tol) {
+                best_seg = nseg;
+                best_nc = nc;
+                break;
+            }
+        }
+    }
+
+    if (!best_seg) {
+        rc = OS_ENOMEM;
+        goto err;
+    }
+
+    /* Refit the best candidate, which may have been overwritten since. */
+    cheb->nseg = best_seg;
+    cheb->nc = best_nc;
+    cheb->inv_w = (float)best_seg / (cheb->x1 - cheb->x0);
+    intpl_cheb_try(cheb, xy, n, c);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_cheb(const struct intpl_cheb *cheb, float x, float *y)
+{
+    if (!(x >= cheb->x0 && x <= cheb->x1)) {
+        INTPL_STATS_INC(einval_range);
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    *y = intpl_cheb_eval(cheb, x);
+
+    return 0;
+}
+
+int
+intpl_cheb_batch(const struct intpl_cheb *cheb, const float x[], float y[],
+    unsigned int cnt)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_cheb(cheb, x[i], &y[i]);
+        if (rc) {
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
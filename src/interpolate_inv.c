@@ -0,0 +1,465 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_inv.h"
+#include "interpolate_priv.h"
+
+/* Maximum number of iterations when solving a cubic segment for x. */
+#define INTPL_INV_MAX_ITER  (40)
+
+/* Solves segment i of a table for y. Returns 0 and sets x on success. */
+typedef int intpl_inv_seg_fn(const void *tbl, unsigned int i, float y,
+    float *x);
+
+/* Power basis of the spline segment at lo, as
+ * y = c[0] + t * (c[1] + t * (c[2] + t * c[3])) for t = x - lo->x. */
+static void
+intpl_inv_coef(const struct intpl_xyc *lo, float c[4])
+{
+    float h;
+
+    h = lo[1].x - lo->x;
+    c[0] = lo->y;
+    c[1] = (lo[1].y - lo->y) / h - h * (2.0f * lo->y2 + lo[1].y2) / 6.0f;
+    c[2] = 0.5f * lo->y2;
+    c[3] = (lo[1].y2 - lo->y2) / (6.0f * h);
+}
+
+static inline float
+intpl_inv_eval(const float c[4], float t)
+{
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+static inline float
+intpl_inv_deriv(const float c[4], float t)
+{
+    return c[1] + t * (2.0f * c[2] + t * 3.0f * c[3]);
+}
+
+/* Splits the segment [0, h] into monotonic pieces at the stationary points
+ * of the cubic. Returns the number of break points (2 to 4) written to t,
+ * in ascending order from 0 to h, with the cubic's values in f. The end
+ * values are taken from the knots, so that they are exact. */
+static unsigned int
+intpl_inv_pieces(const struct intpl_xyc *lo, const float c[4], float t[4],
+    float f[4])
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int nr;
+    float h;
+    float r[2];
+    float tmp;
+    double qa;
+    double qb;
+    double qc;
+    double disc;
+    double q;
+
+    h = lo[1].x - lo->x;
+
+    /* Roots of c[1] + 2 * c[2] * t + 3 * c[3] * t^2. */
+    nr = 0;
+    qa = 3.0 * c[3];
+    qb = 2.0 * c[2];
+    qc = c[1];
+    if (qa == 0.0) {
+        if (qb != 0.0) {
+            r[nr++] = (float)(-qc / qb);
+        }
+    } else {
+        disc = qb * qb - 4.0 * qa * qc;
+        if (disc > 0.0) {
+            /* Stable form, avoiding cancellation between qb and the root. */
+            q = -0.5 * (qb + (qb < 0.0 ? -sqrt(disc) : sqrt(disc)));
+            r[nr++] = (float)(q / qa);
+            if (q != 0.0) {
+                r[nr++] = (float)(qc / q);
+            }
+        }
+    }
+    if (nr == 2 && r[1] < r[0]) {
+        tmp = r[0];
+        r[0] = r[1];
+        r[1] = tmp;
+    }
+
+    t[0] = 0.0f;
+    f[0] = lo->y;
+    i = 1;
+    for (j = 0; j < nr; j++) {
+        if (r[j] > 0.0f && r[j] < h) {
+            t[i] = r[j];
+            f[i] = intpl_inv_eval(c, r[j]);
+            i++;
+        }
+    }
+    t[i] = h;
+    f[i] = lo[1].y;
+
+    return i + 1;
+}
+
+/* Solves c(t) = y on [tl, tr], where the cubic is monotonic and
+ * fl = c(tl) - y and fr = c(tr) - y have opposite signs. */
+static float
+intpl_inv_solve(const float c[4], float y, float tl, float tr, float fl,
+    float fr)
+{
+    unsigned int it;
+    float t;
+    float tn;
+    float f;
+    float df;
+
+    if (fl == 0.0f) {
+        return tl;
+    }
+    if (fr == 0.0f) {
+        return tr;
+    }
+
+    /* Start from the secant, then Newton's method, keeping the bracket. */
+    t = tl - fl * (tr - tl) / (fr - fl);
+    for (it = 0; it < INTPL_INV_MAX_ITER; it++) {
+        INTPL_STATS_INC(search_iter);
+        f = intpl_inv_eval(c, t) - y;
+        if (f == 0.0f) {
+            break;
+        }
+        if ((f < 0.0f) == (fl < 0.0f)) {
+            tl = t;
+            fl = f;
+        } else {
+            tr = t;
+        }
+
+        df = intpl_inv_deriv(c, t);
+        tn = df != 0.0f ? t - f / df : tl;
+        if (!(tn > tl && tn < tr)) {
+            /* Newton left the bracket, bisect instead. */
+            tn = 0.5f * (tl + tr);
+        }
+        if (tn == t || tn == tl || tn == tr) {
+            break;
+        }
+        t = tn;
+    }
+
+    return t;
+}
+
+static int
+intpl_inv_seg_xyc(const void *tbl, unsigned int i, float y, float *x)
+{
+    const struct intpl_xyc *lo;
+    unsigned int j;
+    unsigned int np;
+    float c[4];
+    float t[4];
+    float f[4];
+
+    lo = (const struct intpl_xyc *)tbl + i;
+    intpl_inv_coef(lo, c);
+    np = intpl_inv_pieces(lo, c, t, f);
+
+    /* Use the first monotonic piece that reaches y. */
+    for (j = 0; j < np - 1; j++) {
+        if ((f[j] <= y && y <= f[j+1]) || (f[j] >= y && y >= f[j+1])) {
+            *x = lo->x + intpl_inv_solve(c, y, t[j], t[j+1], f[j] - y,
+                f[j+1] - y);
+            return 0;
+        }
+    }
+
+    return OS_EINVAL;
+}
+
+static int
+intpl_inv_seg_xy(const void *tbl, unsigned int i, float y, float *x)
+{
+    const struct intpl_xy *xy1;
+    const struct intpl_xy *xy3;
+
+    xy1 = (const struct intpl_xy *)tbl + i;
+    xy3 = xy1 + 1;
+
+    if (!((xy1->y <= y && y <= xy3->y) || (xy1->y >= y && y >= xy3->y))) {
+        return OS_EINVAL;
+    }
+
+    /* A flat segment maps all of its x values to y; use the lowest one. */
+    if (xy1->y == xy3->y) {
+        *x = xy1->x;
+        return 0;
+    }
+
+    /* Same as intpl_lin_x. */
+    *x = ((xy3->y - y) * xy1->x + (y - xy1->y) * xy3->x) / (xy3->y - xy1->y);
+
+    return 0;
+}
+
+size_t
+intpl_yidx_size(unsigned int n)
+{
+    size_t nseg;
+
+    nseg = n < 2 ? 0 : n - 1;
+
+    return (nseg + (nseg + INTPL_YIDX_BLK - 1) / INTPL_YIDX_BLK) * 2 *
+        sizeof(float);
+}
+
+static int
+intpl_yidx_init(struct intpl_yidx *yi, void *buf, size_t len,
+    const float *x, unsigned int stride, unsigned int n, int cubic)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    unsigned int np;
+    unsigned int b;
+    float lo;
+    float hi;
+    float c[4];
+    float t[4];
+    float f[4];
+
+    /* Make sure we have an appropriately large dataset and buffer. */
+    if (n < 2 || (cubic && n < 3)) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+    if (buf == NULL || len < intpl_yidx_size(n) ||
+        ((uintptr_t)buf & (sizeof(float) - 1)) != 0) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    yi->n = n;
+    yi->nblk = (n - 1 + INTPL_YIDX_BLK - 1) / INTPL_YIDX_BLK;
+    yi->seg = (float *)buf;
+    yi->blk = yi->seg + 2 * (n - 1);
+
+    for (i = 0; i < n - 1; i++) {
+        if (!(x[(i+1)*stride] > x[i*stride])) {
+            INTPL_STATS_INC(einval_delta);
+            rc = OS_EINVAL;
+            goto err;
+        }
+
+        /* The range of a segment, including any extremum inside it. */
+        if (cubic) {
+            intpl_inv_coef((const struct intpl_xyc *)&x[i*stride], c);
+            np = intpl_inv_pieces((const struct intpl_xyc *)&x[i*stride], c,
+                t, f);
+        } else {
+            f[0] = x[i*stride+1];
+            f[1] = x[(i+1)*stride+1];
+            np = 2;
+        }
+        lo = hi = f[0];
+        for (j = 1; j < np; j++) {
+            lo = f[j] < lo ? f[j] : lo;
+            hi = f[j] > hi ? f[j] : hi;
+        }
+        yi->seg[2*i] = lo;
+        yi->seg[2*i+1] = hi;
+
+        /* Fold the segment into its block. */
+        b = i / INTPL_YIDX_BLK;
+        if (i % INTPL_YIDX_BLK == 0 || lo < yi->blk[2*b]) {
+            yi->blk[2*b] = lo;
+        }
+        if (i % INTPL_YIDX_BLK == 0 || hi > yi->blk[2*b+1]) {
+            yi->blk[2*b+1] = hi;
+        }
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_yidx_init_xy(struct intpl_yidx *yi, void *buf, size_t len,
+    const struct intpl_xy xy[], unsigned int n)
+{
+    return intpl_yidx_init(yi, buf, len, &xy[0].x, INTPL_PRIV_STRIDE(xy), n,
+        0);
+}
+
+int
+intpl_yidx_init_xyc(struct intpl_yidx *yi, void *buf, size_t len,
+    const struct intpl_xyc xyc[], unsigned int n)
+{
+    return intpl_yidx_init(yi, buf, len, &xyc[0].x, INTPL_PRIV_STRIDE(xyc), n,
+        1);
+}
+
+/* Scans the index for the first segment that reaches y, skipping blocks
+ * whose range does not include it. */
+static int
+intpl_yidx_scan(const struct intpl_yidx *yi, unsigned int n,
+    intpl_inv_seg_fn *fn, const void *tbl, float y, float *x)
+{
+    unsigned int b;
+    unsigned int i;
+    unsigned int end;
+
+    /* The index must have been built for a table of this size. */
+    if (yi->n != n) {
+        INTPL_STATS_INC(einval_size);
+        return OS_EINVAL;
+    }
+
+    INTPL_STATS_INC(search);
+
+    for (b = 0; b < yi->nblk; b++) {
+        if (!(yi->blk[2*b] <= y && y <= yi->blk[2*b+1])) {
+            continue;
+        }
+        end = (b + 1) * INTPL_YIDX_BLK;
+        end = end < n - 1 ? end : n - 1;
+        for (i = b * INTPL_YIDX_BLK; i < end; i++) {
+            INTPL_STATS_INC(search_iter);
+            if (yi->seg[2*i] <= y && y <= yi->seg[2*i+1] &&
+                fn(tbl, i, y, x) == 0) {
+                return 0;
+            }
+        }
+    }
+
+    INTPL_STATS_INC(einval_range);
+
+    return OS_EINVAL;
+}
+
+int
+intpl_lin_x_idx(const struct intpl_xy xy[], unsigned int n,
+    const struct intpl_yidx *yi, float y, float *x)
+{
+    int rc;
+
+    rc = intpl_yidx_scan(yi, n, intpl_inv_seg_xy, xy, y, x);
+    if (rc) {
+        *x = NAN;
+    }
+
+    return rc;
+}
+
+int
+intpl_lin_x_idx_batch(const struct intpl_xy xy[], unsigned int n,
+    const struct intpl_yidx *yi, const float y[], float x[],
+    unsigned int cnt)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_lin_x_idx(xy, n, yi, y[i], &x[i]);
+        rc_first = rc_first ? rc_first : rc;
+    }
+
+    return rc_first;
+}
+
+/* Inverts a spline with monotonic knot values, starting from the segment
+ * found by searching them. */
+static int
+intpl_cubic_x_mono(const struct intpl_xyc xyc[], unsigned int n, float y,
+    struct intpl_cursor *cur, float *x)
+{
+    int idx;
+
+    idx = -1;
+    intpl_priv_find_cur(&xyc[0].y, INTPL_PRIV_STRIDE(xyc), n, y, cur, &idx);
+
+    /* y beyond the end knots can still be reached by an overshoot. */
+    idx = idx < 0 ? 0 : idx;
+    idx = idx > (int)n - 2 ? (int)n - 2 : idx;
+
+    if (intpl_inv_seg_xyc(xyc, idx, y, x) == 0) {
+        return 0;
+    }
+    if (idx > 0 && intpl_inv_seg_xyc(xyc, idx - 1, y, x) == 0) {
+        return 0;
+    }
+    if (idx < (int)n - 2 && intpl_inv_seg_xyc(xyc, idx + 1, y, x) == 0) {
+        return 0;
+    }
+
+    INTPL_STATS_INC(einval_range);
+
+    return OS_EINVAL;
+}
+
+int
+intpl_cubic_x(const struct intpl_xyc xyc[], unsigned int n,
+    const struct intpl_yidx *yi, float y, float *x)
+{
+    return intpl_cubic_x_batch(xyc, n, yi, &y, x, 1, NULL);
+}
+
+int
+intpl_cubic_x_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const struct intpl_yidx *yi, const float y[], float x[],
+    unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        /* Make sure we have at least three values. */
+        if (n < 3) {
+            INTPL_STATS_INC(einval_size);
+            rc = OS_EINVAL;
+        } else if (yi != NULL) {
+            rc = intpl_yidx_scan(yi, n, intpl_inv_seg_xyc, xyc, y[i], &x[i]);
+        } else {
+            rc = intpl_cubic_x_mono(xyc, n, y[i], cur, &x[i]);
+        }
+        if (rc) {
+            x[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
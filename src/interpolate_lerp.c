@@ -0,0 +1,379 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_lerp.h"
+#include "interpolate_priv.h"
+#if defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+/* Fields of an RGB565 pixel spread over 32 bits, with room to scale. */
+#define INTPL_LERP_565_MASK     (0x07E0F81FUL)
+
+static inline float
+intpl_lerp_clamp(float t)
+{
+    /* Written so that a NAN factor gives a NAN result. */
+    return (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+}
+
+/**
+ * Computes v[i] = (1 - t[i]) * v0[i] + t[i] * v1[i] for all elements, with
+ * the same rounding as intpl_lerp. If t is NULL, tc is used for all.
+ */
+static void
+intpl_lerp_run(const float *v0, const float *v1, const float *t, float tc,
+    float *v, unsigned int cnt)
+{
+    unsigned int i;
+
+    i = 0;
+#if defined(__SSE__)
+    {
+        __m128 one;
+        __m128 tt;
+        __m128 omt;
+
+        one = _mm_set1_ps(1.0f);
+        tt = _mm_set1_ps(tc);
+        omt = _mm_sub_ps(one, tt);
+        for (; i + 4 <= cnt; i += 4) {
+            if (t != NULL) {
+                tt = _mm_loadu_ps(&t[i]);
+                omt = _mm_sub_ps(one, tt);
+            }
+            _mm_storeu_ps(&v[i], _mm_add_ps(
+                _mm_mul_ps(omt, _mm_loadu_ps(&v0[i])),
+                _mm_mul_ps(tt, _mm_loadu_ps(&v1[i]))));
+        }
+    }
+#endif
+    /* Simple enough for the compiler to vectorise. */
+    if (t == NULL) {
+        for (; i < cnt; i++) {
+            v[i] = (1.0f - tc) * v0[i] + tc * v1[i];
+        }
+    } else {
+        for (; i < cnt; i++) {
+            v[i] = (1.0f - t[i]) * v0[i] + t[i] * v1[i];
+        }
+    }
+}
+
+int
+intpl_lerp_arr(const float v0[], const float v1[], float t, float v[],
+    unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    /* Ensure t = 0.0..1.0 */
+    if ((t < 0.0f) || (t > 1.0f)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        for (i = 0; i < cnt; i++) {
+            v[i] = NAN;
+        }
+        goto err;
+    }
+
+    /* v may alias v0 or v1, but only element for element. */
+    intpl_lerp_run(v0, v1, NULL, t, v, cnt);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_lerp_arr_t(const float v0[], const float v1[], const float t[],
+    float v[], unsigned int cnt)
+{
+    int bad;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    /*
+     * Check all factors first, without branching per element, so that the
+     * common case of no errors runs through the vector kernel.
+     */
+    bad = 0;
+    for (i = 0; i < cnt; i++) {
+        bad |= (t[i] < 0.0f) | (t[i] > 1.0f);
+    }
+
+    intpl_lerp_run(v0, v1, t, 0.0f, v, cnt);
+    if (!bad) {
+        return 0;
+    }
+
+    for (i = 0; i < cnt; i++) {
+        if ((t[i] < 0.0f) || (t[i] > 1.0f)) {
+            INTPL_STATS_INC(einval_range);
+            v[i] = NAN;
+        }
+    }
+
+    return OS_EINVAL;
+}
+
+void
+intpl_lerp_arr_clamp(const float v0[], const float v1[], const float t[],
+    float v[], unsigned int cnt)
+{
+    unsigned int i;
+    float tc;
+
+    INTPL_STATS_INC(batch);
+
+    i = 0;
+#if defined(__SSE__)
+    {
+        __m128 zero;
+        __m128 one;
+        __m128 tt;
+
+        zero = _mm_setzero_ps();
+        one = _mm_set1_ps(1.0f);
+        for (; i + 4 <= cnt; i += 4) {
+            /* min/max return the second operand for NAN, keep it there. */
+            tt = _mm_min_ps(one, _mm_max_ps(zero, _mm_loadu_ps(&t[i])));
+            _mm_storeu_ps(&v[i], _mm_add_ps(
+                _mm_mul_ps(_mm_sub_ps(one, tt), _mm_loadu_ps(&v0[i])),
+                _mm_mul_ps(tt, _mm_loadu_ps(&v1[i]))));
+        }
+    }
+#endif
+    for (; i < cnt; i++) {
+        tc = intpl_lerp_clamp(t[i]);
+        v[i] = (1.0f - tc) * v0[i] + tc * v1[i];
+    }
+}
+
+static inline float
+intpl_ease_linear(float t)
+{
+    return t;
+}
+
+static inline float
+intpl_ease_in_quad(float t)
+{
+    return t * t;
+}
+
+static inline float
+intpl_ease_out_quad(float t)
+{
+    return 1.0f - (1.0f - t) * (1.0f - t);
+}
+
+static inline float
+intpl_ease_in_out_quad(float t)
+{
+    float u;
+
+    u = 2.0f - 2.0f * t;
+    return (t < 0.5f) ? 2.0f * t * t : 1.0f - 0.5f * u * u;
+}
+
+static inline float
+intpl_ease_in_cubic(float t)
+{
+    return t * t * t;
+}
+
+static inline float
+intpl_ease_out_cubic(float t)
+{
+    float u;
+
+    u = 1.0f - t;
+    return 1.0f - u * u * u;
+}
+
+static inline float
+intpl_ease_in_out_cubic(float t)
+{
+    float u;
+
+    u = 2.0f - 2.0f * t;
+    return (t < 0.5f) ? 4.0f * t * t * t : 1.0f - 0.5f * u * u * u;
+}
+
+static inline float
+intpl_ease_smoothstep(float t)
+{
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static inline float
+intpl_ease_smootherstep(float t)
+{
+    return t * t * t * (t * (6.0f * t - 15.0f) + 10.0f);
+}
+
+float
+intpl_ease(uint8_t kind, float t)
+{
+    t = intpl_lerp_clamp(t);
+
+    switch (kind) {
+    case INTPL_EASE_LINEAR:
+        return t;
+    case INTPL_EASE_IN_QUAD:
+        return intpl_ease_in_quad(t);
+    case INTPL_EASE_OUT_QUAD:
+        return intpl_ease_out_quad(t);
+    case INTPL_EASE_IN_OUT_QUAD:
+        return intpl_ease_in_out_quad(t);
+    case INTPL_EASE_IN_CUBIC:
+        return intpl_ease_in_cubic(t);
+    case INTPL_EASE_OUT_CUBIC:
+        return intpl_ease_out_cubic(t);
+    case INTPL_EASE_IN_OUT_CUBIC:
+        return intpl_ease_in_out_cubic(t);
+    case INTPL_EASE_SMOOTHSTEP:
+        return intpl_ease_smoothstep(t);
+    case INTPL_EASE_SMOOTHERSTEP:
+        return intpl_ease_smootherstep(t);
+    default:
+        return NAN;
+    }
+}
+
+/* One loop per curve, so that the switch stays out of the inner loop. */
+#define INTPL_EASE_LOOP(fn)                                     \
+    for (i = 0; i < cnt; i++) {                                 \
+        out[i] = fn(intpl_lerp_clamp(t[i]));                    \
+    }
+
+int
+intpl_ease_arr(uint8_t kind, const float t[], float out[], unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    switch (kind) {
+    case INTPL_EASE_LINEAR:
+        INTPL_EASE_LOOP(intpl_ease_linear);
+        break;
+    case INTPL_EASE_IN_QUAD:
+        INTPL_EASE_LOOP(intpl_ease_in_quad);
+        break;
+    case INTPL_EASE_OUT_QUAD:
+        INTPL_EASE_LOOP(intpl_ease_out_quad);
+        break;
+    case INTPL_EASE_IN_OUT_QUAD:
+        INTPL_EASE_LOOP(intpl_ease_in_out_quad);
+        break;
+    case INTPL_EASE_IN_CUBIC:
+        INTPL_EASE_LOOP(intpl_ease_in_cubic);
+        break;
+    case INTPL_EASE_OUT_CUBIC:
+        INTPL_EASE_LOOP(intpl_ease_out_cubic);
+        break;
+    case INTPL_EASE_IN_OUT_CUBIC:
+        INTPL_EASE_LOOP(intpl_ease_in_out_cubic);
+        break;
+    case INTPL_EASE_SMOOTHSTEP:
+        INTPL_EASE_LOOP(intpl_ease_smoothstep);
+        break;
+    case INTPL_EASE_SMOOTHERSTEP:
+        INTPL_EASE_LOOP(intpl_ease_smootherstep);
+        break;
+    default:
+        rc = OS_EINVAL;
+        for (i = 0; i < cnt; i++) {
+            out[i] = NAN;
+        }
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_lerp_rgb565(const uint16_t a[], const uint16_t b[], uint16_t t8,
+    uint16_t out[], unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+    uint32_t t5;
+    uint32_t pa;
+    uint32_t pb;
+    uint32_t p;
+
+    INTPL_STATS_INC(batch);
+
+    if (t8 > 256) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /*
+     * Spread green into the upper half word, leaving 5 spare bits above
+     * each channel, so that one multiply scales all three channels.
+     */
+    t5 = t8 >> 3;
+    for (i = 0; i < cnt; i++) {
+        pa = (a[i] | ((uint32_t)a[i] << 16)) & INTPL_LERP_565_MASK;
+        pb = (b[i] | ((uint32_t)b[i] << 16)) & INTPL_LERP_565_MASK;
+        p = ((pa * (32 - t5) + pb * t5) >> 5) & INTPL_LERP_565_MASK;
+        out[i] = (uint16_t)(p | (p >> 16));
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_lerp_rgb888(const uint8_t a[], const uint8_t b[], uint16_t t8,
+    uint8_t out[], unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    if (t8 > 256) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Simple enough for the compiler to vectorise. */
+    for (i = 0; i < cnt; i++) {
+        out[i] = (uint8_t)((a[i] * (256 - t8) + b[i] * t8) >> 8);
+    }
+
+    return 0;
+err:
+    return rc;
+}
@@ -0,0 +1,235 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_mc.h"
+#include "interpolate_priv.h"
+
+/* Sets every channel in y to NAN, used on all error paths. */
+static void
+intpl_mc_set_nan(const struct intpl_mc *mc, float y[])
+{
+    unsigned int c;
+
+    for (c = 0; c < mc->ch; c++) {
+        y[c] = NAN;
+    }
+}
+
+int
+intpl_mc_find_x(const struct intpl_mc *mc, float x, int *idx)
+{
+    return intpl_priv_find(mc->x, 1, mc->n, x, idx);
+}
+
+int
+intpl_mc_nn(const struct intpl_mc *mc, float x, float y[])
+{
+    int rc;
+    int idx;
+    unsigned int c;
+    const float *row;
+
+    /* Find the starting position in the table for x. */
+    rc = intpl_mc_find_x(mc, x, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    /* Determine which row is closest, rounding up on 0.5. */
+    if (fabsf(x - mc->x[idx+1]) <= fabsf(x - mc->x[idx])) {
+        idx++;
+    }
+
+    row = &mc->y[idx * mc->ch];
+    for (c = 0; c < mc->ch; c++) {
+        y[c] = row[c];
+    }
+
+    return 0;
+err:
+    intpl_mc_set_nan(mc, y);
+    return rc;
+}
+
+int
+intpl_mc_lin_y(const struct intpl_mc *mc, float x, float y[])
+{
+    int rc;
+    int idx;
+    unsigned int c;
+    float delta;
+    float t;
+    const float * restrict y1;
+    const float * restrict y3;
+
+    /* Find the starting position in the table for x. */
+    rc = intpl_mc_find_x(mc, x, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    /* Make sure there is a delta on x between the two rows. */
+    delta = mc->x[idx+1] - mc->x[idx];
+    if (delta < 1E-6F && -delta < 1E-6F) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* The interpolation factor is shared by all channels, so only the
+     * multiply-add remains in the (vectorisable) channel loop. */
+    t = (x - mc->x[idx]) / delta;
+    y1 = &mc->y[idx * mc->ch];
+    y3 = y1 + mc->ch;
+    for (c = 0; c < mc->ch; c++) {
+        y[c] = y1[c] + t * (y3[c] - y1[c]);
+    }
+
+    return 0;
+err:
+    intpl_mc_set_nan(mc, y);
+    return rc;
+}
+
+int
+intpl_mc_cubic_calc(struct intpl_mc *mc)
+{
+    int rc;
+    unsigned int i;
+    int k;
+    unsigned int c;
+    unsigned int ch;
+    float sigma;
+    float p;
+    float h_lo;
+    float h_hi;
+    float *f;
+    const float *x;
+    const float *y;
+    float *y2;
+
+    /* Make sure we have at least three values. */
+    if (mc->n < 3) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Decomposition factors, shared by all channels. */
+    f = (float *)os_malloc(mc->n * sizeof(float));
+    if (f == NULL) {
+        INTPL_STATS_INC(enomem);
+        rc = OS_ENOMEM;
+        goto err;
+    }
+
+    x = mc->x;
+    y = mc->y;
+    y2 = mc->y2;
+    ch = mc->ch;
+
+    /* Natural spline: y2 = 0 at both ends. y2 holds u[] until the final
+     * back-substitution. */
+    f[0] = 0.0f;
+    for (c = 0; c < ch; c++) {
+        y2[c] = 0.0f;
+    }
+
+    for (i = 1; i < mc->n-1; i++) {
+        h_lo = x[i] - x[i-1];
+        h_hi = x[i+1] - x[i];
+        sigma = h_lo / (x[i+1] - x[i-1]);
+        p = sigma * f[i-1] + 2.0f;
+        f[i] = (sigma - 1.0f) / p;
+        for (c = 0; c < ch; c++) {
+            float u;
+            u = (y[(i+1)*ch+c] - y[i*ch+c]) / h_hi -
+                (y[i*ch+c] - y[(i-1)*ch+c]) / h_lo;
+            y2[i*ch+c] = (6.0f * u / (x[i+1] - x[i-1]) -
+                sigma * y2[(i-1)*ch+c]) / p;
+        }
+    }
+
+    for (c = 0; c < ch; c++) {
+        y2[(mc->n-1)*ch+c] = 0.0f;
+    }
+
+    for (k = mc->n-2; k >= 0; k--) {
+        for (c = 0; c < ch; c++) {
+            y2[k*ch+c] = f[k] * y2[(k+1)*ch+c] + y2[k*ch+c];
+        }
+    }
+
+    os_free(f);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_mc_cubic(const struct intpl_mc *mc, float x, float y[])
+{
+    int rc;
+    int idx;
+    unsigned int c;
+    float h;            /* x[idx+1] - x[idx] */
+    float a;            /* (x[idx+1] - x) / h */
+    float b;            /* (x - x[idx]) / h */
+    float ca;           /* Weight for y2 at the low point. */
+    float cb;           /* Weight for y2 at the high point. */
+    const float * restrict ylo;
+    const float * restrict y2lo;
+
+    /* Make sure we have at least three values. */
+    if (mc->n < 3) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Find the starting position in the table for x. */
+    rc = intpl_mc_find_x(mc, x, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    h = mc->x[idx+1] - mc->x[idx];
+    if (h == 0) {
+        /* No diff = invalid x input! */
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Calculate the weights once, then apply them to every channel. */
+    a = (mc->x[idx+1] - x) / h;
+    b = (x - mc->x[idx]) / h;
+    ca = (a * a * a - a) * (h * h) / 6.0f;
+    cb = (b * b * b - b) * (h * h) / 6.0f;
+
+    ylo = &mc->y[idx * mc->ch];
+    y2lo = &mc->y2[idx * mc->ch];
+    for (c = 0; c < mc->ch; c++) {
+        y[c] = a * ylo[c] + b * ylo[c+mc->ch] +
+            ca * y2lo[c] + cb * y2lo[c+mc->ch];
+    }
+
+    return 0;
+err:
+    intpl_mc_set_nan(mc, y);
+    return rc;
+}
@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_nnt.h"
+#include "interpolate_priv.h"
+
+/**
+ * Returns the number of midpoints at or below xs, by bisection over
+ * mid[lo..hi).
+ */
+static unsigned int
+intpl_nnt_search(const float *mid, unsigned int lo, unsigned int hi,
+    float xs)
+{
+    unsigned int m;
+
+    INTPL_STATS_INC(search);
+    while (lo < hi) {
+        INTPL_STATS_INC(search_iter);
+        m = (lo + hi) >> 1;
+        if (mid[m] <= xs) {
+            lo = m + 1;
+        } else {
+            hi = m;
+        }
+    }
+
+    return lo;
+}
+
+int
+intpl_nnt_init(struct intpl_nnt *nnt, const struct intpl_xy xy[],
+    unsigned int n, float mid[])
+{
+    int rc;
+    unsigned int i;
+
+    if (n < 2) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    nnt->xy = xy;
+    nnt->mid = mid;
+    nnt->n = n;
+    nnt->sign = (xy[n - 1].x >= xy[0].x) ? 1.0f : -1.0f;
+    nnt->lo = nnt->sign * xy[0].x;
+    nnt->hi = nnt->sign * xy[n - 1].x;
+
+    /* Written so that it can't overflow for large x. */
+    for (i = 0; i < n - 1; i++) {
+        mid[i] = nnt->sign * (xy[i].x + 0.5f * (xy[i + 1].x - xy[i].x));
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_nnt_idx(const struct intpl_nnt *nnt, float x, unsigned int *idx)
+{
+    int rc;
+    float xs;
+
+    INTPL_STATS_INC(nn);
+
+    xs = nnt->sign * x;
+    if ((xs < nnt->lo) || (xs > nnt->hi)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    *idx = intpl_nnt_search(nnt->mid, 0, nnt->n - 1, xs);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_nnt(const struct intpl_nnt *nnt, float x, float *y)
+{
+    int rc;
+    unsigned int idx;
+
+    rc = intpl_nnt_idx(nnt, x, &idx);
+    if (rc) {
+        *y = NAN;
+        goto err;
+    }
+
+    *y = nnt->xy[idx].y;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_nnt_batch(const struct intpl_nnt *nnt, const float x[], float y[],
+    unsigned int cnt)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_nnt(nnt, x[i], &y[i]);
+        if (rc) {
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_nnt_sorted(const struct intpl_nnt *nnt, const float x[], float y[],
+    unsigned int cnt)
+{
+    int rc_first;
+    unsigned int i;
+    unsigned int idx;
+    float xs;
+    float prev;
+
+    INTPL_STATS_INC(batch);
+
+    rc_first = 0;
+    idx = 0;
+    prev = nnt->lo;
+    for (i = 0; i < cnt; i++) {
+        xs = nnt->sign * x[i];
+        if ((xs < nnt->lo) || (xs > nnt->hi)) {
+            INTPL_STATS_INC(einval_range);
+            y[i] = NAN;
+            rc_first = rc_first ? rc_first : OS_EINVAL;
+            continue;
+        }
+
+        if (xs < prev) {
+            /* Out of order, start again from a search. */
+            INTPL_STATS_INC(hint_miss);
+            idx = intpl_nnt_search(nnt->mid, 0, idx, xs);
+        } else {
+            while (idx < nnt->n - 1 && nnt->mid[idx] <= xs) {
+                idx++;
+            }
+        }
+        prev = xs;
+        y[i] = nnt->xy[idx].y;
+    }
+
+    return rc_first;
+}
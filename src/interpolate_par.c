@@ -0,0 +1,702 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_par.h"
+#include "interpolate_priv.h"
+
+/** Table types handled by the parallel batch functions. */
+enum intpl_par_kind {
+    INTPL_PAR_NN,
+    INTPL_PAR_LIN_Y,
+    INTPL_PAR_CUBIC,
+};
+
+/** A batch job, shared (read-only) by every worker. */
+struct intpl_par_job {
+    enum intpl_par_kind kind;
+    struct intpl_xy *xy;
+    struct intpl_xyc *xyc;
+    unsigned int n;
+    const float *x;
+    float *y;
+    unsigned int cnt;
+    int sorted;
+    int rc[MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS)];
+};
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+
+static void *
+intpl_pool_worker_main(void *arg)
+{
+    struct intpl_pool_worker *w;
+    struct intpl_pool *pool;
+    unsigned int seen;
+    intpl_pool_fn *fn;
+    void *fn_arg;
+
+    w = (struct intpl_pool_worker *)arg;
+    pool = w->pool;
+
+    /* The pool starts at generation 0; a run may already be pending. */
+    seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        /* Wait for a new run, or for the pool to stop. */
+        while (pool->gen == seen && !pool->stop) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->stop) {
+            break;
+        }
+        seen = pool->gen;
+        fn = pool->fn;
+        fn_arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        fn(fn_arg, w->part, pool->nthreads);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+#endif
+
+int
+intpl_pool_init(struct intpl_pool *pool, unsigned int nthreads)
+{
+    int rc;
+
+    if (nthreads < 1) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+    if (nthreads > MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS)) {
+        nthreads = MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS);
+    }
+    pool->nthreads = nthreads;
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    {
+        unsigned int i;
+
+        pthread_mutex_init(&pool->lock, NULL);
+        pthread_cond_init(&pool->start, NULL);
+        pthread_cond_init(&pool->done, NULL);
+        pool->gen = 0;
+        pool->busy = 0;
+        pool->stop = 0;
+        pool->fn = NULL;
+        pool->arg = NULL;
+
+        /* Part 0 is always processed by the caller. */
+        for (i = 1; i < nthreads; i++) {
+            pool->workers[i].pool = pool;
+            pool->workers[i].part = i;
+            if (pthread_create(&pool->workers[i].thread, NULL,
+                               intpl_pool_worker_main, &pool->workers[i])) {
+                /* Only stop the threads started so far. */
+                pool->nthreads = i;
+                intpl_pool_deinit(pool);
+                INTPL_STATS_INC(enomem);
+                rc = OS_ENOMEM;
+                goto err;
+            }
+        }
+    }
+#endif
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_pool_deinit(struct intpl_pool *pool)
+{
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    unsigned int i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 1; i < pool->nthreads; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+#endif
+
+    pool->nthreads = 0;
+
+    return 0;
+}
+
+int
+intpl_pool_run(struct intpl_pool *pool, intpl_pool_fn *fn, void *arg)
+{
+    if (pool->nthreads < 1) {
+        return OS_EINVAL;
+    }
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    /* Wake the workers, then process part 0 on the calling thread. */
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->busy = pool->nthreads - 1;
+    pool->gen++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    fn(arg, 0, pool->nthreads);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+#else
+    {
+        unsigned int i;
+
+        for (i = 0; i < pool->nthreads; i++) {
+            fn(arg, i, pool->nthreads);
+        }
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Returns the first x index processed by 'part'. The work is split evenly,
+ * but for sorted queries each split point is moved forward until it starts
+ * a new table segment, so neighbouring workers never share a segment.
+ */
+static unsigned int
+intpl_par_split(const struct intpl_par_job *job, unsigned int part,
+    unsigned int nparts)
+{
+    int rc;
+    int seg;
+    int idx;
+    unsigned int b;
+    unsigned int stride;
+    const float *tx;
+    struct intpl_cursor cur;
+
+    if (part == 0) {
+        return 0;
+    }
+    if (part >= nparts) {
+        return job->cnt;
+    }
+
+    b = (unsigned int)(((uint64_t)job->cnt * part) / nparts);
+    if (!job->sorted || b == 0 || b >= job->cnt) {
+        return b;
+    }
+
+    if (job->kind == INTPL_PAR_CUBIC) {
+        tx = &job->xyc[0].x;
+        stride = INTPL_PRIV_STRIDE(job->xyc);
+    } else {
+        tx = &job->xy[0].x;
+        stride = INTPL_PRIV_STRIDE(job->xy);
+    }
+
+    /* Find the segment of the last value in the previous part. */
+    rc = intpl_priv_find(tx, stride, job->n, job->x[b-1], &seg);
+    if (rc) {
+        return b;
+    }
+
+    /* Skip ahead while the values stay in that segment. */
+    cur.idx = seg;
+    while (b < job->cnt) {
+        rc = intpl_priv_find_cur(tx, stride, job->n, job->x[b], &cur, &idx);
+        if (rc || idx != seg) {
+            break;
+        }
+        b++;
+    }
+
+    return b;
+}
+
+static void
+intpl_par_work(void *arg, unsigned int part, unsigned int nparts)
+{
+    struct intpl_par_job *job;
+    struct intpl_cursor cur;
+    unsigned int start;
+    unsigned int end;
+
+    /*
+     * The job is split into at most as many parts as there are rc slots.
+     * intpl_pool_init already limits the pool to that, and parts past the
+     * limit would have an empty range anyway.
+     */
+    if (nparts > MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS)) {
+        nparts = MYNEWT_VAL(INTERPOLATE_POOL_MAX_THREADS);
+    }
+    if (part >= nparts) {
+        return;
+    }
+
+    job = (struct intpl_par_job *)arg;
+    start = intpl_par_split(job, part, nparts);
+    end = intpl_par_split(job, part + 1, nparts);
+
+    /* Every worker has its own cursor. */
+    cur.idx = -1;
+    job->rc[part] = 0;
+    if (end <= start) {
+        return;
+    }
+
+    switch (job->kind) {
+    case INTPL_PAR_NN:
+        job->rc[part] = intpl_nn_batch(job->xy, job->n, &job->x[start],
+            &job->y[start], end - start, &cur);
+        break;
+    case INTPL_PAR_LIN_Y:
+        job->rc[part] = intpl_lin_y_batch(job->xy, job->n, &job->x[start],
+            &job->y[start], end - start, &cur);
+        break;
+    case INTPL_PAR_CUBIC:
+        job->rc[part] = intpl_cubic_batch(job->xyc, job->n, &job->x[start],
+            &job->y[start], end - start, &cur);
+        break;
+    }
+}
+
+static int
+intpl_par_run(struct intpl_pool *pool, struct intpl_par_job *job)
+{
+    int rc;
+    unsigned int i;
+
+    rc = intpl_pool_run(pool, intpl_par_work, job);
+    if (rc) {
+        return rc;
+    }
+
+    /* Report the first error, in x order. */
+    for (i = 0; i < pool->nthreads; i++) {
+        if (job->rc[i]) {
+            return job->rc[i];
+        }
+    }
+
+    return 0;
+}
+
+int
+intpl_par_nn(struct intpl_pool *pool, struct intpl_xy xy[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted)
+{
+    struct intpl_par_job job;
+
+    job.kind = INTPL_PAR_NN;
+    job.xy = xy;
+    job.xyc = NULL;
+    job.n = n;
+    job.x = x;
+    job.y = y;
+    job.cnt = cnt;
+    job.sorted = sorted;
+
+    return intpl_par_run(pool, &job);
+}
+
+int
+intpl_par_lin_y(struct intpl_pool *pool, struct intpl_xy xy[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted)
+{
+    struct intpl_par_job job;
+
+    job.kind = INTPL_PAR_LIN_Y;
+    job.xy = xy;
+    job.xyc = NULL;
+    job.n = n;
+    job.x = x;
+    job.y = y;
+    job.cnt = cnt;
+    job.sorted = sorted;
+
+    return intpl_par_run(pool, &job);
+}
+
+int
+intpl_par_cubic(struct intpl_pool *pool, struct intpl_xyc xyc[],
+    unsigned int n, const float x[], float y[], unsigned int cnt, int sorted)
+{
+    struct intpl_par_job job;
+
+    job.kind = INTPL_PAR_CUBIC;
+    job.xy = NULL;
+    job.xyc = xyc;
+    job.n = n;
+    job.x = x;
+    job.y = y;
+    job.cnt = cnt;
+    job.sorted = sorted;
+
+    return intpl_par_run(pool, &job);
+}
+
+/** Values at the edges of a block, for the three right hand sides. */
+struct intpl_par_edge {
+    float y[2];     /**< Local solution at the first and last row. */
+    float v[2];     /**< Response to the row before the block. */
+    float w[2];     /**< Response to the row after the block. */
+};
+
+/** A parallel spline build, shared by every worker. */
+struct intpl_par_spline {
+    struct intpl_xyc *xyc;
+    unsigned int n;
+    float yp1;
+    float ypn;
+    int phase;          /**< 1 = reduce blocks, 2 = solve blocks. */
+    float *cp;          /**< n floats of scratch for the Thomas sweep. */
+    float *iface;       /**< Solved first/last value of every block. */
+    struct intpl_par_edge *edge;
+};
+
+/*
+ * Returns row i of the spline system, a*y2[i-1] + b*y2[i] + c*y2[i+1] = d.
+ * Interior rows are scaled the same way as in intpl_cubic_calc.
+ */
+static void
+intpl_par_row(const struct intpl_par_spline *sp, unsigned int i,
+    float *a, float *b, float *c, float *d)
+{
+    const struct intpl_xyc *xyc;
+    unsigned int n;
+    float h;
+    float sigma;
+
+    xyc = sp->xyc;
+    n = sp->n;
+
+    if (i == 0) {
+        *a = 0.0f;
+        *b = 1.0f;
+        if (sp->yp1 > 0.99e30f) {
+            *c = *d = 0.0f;
+        } else {
+            h = xyc[1].x - xyc[0].x;
+            *c = 0.5f;
+            *d = (3.0f / h) * ((xyc[1].y - xyc[0].y) / h - sp->yp1);
+        }
+    } else if (i == n - 1) {
+        *b = 1.0f;
+        *c = 0.0f;
+        if (sp->ypn > 0.99e30f) {
+            *a = *d = 0.0f;
+        } else {
+            h = xyc[n-1].x - xyc[n-2].x;
+            *a = 0.5f;
+            *d = (3.0f / h) * (sp->ypn - (xyc[n-1].y - xyc[n-2].y) / h);
+        }
+    } else {
+        sigma = (xyc[i].x - xyc[i-1].x) / (xyc[i+1].x - xyc[i-1].x);
+        *a = sigma;
+        *b = 2.0f;
+        *c = 1.0f - sigma;
+        *d = 6.0f * ((xyc[i+1].y - xyc[i].y) / (xyc[i+1].x - xyc[i].x) -
+            (xyc[i].y - xyc[i-1].y) / (xyc[i].x - xyc[i-1].x)) /
+            (xyc[i+1].x - xyc[i-1].x);
+    }
+}
+
+/*
+ * Phase 1: solves the block on its own, with the couplings to the rows
+ * either side removed. Only the first and last values are needed, so a
+ * top-down sweep gives the last row and a bottom-up sweep the first row,
+ * without storing anything per row.
+ */
+static void
+intpl_par_reduce(struct intpl_par_spline *sp, unsigned int s, unsigned int e,
+    struct intpl_par_edge *edge)
+{
+    unsigned int i;
+    float a, b, c, d;
+    float a_s, c_e;
+    float m;
+    float cp, yp, vp, wp;
+
+    intpl_par_row(sp, s, &a_s, &b, &c, &d);
+    intpl_par_row(sp, e, &a, &b, &c_e, &d);
+
+    /* Top-down: the last row is solved when the sweep ends. */
+    cp = yp = vp = wp = 0.0f;
+    for (i = s; i <= e; i++) {
+        intpl_par_row(sp, i, &a, &b, &c, &d);
+        if (i == s) {
+            a = 0.0f;
+        }
+        m = 1.0f / (b - a * cp);
+        cp = c * m;
+        yp = (d - a * yp) * m;
+        vp = ((i == s ? a_s : 0.0f) - a * vp) * m;
+        wp = ((i == e ? c_e : 0.0f) - a * wp) * m;
+    }
+    edge->y[1] = yp;
+    edge->v[1] = vp;
+    edge->w[1] = wp;
+
+    /* Bottom-up: the first row is solved when the sweep ends. */
+    cp = yp = vp = wp = 0.0f;
+    for (i = e + 1; i-- > s; ) {
+        intpl_par_row(sp, i, &a, &b, &c, &d);
+        if (i == e) {
+            c = 0.0f;
+        }
+        m = 1.0f / (b - c * cp);
+        cp = a * m;
+        yp = (d - c * yp) * m;
+        vp = ((i == s ? a_s : 0.0f) - c * vp) * m;
+        wp = ((i == e ? c_e : 0.0f) - c * wp) * m;
+    }
+    edge->y[0] = yp;
+    edge->v[0] = vp;
+    edge->w[0] = wp;
+}
+
+/*
+ * Phase 2: with the values either side of the block known, the block is an
+ * ordinary tridiagonal system and is solved with the Thomas algorithm.
+ */
+static void
+intpl_par_solve(struct intpl_par_spline *sp, unsigned int s, unsigned int e,
+    float left, float right)
+{
+    unsigned int i;
+    float a, b, c, d;
+    float m;
+    float *cp;
+    struct intpl_xyc *xyc;
+
+    cp = sp->cp;
+    xyc = sp->xyc;
+
+    for (i = s; i <= e; i++) {
+        intpl_par_row(sp, i, &a, &b, &c, &d);
+        if (i == s) {
+            d -= a * left;
+            a = 0.0f;
+        }
+        if (i == e) {
+            d -= c * right;
+            c = 0.0f;
+        }
+        m = 1.0f / (b - (i == s ? 0.0f : a * cp[i-1]));
+        cp[i] = c * m;
+        xyc[i].y2 = (d - (i == s ? 0.0f : a * xyc[i-1].y2)) * m;
+    }
+
+    for (i = e; i-- > s; ) {
+        xyc[i].y2 -= cp[i] * xyc[i+1].y2;
+    }
+}
+
+static void
+intpl_par_spline_work(void *arg, unsigned int part, unsigned int nparts)
+{
+    struct intpl_par_spline *sp;
+    unsigned int s;
+    unsigned int e;
+    float left;
+    float right;
+
+    sp = (struct intpl_par_spline *)arg;
+    s = (unsigned int)(((uint64_t)sp->n * part) / nparts);
+    e = (unsigned int)(((uint64_t)sp->n * (part + 1)) / nparts) - 1;
+
+    if (sp->phase == 1) {
+        intpl_par_reduce(sp, s, e, &sp->edge[part]);
+    } else {
+        left = part > 0 ? sp->iface[2*part - 1] : 0.0f;
+        right = part < nparts - 1 ? sp->iface[2*part + 2] : 0.0f;
+        intpl_par_solve(sp, s, e, left, right);
+    }
+}
+
+/*
+ * Solves the system in the first (S) and last (E) value of every block:
+ *
+ *   S[k] + v0[k] * E[k-1] + w0[k] * S[k+1] = y0[k]
+ *   E[k] + v1[k] * E[k-1] + w1[k] * S[k+1] = y1[k]
+ *
+ * It is at most 2 * INTERPOLATE_POOL_MAX_THREADS unknowns, so a dense
+ * elimination with partial pivoting (in double) is used.
+ */
+static int
+intpl_par_iface_solve(struct intpl_par_spline *sp, unsigned int nparts)
+{
+    unsigned int m;
+    unsigned int r, k, j, p;
+    unsigned int row;
+    double *mat;
+    double *rhs;
+    double f;
+    double t;
+
+    m = 2 * nparts;
+    mat = (double *)os_malloc((m * m + m) * sizeof(double));
+    if (mat == NULL) {
+        INTPL_STATS_INC(enomem);
+        return OS_ENOMEM;
+    }
+    rhs = mat + m * m;
+
+    for (r = 0; r < m * m; r++) {
+        mat[r] = 0.0;
+    }
+
+    for (k = 0; k < nparts; k++) {
+        for (j = 0; j < 2; j++) {
+            row = 2 * k + j;
+            mat[row * m + row] = 1.0;
+            if (k > 0) {
+                mat[row * m + 2 * k - 1] += sp->edge[k].v[j];
+            }
+            if (k < nparts - 1) {
+                mat[row * m + 2 * k + 2] += sp->edge[k].w[j];
+            }
+            rhs[row] = sp->edge[k].y[j];
+        }
+    }
+
+    /* Forward elimination. */
+    for (k = 0; k < m; k++) {
+        p = k;
+        for (r = k + 1; r < m; r++) {
+            if (fabs(mat[r * m + k]) > fabs(mat[p * m + k])) {
+                p = r;
+            }
+        }
+        if (p != k) {
+            for (j = 0; j < m; j++) {
+                t = mat[k * m + j];
+                mat[k * m + j] = mat[p * m + j];
+                mat[p * m + j] = t;
+            }
+            t = rhs[k];
+            rhs[k] = rhs[p];
+            rhs[p] = t;
+        }
+        for (r = k + 1; r < m; r++) {
+            f = mat[r * m + k] / mat[k * m + k];
+            if (f == 0.0) {
+                continue;
+            }
+            for (j = k; j < m; j++) {
+                mat[r * m + j] -= f * mat[k * m + j];
+            }
+            rhs[r] -= f * rhs[k];
+        }
+    }
+
+    /* Back substitution. */
+    for (k = m; k-- > 0; ) {
+        t = rhs[k];
+        for (j = k + 1; j < m; j++) {
+            t -= mat[k * m + j] * rhs[j];
+        }
+        rhs[k] = t / mat[k * m + k];
+        sp->iface[k] = (float)rhs[k];
+    }
+
+    os_free(mat);
+
+    return 0;
+}
+
+int
+intpl_par_cubic_calc(struct intpl_pool *pool, struct intpl_xyc xyc[],
+    unsigned int n, float yp1, float ypn)
+{
+    int rc;
+    unsigned int nparts;
+    struct intpl_par_spline sp;
+
+    nparts = pool->nthreads;
+
+    /* Small tables are not worth splitting. */
+    if (nparts <= 1 || n < 4 * nparts) {
+        return intpl_cubic_calc(xyc, n, yp1, ypn);
+    }
+
+    sp.xyc = xyc;
+    sp.n = n;
+    sp.yp1 = yp1;
+    sp.ypn = ypn;
+
+    sp.cp = (float *)os_malloc(n * sizeof(float) +
+        nparts * (2 * sizeof(float) + sizeof(struct intpl_par_edge)));
+    if (sp.cp == NULL) {
+        INTPL_STATS_INC(enomem);
+        rc = OS_ENOMEM;
+        goto err;
+    }
+    sp.edge = (struct intpl_par_edge *)(sp.cp + n);
+    sp.iface = (float *)(sp.edge + nparts);
+
+    sp.phase = 1;
+    rc = intpl_pool_run(pool, intpl_par_spline_work, &sp);
+    if (rc) {
+        goto err_free;
+    }
+
+    rc = intpl_par_iface_solve(&sp, nparts);
+    if (rc) {
+        goto err_free;
+    }
+
+    sp.phase = 2;
+    rc = intpl_pool_run(pool, intpl_par_spline_work, &sp);
+    if (rc) {
+        goto err_free;
+    }
+
+    os_free(sp.cp);
+
+    return 0;
+err_free:
+    os_free(sp.cp);
+err:
+    return rc;
+}
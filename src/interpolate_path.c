@@ -0,0 +1,377 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_path.h"
+#include "interpolate_priv.h"
+
+static inline void
+intpl_path_nan(struct intpl_xy *pt)
+{
+    pt->x = NAN;
+    pt->y = NAN;
+}
+
+/**
+ * Evaluates a Bezier curve of degree 1 to 3 from its Bernstein weights.
+ * t is not checked.
+ */
+static void
+intpl_path_bezier(const struct intpl_xy p[], uint8_t deg, float t,
+    struct intpl_xy *pt)
+{
+    float u;
+    float b0;
+    float b1;
+    float b2;
+    float b3;
+
+    u = 1.0f - t;
+    switch (deg) {
+    case 1:
+        pt->x = u * p[0].x + t * p[1].x;
+        pt->y = u * p[0].y + t * p[1].y;
+        break;
+    case 2:
+        b0 = u * u;
+        b1 = 2.0f * u * t;
+        b2 = t * t;
+        pt->x = b0 * p[0].x + b1 * p[1].x + b2 * p[2].x;
+        pt->y = b0 * p[0].y + b1 * p[1].y + b2 * p[2].y;
+        break;
+    default:
+        b0 = u * u * u;
+        b1 = 3.0f * u * u * t;
+        b2 = 3.0f * u * t * t;
+        b3 = t * t * t;
+        pt->x = b0 * p[0].x + b1 * p[1].x + b2 * p[2].x + b3 * p[3].x;
+        pt->y = b0 * p[0].y + b1 * p[1].y + b2 * p[2].y + b3 * p[3].y;
+        break;
+    }
+}
+
+/** Looks up x in a table, with or without a cursor. */
+static int
+intpl_path_find(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_cursor *cur, int *idx)
+{
+    if (cur == NULL) {
+        return intpl_priv_find(x, stride, n, xv, idx);
+    }
+
+    return intpl_priv_find_cur(x, stride, n, xv, cur, idx);
+}
+
+/** The distance of point i of cnt evenly spaced points over len. */
+static inline float
+intpl_path_step(float len, unsigned int i, unsigned int cnt)
+{
+    /* Make sure the last point lands exactly on the end. */
+    if (i + 1 >= cnt) {
+        return (cnt > 1) ? len : 0.0f;
+    }
+
+    return len * (float)i / (float)(cnt - 1);
+}
+
+int
+intpl_bezier2(const struct intpl_xy p[3], float t, struct intpl_xy *pt)
+{
+    int rc;
+
+    /* Ensure t = 0.0..1.0 */
+    if ((t < 0.0f) || (t > 1.0f)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        intpl_path_nan(pt);
+        goto err;
+    }
+
+    intpl_path_bezier(p, 2, t, pt);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_bezier3(const struct intpl_xy p[4], float t, struct intpl_xy *pt)
+{
+    int rc;
+
+    /* Ensure t = 0.0..1.0 */
+    if ((t < 0.0f) || (t > 1.0f)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        intpl_path_nan(pt);
+        goto err;
+    }
+
+    intpl_path_bezier(p, 3, t, pt);
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_bezier_batch(const struct intpl_xy p[], uint8_t deg, const float t[],
+    struct intpl_xy out[], unsigned int cnt)
+{
+    int rc_first;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    if ((deg < 1) || (deg > 3)) {
+        rc_first = OS_EINVAL;
+        for (i = 0; i < cnt; i++) {
+            intpl_path_nan(&out[i]);
+        }
+        goto err;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        if ((t[i] < 0.0f) || (t[i] > 1.0f)) {
+            INTPL_STATS_INC(einval_range);
+            intpl_path_nan(&out[i]);
+            rc_first = OS_EINVAL;
+            continue;
+        }
+        intpl_path_bezier(p, deg, t[i], &out[i]);
+    }
+
+err:
+    return rc_first;
+}
+
+int
+intpl_bezier_fill(const struct intpl_xy p[], uint8_t deg,
+    struct intpl_xy out[], unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    if ((deg < 1) || (deg > 3)) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    for (i = 0; i < cnt; i++) {
+        intpl_path_bezier(p, deg, intpl_path_step(1.0f, i, cnt), &out[i]);
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_bez_arc_init(struct intpl_bez_arc *arc, const struct intpl_xy p[],
+    uint8_t deg, struct intpl_xy lut[], unsigned int m)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    double s;
+    float t;
+    struct intpl_xy a;
+    struct intpl_xy b;
+
+    if ((deg < 1) || (deg > 3)) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (m < 2) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    for (i = 0; i <= deg; i++) {
+        arc->p[i] = p[i];
+    }
+    arc->deg = deg;
+    arc->lut = lut;
+    arc->m = m;
+
+    /* Sum the chords in double, so long tables don't drift. */
+    s = 0.0;
+    a = p[0];
+    lut[0].x = 0.0f;
+    lut[0].y = 0.0f;
+    for (i = 1; i < m; i++) {
+        for (j = 1; j <= INTPL_PATH_SUB; j++) {
+            t = ((float)(i - 1) + (float)j / INTPL_PATH_SUB) / (float)(m - 1);
+            intpl_path_bezier(p, deg, t, &b);
+            s += hypotf(b.x - a.x, b.y - a.y);
+            a = b;
+        }
+        lut[i].x = (float)s;
+        lut[i].y = (float)i / (float)(m - 1);
+    }
+    lut[m - 1].y = 1.0f;
+    arc->len = lut[m - 1].x;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_bez_arc_at(const struct intpl_bez_arc *arc, float dist,
+    struct intpl_xy *pt, struct intpl_cursor *cur)
+{
+    int rc;
+    int idx;
+    float ds;
+    float t;
+
+    rc = intpl_path_find(&arc->lut[0].x, INTPL_PRIV_STRIDE(arc->lut), arc->m,
+        dist, cur, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    /* Map the distance to t, the curve itself does the rest. */
+    t = arc->lut[idx].y;
+    ds = arc->lut[idx + 1].x - arc->lut[idx].x;
+    if (ds > 0.0f) {
+        t += (dist - arc->lut[idx].x) / ds *
+            (arc->lut[idx + 1].y - arc->lut[idx].y);
+    }
+    intpl_path_bezier(arc->p, arc->deg, t, pt);
+
+    return 0;
+err:
+    intpl_path_nan(pt);
+    return rc;
+}
+
+int
+intpl_bez_arc_fill(const struct intpl_bez_arc *arc, struct intpl_xy out[],
+    unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+    struct intpl_cursor cur;
+
+    INTPL_STATS_INC(batch);
+
+    cur.idx = -1;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_bez_arc_at(arc, intpl_path_step(arc->len, i, cnt),
+            &out[i], &cur);
+        if (rc) {
+            goto err;
+        }
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_poly_init(struct intpl_poly *poly, const struct intpl_xy pts[],
+    unsigned int n, float s[])
+{
+    int rc;
+    unsigned int i;
+    double d;
+
+    if (n < 2) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    poly->pts = pts;
+    poly->s = s;
+    poly->n = n;
+
+    d = 0.0;
+    s[0] = 0.0f;
+    for (i = 1; i < n; i++) {
+        d += hypotf(pts[i].x - pts[i - 1].x, pts[i].y - pts[i - 1].y);
+        s[i] = (float)d;
+    }
+    poly->len = s[n - 1];
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_poly_at(const struct intpl_poly *poly, float dist,
+    struct intpl_xy *pt, struct intpl_cursor *cur)
+{
+    int rc;
+    int idx;
+    float ds;
+    float f;
+    const struct intpl_xy *a;
+    const struct intpl_xy *b;
+
+    rc = intpl_path_find(poly->s, 1, poly->n, dist, cur, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    a = &poly->pts[idx];
+    b = &poly->pts[idx + 1];
+    ds = poly->s[idx + 1] - poly->s[idx];
+    f = (ds > 0.0f) ? (dist - poly->s[idx]) / ds : 0.0f;
+    pt->x = (1.0f - f) * a->x + f * b->x;
+    pt->y = (1.0f - f) * a->y + f * b->y;
+
+    return 0;
+err:
+    intpl_path_nan(pt);
+    return rc;
+}
+
+int
+intpl_poly_fill(const struct intpl_poly *poly, struct intpl_xy out[],
+    unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+    struct intpl_cursor cur;
+
+    INTPL_STATS_INC(batch);
+
+    cur.idx = -1;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_poly_at(poly, intpl_path_step(poly->len, i, cnt),
+            &out[i], &cur);
+        if (rc) {
+            goto err;
+        }
+    }
+
+    return 0;
+err:
+    return rc;
+}
@@ -20,11 +20,149 @@
 #define _INTERPOLATE_PRIV_H_
 
 #include <stdint.h>
+#include "interpolate/interpolate.h"
+#include "interpolate/interpolate_srch.h"
+#include "interpolate/interpolate_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+#define INTPL_STATS_INC(var)        STATS_INC(g_intpl_stats, var)
+#define INTPL_STATS_INCN(var, n)    STATS_INCN(g_intpl_stats, var, n)
+#else
+#define INTPL_STATS_INC(var)
+#define INTPL_STATS_INCN(var, n)
+#endif
+
+/** Number of floats between consecutive x values in an array of structs. */
+#define INTPL_PRIV_STRIDE(arr) (sizeof((arr)[0]) / sizeof(float))
+
+/**
+ * Bisection search shared by all table types. Identical to intpl_find_x, but
+ * works on any array where consecutive x values are 'stride' floats apart,
+ * allowing plain float arrays, intpl_xy and intpl_xyc tables to share it.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find(const float *x, unsigned int stride, unsigned int n,
+    float xv, int *idx);
+
+/**
+ * Interpolation search version of intpl_priv_find. The segment is guessed
+ * from the position of xv between the first and last x values, then found
+ * by galloping away from the guess and bisecting the bracket. The result is
+ * always identical to intpl_priv_find.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find_guess(const float *x, unsigned int stride, unsigned int n,
+    float xv, int *idx);
+
+/**
+ * Galloping version of intpl_priv_find. The search starts at segment
+ * 'start', gallops away from it until xv is bracketed, and bisects the
+ * bracket. The result is always identical to intpl_priv_find.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ * @param start  The segment to start from, clamped to the table.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find_gallop(const float *x, unsigned int stride,
+    unsigned int n, float xv, unsigned int start, int *idx);
+
+/**
+ * Guesses the segment containing xv from its position between the first
+ * and last x values, as used by intpl_priv_find_guess.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ *
+ * @return The guessed segment, between 0 and n - 2.
+ */
+unsigned int intpl_priv_guess(const float *x, unsigned int stride,
+    unsigned int n, float xv);
+
+/**
+ * Cursor-assisted version of intpl_priv_find. The segment in 'cur' and the
+ * one after it are checked first, with a full bisection search as fallback.
+ * The result is always identical to intpl_priv_find.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ * @param cur    The search cursor, updated on success.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find_cur(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_cursor *cur, int *idx);
+
+/**
+ * Bucket index version of intpl_priv_find. The result is always identical
+ * to intpl_priv_find.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values, which must match the index.
+ * @param xv     The x value to search for.
+ * @param bkt    The bucket index built for x.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find_bkt(const float *x, unsigned int stride, unsigned int n,
+    float xv, const struct intpl_bkt *bkt, int *idx);
+
+/**
+ * Locates the segment containing xv with the strategy in 'srch'. The
+ * result is always identical to intpl_priv_find.
+ *
+ * @param x      Pointer to the first x value.
+ * @param stride Distance between consecutive x values, in floats.
+ * @param n      The number of x values.
+ * @param xv     The x value to search for.
+ * @param srch   The search descriptor, updated on success.
+ * @param idx    Pointer to the placeholder for the lower segment index.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_find_srch(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_srch *srch, int *idx);
+
+/**
+ * Evaluates the cubic spline segment starting at 'lo' for x.
+ *
+ * @param lo  The lower point of the segment; lo[1] is the upper point.
+ * @param x   The X value to interpolate for.
+ * @param y   Pointer to the placeholder for the interpolated Y value.
+ *
+ * @return 0 on success, error code on error.
+ */
+int intpl_priv_cubic_seg(const struct intpl_xyc *lo, float x, float *y);
+
 #ifdef __cplusplus
 }
 #endif
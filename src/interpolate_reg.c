@@ -0,0 +1,300 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_reg.h"
+#include "interpolate_priv.h"
+
+static void
+intpl_reg_unlink(struct intpl_reg *reg, struct intpl_reg_ent *ent)
+{
+    if (ent->prev != NULL) {
+        ent->prev->next = ent->next;
+    } else {
+        reg->mru = ent->next;
+    }
+    if (ent->next != NULL) {
+        ent->next->prev = ent->prev;
+    } else {
+        reg->lru = ent->prev;
+    }
+}
+
+static void
+intpl_reg_push(struct intpl_reg *reg, struct intpl_reg_ent *ent)
+{
+    ent->prev = NULL;
+    ent->next = reg->mru;
+    if (reg->mru != NULL) {
+        reg->mru->prev = ent;
+    } else {
+        reg->lru = ent;
+    }
+    reg->mru = ent;
+}
+
+/** Finds a source table by bisection over the sorted IDs. */
+static const struct intpl_reg_src *
+intpl_reg_src_find(const struct intpl_reg *reg, uint32_t id)
+{
+    unsigned int lo;
+    unsigned int hi;
+    unsigned int mid;
+
+    lo = 0;
+    hi = reg->nsrc;
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (reg->src[mid].id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return (lo < reg->nsrc && reg->src[lo].id == id) ? &reg->src[lo] : NULL;
+}
+
+static int
+intpl_reg_build(struct intpl_reg *reg, struct intpl_reg_ent *ent,
+    const struct intpl_reg_src *src)
+{
+    int rc;
+    unsigned int i;
+
+    ent->src = src;
+    for (i = 0; i < src->n; i++) {
+        ent->xyc[i].x = src->xy[i].x;
+        ent->xyc[i].y = src->xy[i].y;
+        ent->xyc[i].y2 = 0.0f;
+    }
+
+    /*
+     * A spline needs three points. A two point table is still built, for
+     * linear lookups, and the cubic lookups reject it by size.
+     */
+    if (src->n >= 3) {
+        rc = intpl_cubic_calc(ent->xyc, src->n, src->yp1, src->ypn);
+        if (rc) {
+            goto err;
+        }
+    }
+
+    /* The bucket storage follows the largest table a block can hold. */
+    rc = intpl_bkt_init_xyc(&ent->bkt, &ent->xyc[reg->max_pts],
+        intpl_bkt_size(reg->nb), ent->xyc, src->n, reg->nb);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_reg_init(struct intpl_reg *reg, const struct intpl_reg_src src[],
+    unsigned int nsrc, os_membuf_t *buf, uint16_t nblocks,
+    unsigned int max_pts, unsigned int nb)
+{
+    int rc;
+    unsigned int i;
+
+    if (nblocks < 1 || max_pts < 2 || nb < 1) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    for (i = 0; i < nsrc; i++) {
+        if (src[i].n < 2 || src[i].n > max_pts) {
+            INTPL_STATS_INC(einval_size);
+            rc = OS_EINVAL;
+            goto err;
+        }
+        if (i > 0 && src[i].id <= src[i - 1].id) {
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+
+    rc = os_mempool_init(&reg->pool, nblocks,
+        INTPL_REG_BLOCK_SIZE(max_pts, nb), buf, "intpl_reg");
+    if (rc) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    reg->src = src;
+    reg->nsrc = nsrc;
+    reg->max_pts = max_pts;
+    reg->nb = nb;
+    reg->mru = NULL;
+    reg->lru = NULL;
+    reg->hits = 0;
+    reg->misses = 0;
+    reg->evictions = 0;
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_reg_get(struct intpl_reg *reg, uint32_t id,
+    const struct intpl_reg_ent **ent)
+{
+    int rc;
+    struct intpl_reg_ent *e;
+    const struct intpl_reg_src *src;
+
+    /* Only a few tables are built at once, and hot ones stay near mru. */
+    for (e = reg->mru; e != NULL; e = e->next) {
+        if (e->src->id == id) {
+            INTPL_STATS_INC(cache_hit);
+            reg->hits++;
+            if (e != reg->mru) {
+                intpl_reg_unlink(reg, e);
+                intpl_reg_push(reg, e);
+            }
+            *ent = e;
+            return 0;
+        }
+    }
+
+    src = intpl_reg_src_find(reg, id);
+    if (src == NULL) {
+        rc = OS_ENOENT;
+        goto err;
+    }
+
+    INTPL_STATS_INC(cache_miss);
+    reg->misses++;
+
+    e = os_memblock_get(&reg->pool);
+    if (e == NULL) {
+        /* Reuse the block of the least recently used table. */
+        INTPL_STATS_INC(cache_evict);
+        reg->evictions++;
+        e = reg->lru;
+        intpl_reg_unlink(reg, e);
+    }
+
+    rc = intpl_reg_build(reg, e, src);
+    if (rc) {
+        os_memblock_put(&reg->pool, e);
+        goto err;
+    }
+
+    intpl_reg_push(reg, e);
+    *ent = e;
+
+    return 0;
+err:
+    return rc;
+}
+
+void
+intpl_reg_flush(struct intpl_reg *reg)
+{
+    struct intpl_reg_ent *e;
+
+    while (reg->mru != NULL) {
+        e = reg->mru;
+        intpl_reg_unlink(reg, e);
+        os_memblock_put(&reg->pool, e);
+    }
+}
+
+int
+intpl_reg_lin_y(struct intpl_reg *reg, uint32_t id, float x, float *y)
+{
+    int rc;
+    const struct intpl_reg_ent *ent;
+    struct intpl_srch srch;
+
+    rc = intpl_reg_get(reg, id, &ent);
+    if (rc) {
+        *y = NAN;
+        goto err;
+    }
+
+    /* The index is over xyc, which has the same x values as the source. */
+    intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &ent->bkt);
+    rc = intpl_lin_y_srch((struct intpl_xy *)ent->src->xy, ent->src->n, x, y,
+        &srch);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_reg_cubic(struct intpl_reg *reg, uint32_t id, float x, float *y)
+{
+    int rc;
+    const struct intpl_reg_ent *ent;
+    struct intpl_srch srch;
+
+    rc = intpl_reg_get(reg, id, &ent);
+    if (rc) {
+        *y = NAN;
+        goto err;
+    }
+
+    intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &ent->bkt);
+    rc = intpl_cubic_srch((struct intpl_xyc *)ent->xyc, ent->src->n, x, y,
+        &srch);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_reg_cubic_batch(struct intpl_reg *reg, uint32_t id, const float x[],
+    float y[], unsigned int cnt)
+{
+    int rc;
+    unsigned int i;
+    const struct intpl_reg_ent *ent;
+
+    rc = intpl_reg_get(reg, id, &ent);
+    if (rc) {
+        for (i = 0; i < cnt; i++) {
+            y[i] = NAN;
+        }
+        goto err;
+    }
+
+    rc = intpl_cubic_batch((struct intpl_xyc *)ent->xyc, ent->src->n, x, y,
+        cnt, NULL);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    return rc;
+}
@@ -0,0 +1,432 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_resample.h"
+#include "interpolate_priv.h"
+
+/* Natural cubic spline, only reachable through intpl_resample_cubic*. */
+#define INTPL_RS_CUBIC  (3)
+
+/* Maximum number of forward difference steps between exact evaluations. */
+#define INTPL_RS_FD_RESYNC  (64)
+
+/* x, y and y2 of source value i, where p points to the first x value. */
+#define RS_X(i)     (p[(i)*stride])
+#define RS_Y(i)     (p[(i)*stride+1])
+#define RS_Y2(i)    (p[(i)*stride+2])
+
+/* A source segment, as y = a + t * (b + t * (c + t * d)) for t = x - x0,
+ * switching to y = a_hi from x = mid onwards (nearest neighbour only). */
+struct intpl_rs_seg {
+    float x0;
+    float mid;
+    float a;
+    float b;
+    float c;
+    float d;
+    float a_hi;
+};
+
+/* Derivative at source value k from Fritsch and Butland, as used by PCHIP.
+ * Only values k-1..k+1 are read, so no precalculation is needed. */
+static float
+intpl_rs_pchip(const float *p, unsigned int stride, unsigned int n,
+    unsigned int k)
+{
+    float h0;
+    float h1;
+    float d0;
+    float d1;
+    float w1;
+    float w2;
+    float m;
+
+    if (n == 2) {
+        return (RS_Y(1) - RS_Y(0)) / (RS_X(1) - RS_X(0));
+    }
+
+    if (k == 0 || k == n - 1) {
+        /* One-sided three point estimate, limited to keep the shape. */
+        if (k == 0) {
+            h0 = RS_X(1) - RS_X(0);
+            h1 = RS_X(2) - RS_X(1);
+            d0 = (RS_Y(1) - RS_Y(0)) / h0;
+            d1 = (RS_Y(2) - RS_Y(1)) / h1;
+        } else {
+            h0 = RS_X(n-1) - RS_X(n-2);
+            h1 = RS_X(n-2) - RS_X(n-3);
+            d0 = (RS_Y(n-1) - RS_Y(n-2)) / h0;
+            d1 = (RS_Y(n-2) - RS_Y(n-3)) / h1;
+        }
+        m = ((2.0f * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if ((m > 0.0f) != (d0 > 0.0f) || m == 0.0f || d0 == 0.0f) {
+            m = 0.0f;
+        } else if ((d0 > 0.0f) != (d1 > 0.0f) && fabsf(m) > 3.0f * fabsf(d0)) {
+            m = 3.0f * d0;
+        }
+        return m;
+    }
+
+    h0 = RS_X(k) - RS_X(k-1);
+    h1 = RS_X(k+1) - RS_X(k);
+    d0 = (RS_Y(k) - RS_Y(k-1)) / h0;
+    d1 = (RS_Y(k+1) - RS_Y(k)) / h1;
+    if (d0 * d1 <= 0.0f) {
+        /* Local extremum or flat section. */
+        return 0.0f;
+    }
+
+    /* Weighted harmonic mean of the neighbouring slopes. */
+    w1 = 2.0f * h1 + h0;
+    w2 = h1 + 2.0f * h0;
+    return (w1 + w2) / (w1 / d0 + w2 / d1);
+}
+
+/* Calculates the coefficients of source segment i. */
+static void
+intpl_rs_coef(const float *p, unsigned int stride, unsigned int n,
+    uint8_t mode, unsigned int i, struct intpl_rs_seg *s)
+{
+    float h;
+    float delta;
+    float m0;
+    float m1;
+
+    h = RS_X(i+1) - RS_X(i);
+    delta = (RS_Y(i+1) - RS_Y(i)) / h;
+
+    s->x0 = RS_X(i);
+    s->mid = INFINITY;
+    s->a = RS_Y(i);
+    s->b = 0.0f;
+    s->c = 0.0f;
+    s->d = 0.0f;
+    s->a_hi = RS_Y(i+1);
+
+    switch (mode) {
+    case INTPL_RS_NN:
+        s->mid = RS_X(i) + 0.5f * h;
+        break;
+    case INTPL_RS_LIN:
+        s->b = delta;
+        break;
+    case INTPL_RS_MONO:
+        /* Cubic Hermite with the PCHIP derivatives. */
+        m0 = intpl_rs_pchip(p, stride, n, i);
+        m1 = intpl_rs_pchip(p, stride, n, i + 1);
+        s->b = m0;
+        s->c = (3.0f * delta - 2.0f * m0 - m1) / h;
+        s->d = (m0 + m1 - 2.0f * delta) / (h * h);
+        break;
+    case INTPL_RS_CUBIC:
+        /* The spline in intpl_priv_cubic_seg, expanded around x0. */
+        s->b = delta - h * (2.0f * RS_Y2(i) + RS_Y2(i+1)) / 6.0f;
+        s->c = 0.5f * RS_Y2(i);
+        s->d = (RS_Y2(i+1) - RS_Y2(i)) / (6.0f * h);
+        break;
+    }
+}
+
+static inline float
+intpl_rs_eval(const struct intpl_rs_seg *s, float xv)
+{
+    float t;
+
+    if (xv >= s->mid) {
+        return s->a_hi;
+    }
+
+    t = xv - s->x0;
+    return s->a + t * (s->b + t * (s->c + t * s->d));
+}
+
+/* Sets all m destination values to NAN. */
+static void
+intpl_rs_nan(float y[], unsigned int m)
+{
+    unsigned int i;
+
+    for (i = 0; i < m; i++) {
+        y[i] = NAN;
+    }
+}
+
+/* Checks the arguments shared by all resampling functions. */
+static int
+intpl_rs_check(const float *p, unsigned int stride, unsigned int n,
+    uint8_t mode, float y[], unsigned int m)
+{
+    int rc;
+    unsigned int i;
+
+    if (n < 2 || (mode == INTPL_RS_CUBIC && n < 3)) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Segment sizes are used as divisors, so x must be strictly ascending. */
+    for (i = 0; i < n - 1; i++) {
+        if (!(RS_X(i+1) > RS_X(i))) {
+            INTPL_STATS_INC(einval_delta);
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+
+    return 0;
+err:
+    intpl_rs_nan(y, m);
+    return rc;
+}
+
+static int
+intpl_rs_run(const float *p, unsigned int stride, unsigned int n,
+    uint8_t mode, const float x[], float y[], unsigned int m)
+{
+    int rc;
+    int idx;
+    unsigned int k;
+    unsigned int i;
+    unsigned int seg;
+    float xv;
+    struct intpl_rs_seg s;
+
+    INTPL_STATS_INC(batch);
+
+    rc = intpl_rs_check(p, stride, n, mode, y, m);
+    if (rc) {
+        return rc;
+    }
+
+    i = 0;
+    seg = n;
+    for (k = 0; k < m; k++) {
+        xv = x[k];
+        if (!(xv >= RS_X(0) && xv <= RS_X(n-1))) {
+            INTPL_STATS_INC(einval_range);
+            y[k] = NAN;
+            rc = rc ? rc : OS_EINVAL;
+            continue;
+        }
+
+        if (xv < RS_X(i)) {
+            /* The destination went backwards, search from scratch. */
+            intpl_priv_find(p, stride, n, xv, &idx);
+            i = idx;
+        }
+
+        /* Merge step: advance through the source. */
+        while (i < n - 2 && xv >= RS_X(i+1)) {
+            i++;
+        }
+
+        if (i != seg) {
+            intpl_rs_coef(p, stride, n, mode, i, &s);
+            seg = i;
+        }
+        y[k] = intpl_rs_eval(&s, xv);
+    }
+
+    return rc;
+}
+
+/* Checks whether xv belongs to a segment ending at xhi. The last segment
+ * includes its upper end. */
+static inline int
+intpl_rs_in_seg(float xv, float xhi, int last)
+{
+    return xv < xhi || (xv == xhi && last);
+}
+
+/* Returns the index after the last uniform destination value, from k
+ * onwards, that falls in the segment ending at xhi. Value k must be in the
+ * segment. */
+static unsigned int
+intpl_rs_seg_end(float x0, float dx, unsigned int k, unsigned int m,
+    float xhi, int last)
+{
+    float pos;
+    unsigned int end;
+
+    pos = (xhi - x0) / dx;
+    end = pos >= (float)m ? m : (pos > (float)k ? (unsigned int)pos : k);
+
+    /* Correct for rounding, with the same test the evaluation uses. */
+    while (end < m && intpl_rs_in_seg(x0 + (float)end * dx, xhi, last)) {
+        end++;
+    }
+    while (end > k + 1 &&
+           !intpl_rs_in_seg(x0 + (float)(end - 1) * dx, xhi, last)) {
+        end--;
+    }
+
+    return end;
+}
+
+/* Evaluates segment s for destination values k..end-1 by forward
+ * differencing, restarting from an exact value every INTPL_RS_FD_RESYNC
+ * steps to bound the accumulated rounding error. */
+static void
+intpl_rs_fd(const struct intpl_rs_seg *s, float x0, float dx, unsigned int k,
+    unsigned int end, float y[])
+{
+    unsigned int j;
+    unsigned int stop;
+    float t;
+    float y0;
+    float d1;
+    float d2;
+    float d3;
+
+    d3 = 6.0f * s->d * dx * dx * dx;
+    while (k < end) {
+        t = x0 + (float)k * dx - s->x0;
+        y0 = s->a + t * (s->b + t * (s->c + t * s->d));
+        d1 = dx * (s->b + s->c * (2.0f * t + dx) +
+            s->d * (3.0f * t * t + 3.0f * t * dx + dx * dx));
+        d2 = dx * dx * (2.0f * s->c + s->d * (6.0f * t + 6.0f * dx));
+
+        stop = end - k > INTPL_RS_FD_RESYNC ? k + INTPL_RS_FD_RESYNC : end;
+        for (j = k; j < stop; j++) {
+            y[j] = y0;
+            y0 += d1;
+            d1 += d2;
+            d2 += d3;
+        }
+        k = stop;
+    }
+}
+
+static int
+intpl_rs_run_uni(const float *p, unsigned int stride, unsigned int n,
+    uint8_t mode, int fd, float x0, float dx, float y[], unsigned int m)
+{
+    int rc;
+    unsigned int k;
+    unsigned int i;
+    unsigned int end;
+    int last;
+    float xv;
+    float xhi;
+    struct intpl_rs_seg s;
+
+    INTPL_STATS_INC(batch);
+
+    rc = intpl_rs_check(p, stride, n, mode, y, m);
+    if (rc) {
+        return rc;
+    }
+    if (!(dx > 0.0f)) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    /* Values below the source range. */
+    k = 0;
+    while (k < m && !(x0 + (float)k * dx >= RS_X(0))) {
+        INTPL_STATS_INC(einval_range);
+        y[k++] = NAN;
+        rc = OS_EINVAL;
+    }
+
+    /* Each segment covers a run of consecutive destination values. */
+    for (i = 0; i < n - 1 && k < m; i++) {
+        /* The last segment includes its upper end. */
+        last = (i == n - 2);
+        xhi = RS_X(i+1);
+        xv = x0 + (float)k * dx;
+        if (!intpl_rs_in_seg(xv, xhi, last)) {
+            continue;
+        }
+        intpl_rs_coef(p, stride, n, mode, i, &s);
+        if (fd) {
+            end = intpl_rs_seg_end(x0, dx, k, m, xhi, last);
+            intpl_rs_fd(&s, x0, dx, k, end, y);
+            k = end;
+            continue;
+        }
+        do {
+            y[k] = intpl_rs_eval(&s, xv);
+            xv = x0 + (float)++k * dx;
+        } while (k < m && intpl_rs_in_seg(xv, xhi, last));
+    }
+
+    /* Values above the source range. */
+    while (k < m) {
+        INTPL_STATS_INC(einval_range);
+        y[k++] = NAN;
+        rc = OS_EINVAL;
+    }
+
+    return rc;
+err:
+    intpl_rs_nan(y, m);
+    return rc;
+}
+
+int
+intpl_resample(const struct intpl_xy src[], unsigned int n, uint8_t mode,
+    const float x[], float y[], unsigned int m)
+{
+    if (mode > INTPL_RS_MONO) {
+        intpl_rs_nan(y, m);
+        return OS_EINVAL;
+    }
+
+    return intpl_rs_run(&src[0].x, INTPL_PRIV_STRIDE(src), n, mode, x, y, m);
+}
+
+int
+intpl_resample_uni(const struct intpl_xy src[], unsigned int n,
+    uint8_t mode, float x0, float dx, float y[], unsigned int m)
+{
+    if (mode > INTPL_RS_MONO) {
+        intpl_rs_nan(y, m);
+        return OS_EINVAL;
+    }
+
+    return intpl_rs_run_uni(&src[0].x, INTPL_PRIV_STRIDE(src), n, mode, 0,
+        x0, dx, y, m);
+}
+
+int
+intpl_resample_cubic(const struct intpl_xyc src[], unsigned int n,
+    const float x[], float y[], unsigned int m)
+{
+    return intpl_rs_run(&src[0].x, INTPL_PRIV_STRIDE(src), n, INTPL_RS_CUBIC,
+        x, y, m);
+}
+
+int
+intpl_resample_cubic_uni(const struct intpl_xyc src[], unsigned int n,
+    float x0, float dx, float y[], unsigned int m)
+{
+    return intpl_rs_run_uni(&src[0].x, INTPL_PRIV_STRIDE(src), n,
+        INTPL_RS_CUBIC, 0, x0, dx, y, m);
+}
+
+int
+intpl_resample_cubic_fd(const struct intpl_xyc src[], unsigned int n,
+    float x0, float dx, float y[], unsigned int m)
+{
+    return intpl_rs_run_uni(&src[0].x, INTPL_PRIV_STRIDE(src), n,
+        INTPL_RS_CUBIC, 1, x0, dx, y, m);
+}
@@ -0,0 +1,281 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_ring.h"
+#include "interpolate_priv.h"
+
+/* Maximum number of segments the cursor walks forward before a lookup
+ * falls back to bisection. */
+#define INTPL_RING_WALK     (4)
+
+/* Sample i, in age order. */
+#define RING_AT(r, i)   (&(r)->buf[((r)->head + (i)) % (r)->cap])
+
+int
+intpl_ring_init(struct intpl_ring *ring, struct intpl_xy buf[],
+    unsigned int cap)
+{
+    if (buf == NULL || cap < 2) {
+        INTPL_STATS_INC(einval_size);
+        return OS_EINVAL;
+    }
+
+    ring->buf = buf;
+    ring->cap = cap;
+    ring->head = 0;
+    ring->cnt = 0;
+    ring->cur.idx = -1;
+
+    return 0;
+}
+
+int
+intpl_ring_pop(struct intpl_ring *ring)
+{
+    if (ring->cnt == 0) {
+        return OS_ENOENT;
+    }
+
+    ring->head = (ring->head + 1) % ring->cap;
+    ring->cnt--;
+
+    /* Keep the cursor on the same segment, which is now one sample younger
+     * in age order. */
+    if (ring->cur.idx > 0) {
+        ring->cur.idx--;
+    } else {
+        ring->cur.idx = -1;
+    }
+
+    return 0;
+}
+
+int
+intpl_ring_push(struct intpl_ring *ring, float x, float y)
+{
+    struct intpl_xy *xy;
+
+    /* Timestamps must be strictly ascending. */
+    if (!(ring->cnt == 0 || x > RING_AT(ring, ring->cnt - 1)->x)) {
+        INTPL_STATS_INC(einval_range);
+        return OS_EINVAL;
+    }
+
+    if (ring->cnt == ring->cap) {
+        intpl_ring_pop(ring);
+    }
+
+    xy = RING_AT(ring, ring->cnt);
+    xy->x = x;
+    xy->y = y;
+    ring->cnt++;
+
+    return 0;
+}
+
+unsigned int
+intpl_ring_evict(struct intpl_ring *ring, float x)
+{
+    unsigned int cnt;
+
+    cnt = 0;
+    while (ring->cnt > 0 && RING_AT(ring, 0)->x < x) {
+        intpl_ring_pop(ring);
+        cnt++;
+    }
+
+    return cnt;
+}
+
+const struct intpl_xy *
+intpl_ring_at(const struct intpl_ring *ring, unsigned int i)
+{
+    if (i >= ring->cnt) {
+        return NULL;
+    }
+
+    return RING_AT(ring, i);
+}
+
+/* Finds the segment i, in age order, where sample i <= x < sample i + 1,
+ * or the last segment if x is the newest timestamp. */
+static int
+intpl_ring_find(struct intpl_ring *ring, float x, unsigned int *idx)
+{
+    unsigned int lo;
+    unsigned int hi;
+    unsigned int mid;
+    unsigned int walk;
+
+    /* Make sure we have an appropriately large dataset. */
+    if (ring->cnt < 2) {
+        INTPL_STATS_INC(einval_size);
+        return OS_EINVAL;
+    }
+    if (!(x >= RING_AT(ring, 0)->x && x <= RING_AT(ring, ring->cnt - 1)->x)) {
+        INTPL_STATS_INC(einval_range);
+        return OS_EINVAL;
+    }
+
+    /* Walk forward from the cursor, as queries usually advance in time. */
+    lo = 0;
+    hi = ring->cnt - 1;
+    if (ring->cur.idx >= 0 && (unsigned int)ring->cur.idx < ring->cnt - 1 &&
+        RING_AT(ring, ring->cur.idx)->x <= x) {
+        lo = ring->cur.idx;
+        for (walk = 0; walk <= INTPL_RING_WALK; walk++) {
+            if (lo == ring->cnt - 2 || x < RING_AT(ring, lo + 1)->x) {
+                INTPL_STATS_INC(hint_hit);
+                *idx = lo;
+                ring->cur.idx = lo;
+                return 0;
+            }
+            lo++;
+        }
+    }
+
+    /* Bisection over the rest of the ring. */
+    INTPL_STATS_INC(hint_miss);
+    INTPL_STATS_INC(search);
+    while (hi - lo > 1) {
+        INTPL_STATS_INC(search_iter);
+        mid = (hi + lo) >> 1;
+        if (x >= RING_AT(ring, mid)->x) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *idx = lo;
+    ring->cur.idx = lo;
+
+    return 0;
+}
+
+int
+intpl_ring_nn(struct intpl_ring *ring, float x, float *y)
+{
+    int rc;
+    unsigned int i;
+    const struct intpl_xy *xy1;
+    const struct intpl_xy *xy3;
+
+    rc = intpl_ring_find(ring, x, &i);
+    if (rc) {
+        goto err;
+    }
+
+    /* Determine which sample is closest, rounding up on 0.5. */
+    xy1 = RING_AT(ring, i);
+    xy3 = RING_AT(ring, i + 1);
+    *y = fabsf(x - xy3->x) <= fabsf(x - xy1->x) ? xy3->y : xy1->y;
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+int
+intpl_ring_lin_y(struct intpl_ring *ring, float x, float *y)
+{
+    int rc;
+    unsigned int i;
+
+    rc = intpl_ring_find(ring, x, &i);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_lin_y(RING_AT(ring, i), RING_AT(ring, i + 1), x, y);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+/* Slope at sample i, from the parabola through samples i - 1..i + 1. */
+static float
+intpl_ring_slope(const struct intpl_ring *ring, unsigned int i)
+{
+    const struct intpl_xy *p0;
+    const struct intpl_xy *p1;
+    const struct intpl_xy *p2;
+    float h0;
+    float h1;
+
+    p1 = RING_AT(ring, i);
+    if (i == 0) {
+        p2 = RING_AT(ring, 1);
+        return (p2->y - p1->y) / (p2->x - p1->x);
+    }
+    p0 = RING_AT(ring, i - 1);
+    if (i == ring->cnt - 1) {
+        return (p1->y - p0->y) / (p1->x - p0->x);
+    }
+    p2 = RING_AT(ring, i + 1);
+
+    h0 = p1->x - p0->x;
+    h1 = p2->x - p1->x;
+
+    return ((p2->y - p1->y) / h1 * h0 + (p1->y - p0->y) / h0 * h1) /
+        (h0 + h1);
+}
+
+int
+intpl_ring_cubic(struct intpl_ring *ring, float x, float *y)
+{
+    int rc;
+    unsigned int i;
+    const struct intpl_xy *xy1;
+    const struct intpl_xy *xy3;
+    float h;
+    float t;
+    float m0;
+    float m1;
+
+    rc = intpl_ring_find(ring, x, &i);
+    if (rc) {
+        goto err;
+    }
+
+    xy1 = RING_AT(ring, i);
+    xy3 = RING_AT(ring, i + 1);
+    h = xy3->x - xy1->x;
+    t = (x - xy1->x) / h;
+    m0 = intpl_ring_slope(ring, i) * h;
+    m1 = intpl_ring_slope(ring, i + 1) * h;
+
+    /* Cubic Hermite basis functions. */
+    *y = (2.0f * t * t * t - 3.0f * t * t + 1.0f) * xy1->y +
+        (t * t * t - 2.0f * t * t + t) * m0 +
+        (-2.0f * t * t * t + 3.0f * t * t) * xy3->y +
+        (t * t * t - t * t) * m1;
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
@@ -0,0 +1,484 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_spline.h"
+#include "interpolate_priv.h"
+
+/*
+ * With h = x1 - x0, A = (x1 - x) / h and B = (x - x0) / h, the spline on a
+ * segment is (see intpl_priv_cubic_seg):
+ *
+ *     y = A * y0 + B * y1 + ((A^3 - A) * y2_0 + (B^3 - B) * y2_1) * h^2 / 6
+ *
+ * which gives:
+ *
+ *     dy/dx   = (y1 - y0) / h - (3A^2 - 1) * h * y2_0 / 6
+ *                             + (3B^2 - 1) * h * y2_1 / 6
+ *     d2y/dx2 = A * y2_0 + B * y2_1
+ *
+ *     integral from x0 to x = h * (y0 * (B - B^2 / 2) + y1 * B^2 / 2
+ *         + (y2_1 * (B^4 - 2B^2) - y2_0 * (A^2 - 1)^2) * h^2 / 24)
+ */
+
+/* Finds the segment for x, checking the size of the table. */
+static int
+intpl_spline_find(const struct intpl_xyc xyc[], unsigned int n, float x,
+    struct intpl_cursor *cur, int *idx)
+{
+    /* Make sure we have at least three values. */
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        return OS_EINVAL;
+    }
+
+    if (cur != NULL) {
+        return intpl_priv_find_cur(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n, x,
+            cur, idx);
+    }
+
+    return intpl_priv_find(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n, x, idx);
+}
+
+/* Evaluates d1 (order 1) or d2 (order 2) on the segment starting at lo. */
+static int
+intpl_spline_deriv(const struct intpl_xyc *lo, float x, int order, float *d)
+{
+    const struct intpl_xyc *hi;
+    float h;
+    float a;
+    float b;
+
+    hi = lo + 1;
+    h = hi->x - lo->x;
+    if (h == 0) {
+        INTPL_STATS_INC(einval_delta);
+        return OS_EINVAL;
+    }
+
+    a = (hi->x - x) / h;
+    b = (x - lo->x) / h;
+
+    if (order == 1) {
+        *d = (hi->y - lo->y) / h -
+            ((3.0f * a * a - 1.0f) * lo->y2 -
+             (3.0f * b * b - 1.0f) * hi->y2) * h / 6.0f;
+    } else {
+        *d = a * lo->y2 + b * hi->y2;
+    }
+
+    return 0;
+}
+
+/* Integral from lo->x to x, on the segment starting at lo. */
+static float
+intpl_spline_part(const struct intpl_xyc *lo, float x)
+{
+    const struct intpl_xyc *hi;
+    float h;
+    float a;
+    float b;
+    float a2m1;
+
+    hi = lo + 1;
+    h = hi->x - lo->x;
+    a = (hi->x - x) / h;
+    b = (x - lo->x) / h;
+    a2m1 = a * a - 1.0f;
+
+    return h * (lo->y * (b - 0.5f * b * b) + hi->y * 0.5f * b * b +
+        (hi->y2 * (b * b * b * b - 2.0f * b * b) - lo->y2 * a2m1 * a2m1) *
+        h * h / 24.0f);
+}
+
+static int
+intpl_spline_deriv_arr(const struct intpl_xyc xyc[], unsigned int n,
+    float x, int order, float *d)
+{
+    int rc;
+    int idx;
+
+    rc = intpl_spline_find(xyc, n, x, NULL, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_spline_deriv(&xyc[idx], x, order, d);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *d = NAN;
+    return rc;
+}
+
+static int
+intpl_spline_deriv_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float x[], int order, float d[], unsigned int cnt,
+    struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_spline_find(xyc, n, x[i], cur, &idx);
+        if (rc == 0) {
+            rc = intpl_spline_deriv(&xyc[idx], x[i], order, &d[i]);
+        }
+        if (rc) {
+            d[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_cubic_d1(const struct intpl_xyc xyc[], unsigned int n, float x,
+    float *dy)
+{
+    return intpl_spline_deriv_arr(xyc, n, x, 1, dy);
+}
+
+int
+intpl_cubic_d2(const struct intpl_xyc xyc[], unsigned int n, float x,
+    float *d2y)
+{
+    return intpl_spline_deriv_arr(xyc, n, x, 2, d2y);
+}
+
+int
+intpl_cubic_d1_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float x[], float dy[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    return intpl_spline_deriv_batch(xyc, n, x, 1, dy, cnt, cur);
+}
+
+int
+intpl_cubic_d2_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float x[], float d2y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    return intpl_spline_deriv_batch(xyc, n, x, 2, d2y, cnt, cur);
+}
+
+int
+intpl_cubic_cum(const struct intpl_xyc xyc[], unsigned int n, float cum[])
+{
+    int rc;
+    unsigned int i;
+    double sum;
+    float h;
+
+    /* Make sure we have at least three values. */
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    sum = 0.0;
+    cum[0] = 0.0f;
+    for (i = 0; i < n - 1; i++) {
+        h = xyc[i+1].x - xyc[i].x;
+        if (h == 0) {
+            INTPL_STATS_INC(einval_delta);
+            rc = OS_EINVAL;
+            goto err;
+        }
+        /* Full segment: h * (y0 + y1) / 2 - h^3 * (y2_0 + y2_1) / 24. */
+        sum += (double)h * (xyc[i].y + xyc[i+1].y) * 0.5 -
+            (double)h * h * h * (xyc[i].y2 + xyc[i+1].y2) / 24.0;
+        cum[i+1] = (float)sum;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_cubic_integral(const struct intpl_xyc xyc[], unsigned int n,
+    const float cum[], float a, float b, float *res)
+{
+    int rc;
+    int ia;
+    int ib;
+
+    rc = intpl_spline_find(xyc, n, a, NULL, &ia);
+    if (rc) {
+        goto err;
+    }
+    rc = intpl_spline_find(xyc, n, b, NULL, &ib);
+    if (rc) {
+        goto err;
+    }
+
+    *res = (cum[ib] - cum[ia]) +
+        (intpl_spline_part(&xyc[ib], b) - intpl_spline_part(&xyc[ia], a));
+
+    return 0;
+err:
+    *res = NAN;
+    return rc;
+}
+
+int
+intpl_cubic_integral_batch(const struct intpl_xyc xyc[], unsigned int n,
+    const float cum[], const float a[], const float b[], float res[],
+    unsigned int cnt)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+
+    INTPL_STATS_INC(batch);
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_cubic_integral(xyc, n, cum, a[i], b[i], &res[i]);
+        if (rc) {
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
+
+int
+intpl_cubic_calc_periodic(struct intpl_xyc xyc[], unsigned int n,
+    float period)
+{
+    int rc;
+    unsigned int i;
+    float *gam;
+    float *z;
+    float h0;
+    float h1;
+    float r;
+    float bet;
+    float gamma;
+    float corner;
+    float fact;
+
+    INTPL_STATS_INC(cubic_calc);
+
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (!(period > xyc[n - 1].x - xyc[0].x)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    for (i = 1; i < n; i++) {
+        if (!(xyc[i].x > xyc[i - 1].x)) {
+            INTPL_STATS_INC(einval_delta);
+            rc = OS_EINVAL;
+            goto err;
+        }
+    }
+
+    gam = os_malloc(2 * n * sizeof(float));
+    if (gam == NULL) {
+        INTPL_STATS_INC(enomem);
+        rc = OS_ENOMEM;
+        goto err;
+    }
+    z = gam + n;
+
+/* Segment width, with segment n - 1 wrapping around to xyc[0]. */
+#define H(i)    (((i) < n - 1) ? xyc[(i) + 1].x - xyc[(i)].x : \
+                 xyc[0].x + period - xyc[n - 1].x)
+/* Y value of knot i + 1, wrapping around. */
+#define Y1(i)   (((i) < n - 1) ? xyc[(i) + 1].y : xyc[0].y)
+
+    /*
+     * Row i of the system is
+     *
+     *     h[i-1] * M[i-1] + 2 (h[i-1] + h[i]) * M[i] + h[i] * M[i+1] = r[i]
+     *
+     * with indices taken modulo n, so the matrix is tridiagonal apart from
+     * h[n-1] in its two corners. Sherman-Morrison splits that off as a
+     * rank one update: A = T + u v', with u = (gamma, 0, ..., corner) and
+     * v = (1, 0, ..., corner / gamma). T is solved for r and for u with
+     * one forward sweep, and the two are combined at the end.
+     */
+    corner = H(n - 1);
+    gamma = -2.0f * (corner + H(0));
+    bet = 0.0f;
+    for (i = 0; i < n; i++) {
+        h0 = H((i + n - 1) % n);
+        h1 = H(i);
+        r = 6.0f * ((Y1(i) - xyc[i].y) / h1 -
+            (xyc[i].y - xyc[(i + n - 1) % n].y) / h0);
+
+        if (i == 0) {
+            /* Diagonal less gamma, sub-diagonal in the corner. */
+            bet = 2.0f * (h0 + h1) - gamma;
+            xyc[0].y2 = r / bet;
+            z[0] = gamma / bet;
+            continue;
+        }
+
+        gam[i] = H(i - 1) / bet;
+        bet = 2.0f * (h0 + h1) - h0 * gam[i];
+        if (i == n - 1) {
+            bet -= corner * corner / gamma;
+        }
+        xyc[i].y2 = (r - h0 * xyc[i - 1].y2) / bet;
+        z[i] = (((i == n - 1) ? corner : 0.0f) - h0 * z[i - 1]) / bet;
+    }
+    for (i = n - 1; i-- > 0; ) {
+        xyc[i].y2 -= gam[i + 1] * xyc[i + 1].y2;
+        z[i] -= gam[i + 1] * z[i + 1];
+    }
+
+    fact = (xyc[0].y2 + corner * xyc[n - 1].y2 / gamma) /
+        (1.0f + z[0] + corner * z[n - 1] / gamma);
+    for (i = 0; i < n; i++) {
+        xyc[i].y2 -= fact * z[i];
+    }
+
+#undef H
+#undef Y1
+
+    os_free(gam);
+
+    return 0;
+err:
+    return rc;
+}
+
+/*
+ * Evaluates a periodic spline, wrapping x into the period first. The last
+ * segment is evaluated from a copy of its ends, one period apart.
+ */
+static int
+intpl_spline_periodic(const struct intpl_xyc xyc[], unsigned int n,
+    float period, float x, struct intpl_cursor *cur, float *y)
+{
+    int rc;
+    int idx;
+    float r;
+    struct intpl_xyc wrap[2];
+
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (!(period > 0.0f) || !isfinite(x)) {
+        INTPL_STATS_INC(einval_range);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    r = fmodf(x - xyc[0].x, period);
+    if (r < 0.0f) {
+        r += period;
+    }
+    /* r + period can round up to period itself. */
+    if (r >= period) {
+        r = 0.0f;
+    }
+    x = xyc[0].x + r;
+
+    if (x <= xyc[n - 1].x) {
+        if (cur != NULL) {
+            rc = intpl_priv_find_cur(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n, x,
+                cur, &idx);
+        } else {
+            rc = intpl_priv_find(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n, x,
+                &idx);
+        }
+        if (rc) {
+            goto err;
+        }
+        rc = intpl_priv_cubic_seg(&xyc[idx], x, y);
+    } else {
+        wrap[0] = xyc[n - 1];
+        wrap[1] = xyc[0];
+        wrap[1].x += period;
+        rc = intpl_priv_cubic_seg(wrap, x, y);
+    }
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+int
+intpl_cubic_periodic(const struct intpl_xyc xyc[], unsigned int n,
+    float period, float x, float *y)
+{
+    return intpl_spline_periodic(xyc, n, period, x, NULL, y);
+}
+
+int
+intpl_cubic_periodic_batch(const struct intpl_xyc xyc[], unsigned int n,
+    float period, const float x[], float y[], unsigned int cnt,
+    struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_spline_periodic(xyc, n, period, x[i], cur, &y[i]);
+        if (rc) {
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
@@ -0,0 +1,416 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "interpolate/interpolate_srch.h"
+#include "interpolate_priv.h"
+
+size_t
+intpl_bkt_size(unsigned int nb)
+{
+    return ((size_t)nb + 1) * sizeof(uint32_t);
+}
+
+static int
+intpl_bkt_init(struct intpl_bkt *bkt, void *buf, size_t len, const float *x,
+    unsigned int stride, unsigned int n, unsigned int nb)
+{
+    int rc;
+    int order;
+    unsigned int b;
+    unsigned int seg;
+    float x0;
+    float xn;
+    float edge;
+    uint32_t *first;
+
+    /* Make sure we have an appropriately large dataset and buffer. */
+    if (n < 2 || nb < 1) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+    if (buf == NULL || len < intpl_bkt_size(nb) ||
+        ((uintptr_t)buf & (sizeof(uint32_t) - 1)) != 0) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    x0 = x[0];
+    xn = x[(n-1)*stride];
+    if (xn == x0) {
+        INTPL_STATS_INC(einval_delta);
+        rc = OS_EINVAL;
+        goto err;
+    }
+    order = (xn >= x0);
+
+    bkt->x0 = x0;
+    bkt->scale = (float)nb / (xn - x0);
+    bkt->n = n;
+    bkt->nb = nb;
+    bkt->first = first = (uint32_t *)buf;
+
+    /* Record the segment holding the lower edge of each bucket. The edges
+     * are ascending in the table's order, so a single pass is enough. */
+    seg = 0;
+    for (b = 0; b <= nb; b++) {
+        edge = x0 + (float)b / bkt->scale;
+        while (seg < n - 2 &&
+               ((x[(seg+1)*stride] <= edge && order) ||
+                (x[(seg+1)*stride] >= edge && !order))) {
+            seg++;
+        }
+        first[b] = seg;
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_bkt_init_xy(struct intpl_bkt *bkt, void *buf, size_t len,
+    const struct intpl_xy xy[], unsigned int n, unsigned int nb)
+{
+    return intpl_bkt_init(bkt, buf, len, &xy[0].x, INTPL_PRIV_STRIDE(xy), n,
+        nb);
+}
+
+int
+intpl_bkt_init_xyc(struct intpl_bkt *bkt, void *buf, size_t len,
+    const struct intpl_xyc xyc[], unsigned int n, unsigned int nb)
+{
+    return intpl_bkt_init(bkt, buf, len, &xyc[0].x, INTPL_PRIV_STRIDE(xyc), n,
+        nb);
+}
+
+int
+intpl_priv_find_bkt(const float *x, unsigned int stride, unsigned int n,
+    float xv, const struct intpl_bkt *bkt, int *idx)
+{
+    int order;
+    unsigned int b;
+    unsigned int lo;        /* Lower limit, x[lo] <= xv */
+    unsigned int hi;        /* Upper limit, xv < x[hi] */
+    unsigned int mid;
+    float x0;
+    float xn;
+
+    /* The index must have been built for a table of this size. */
+    if (bkt->n != n) {
+        INTPL_STATS_INC(einval_size);
+        *idx = -1;
+        return OS_EINVAL;
+    }
+
+    /* Let the bisection search handle all of the edge cases. */
+    x0 = x[0];
+    xn = x[(n-1)*stride];
+    order = (xn >= x0);
+    if (n < 3 || (xv >= xn && order) || (xv <= xn && !order) ||
+        (xv <= x0 && order) || (xv >= x0 && !order) || xv != xv) {
+        return intpl_priv_find(x, stride, n, xv, idx);
+    }
+
+    INTPL_STATS_INC(search);
+
+    b = (unsigned int)((xv - bkt->x0) * bkt->scale);
+    if (b >= bkt->nb) {
+        b = bkt->nb - 1;
+    }
+    lo = bkt->first[b];
+    hi = bkt->first[b+1] + 1;
+
+    /* Rounding in the bucket calculation can place xv just outside of the
+     * bucket, in which case the bracket is widened to the whole array. So
+     * is a bracket outside of the table, from an index read from a blob. */
+    if (lo > n - 2 ||
+        (xv < x[lo*stride] && order) || (xv > x[lo*stride] && !order)) {
+        lo = 0;
+    }
+    if (hi > n - 1 || hi <= lo ||
+        (xv >= x[hi*stride] && order) || (xv <= x[hi*stride] && !order)) {
+        hi = n - 1;
+    }
+
+    /* Bisection within the bucket. */
+    while (hi - lo > 1) {
+        INTPL_STATS_INC(search_iter);
+        mid = (hi + lo) >> 1;
+        if ((xv >= x[mid*stride] && order) || (xv <= x[mid*stride] && !order)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *idx = lo;
+
+    return 0;
+}
+
+int
+intpl_srch_init(struct intpl_srch *srch, uint8_t kind,
+    const struct intpl_bkt *bkt)
+{
+    if (kind > INTPL_SRCH_AUTO || (kind == INTPL_SRCH_BUCKET && !bkt)) {
+        return OS_EINVAL;
+    }
+
+    memset(srch, 0, sizeof(*srch));
+    srch->kind = kind;
+    srch->cur.idx = -1;
+    srch->bkt = bkt;
+    /* Auto mode starts out on the cursor, which falls back to bisection. */
+    srch->active = kind == INTPL_SRCH_AUTO ? INTPL_SRCH_CURSOR : kind;
+
+    return 0;
+}
+
+int
+intpl_srch_diag(const struct intpl_srch *srch, struct intpl_srch_diag *diag)
+{
+    memset(diag, 0, sizeof(*diag));
+    diag->kind = srch->kind;
+    diag->active = srch->active;
+    if (srch->kind == INTPL_SRCH_AUTO) {
+        diag->hit_pct = srch->prof.hit_pct;
+        diag->near_pct = srch->prof.near_pct;
+        diag->sorted_pct = srch->prof.sorted_pct;
+        diag->guess_pct = srch->prof.guess_pct;
+        diag->queries = srch->prof.queries;
+        diag->switches = srch->prof.switches;
+    }
+
+    return 0;
+}
+
+/* Locates xv with a single, fixed strategy. */
+static int
+intpl_srch_find(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_srch *srch, uint8_t kind, int *idx)
+{
+    int rc;
+
+    switch (kind) {
+    case INTPL_SRCH_BISECT:
+        rc = intpl_priv_find(x, stride, n, xv, idx);
+        break;
+    case INTPL_SRCH_CURSOR:
+        return intpl_priv_find_cur(x, stride, n, xv, &srch->cur, idx);
+    case INTPL_SRCH_GUESS:
+        rc = intpl_priv_find_guess(x, stride, n, xv, idx);
+        break;
+    case INTPL_SRCH_BUCKET:
+        if (srch->bkt == NULL) {
+            *idx = -1;
+            return OS_EINVAL;
+        }
+        rc = intpl_priv_find_bkt(x, stride, n, xv, srch->bkt, idx);
+        break;
+    case INTPL_SRCH_GALLOP:
+        if (srch->cur.idx < 0) {
+            rc = intpl_priv_find_guess(x, stride, n, xv, idx);
+        } else {
+            rc = intpl_priv_find_gallop(x, stride, n, xv, srch->cur.idx, idx);
+        }
+        break;
+    default:
+        *idx = -1;
+        return OS_EINVAL;
+    }
+
+    if (rc == 0) {
+        srch->cur.idx = *idx;
+    }
+
+    return rc;
+}
+
+/* Picks the strategy for the next window from the profile of the last one,
+ * see the SRCH group description. */
+static uint8_t
+intpl_srch_pick(const struct intpl_srch *srch)
+{
+    const struct intpl_srch_prof *p;
+
+    p = &srch->prof;
+    if (p->hit * 4 >= p->nq * 3) {
+        return INTPL_SRCH_CURSOR;
+    }
+    if (p->near * 4 >= p->nq * 3 || p->sorted * 8 >= p->nq * 7) {
+        return INTPL_SRCH_GALLOP;
+    }
+    if (srch->bkt != NULL) {
+        return INTPL_SRCH_BUCKET;
+    }
+    if (p->guess * 4 >= p->nq * 3) {
+        return INTPL_SRCH_GUESS;
+    }
+
+    return INTPL_SRCH_BISECT;
+}
+
+/* Adds a successful lookup of segment idx to the profile. */
+static void
+intpl_srch_profile(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_srch *srch, int last, int idx)
+{
+    struct intpl_srch_prof *p;
+    uint8_t next;
+    int d;
+
+    p = &srch->prof;
+    p->queries++;
+    p->nq++;
+    if (last >= 0) {
+        d = idx - last;
+        p->hit += (d == 0 || d == 1);
+        p->near += (d >= -INTPL_SRCH_NEAR && d <= INTPL_SRCH_NEAR);
+        p->sorted += (d >= 0);
+    }
+    d = idx - (int)intpl_priv_guess(x, stride, n, xv);
+    p->guess += (d >= -INTPL_SRCH_NEAR && d <= INTPL_SRCH_NEAR);
+
+    if (p->nq < INTPL_SRCH_WINDOW) {
+        return;
+    }
+
+    next = intpl_srch_pick(srch);
+    if (next != srch->active) {
+        srch->active = next;
+        p->switches++;
+    }
+    p->hit_pct = (uint8_t)(p->hit * 100 / p->nq);
+    p->near_pct = (uint8_t)(p->near * 100 / p->nq);
+    p->sorted_pct = (uint8_t)(p->sorted * 100 / p->nq);
+    p->guess_pct = (uint8_t)(p->guess * 100 / p->nq);
+    p->nq = p->hit = p->near = p->sorted = p->guess = 0;
+}
+
+int
+intpl_priv_find_srch(const float *x, unsigned int stride, unsigned int n,
+    float xv, struct intpl_srch *srch, int *idx)
+{
+    int rc;
+    int last;
+
+    if (srch->kind != INTPL_SRCH_AUTO) {
+        return intpl_srch_find(x, stride, n, xv, srch, srch->kind, idx);
+    }
+
+    last = srch->cur.idx;
+    rc = intpl_srch_find(x, stride, n, xv, srch, srch->active, idx);
+    if (rc == 0) {
+        intpl_srch_profile(x, stride, n, xv, srch, last, *idx);
+    }
+
+    return rc;
+}
+
+int
+intpl_find_x_srch(struct intpl_xy xy[], unsigned int n, float x,
+    struct intpl_srch *srch, int *idx)
+{
+    INTPL_STATS_INC(find_x);
+
+    return intpl_priv_find_srch(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, srch,
+        idx);
+}
+
+int
+intpl_nn_srch(struct intpl_xy xy[], unsigned int n, float x, float *y,
+    struct intpl_srch *srch)
+{
+    int rc;
+    int idx;
+
+    rc = intpl_priv_find_srch(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, srch,
+        &idx);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_nn(&xy[idx], &xy[idx+1], x, y);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+int
+intpl_lin_y_srch(struct intpl_xy xy[], unsigned int n, float x, float *y,
+    struct intpl_srch *srch)
+{
+    int rc;
+    int idx;
+
+    rc = intpl_priv_find_srch(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, x, srch,
+        &idx);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_lin_y(&xy[idx], &xy[idx+1], x, y);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
+
+int
+intpl_cubic_srch(struct intpl_xyc xyc[], unsigned int n, float x,
+    float *y, struct intpl_srch *srch)
+{
+    int rc;
+    int idx;
+
+    /* Make sure we have at least three values. */
+    if (n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    rc = intpl_priv_find_srch(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), n, x, srch,
+        &idx);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_priv_cubic_seg(&xyc[idx], x, y);
+    if (rc) {
+        goto err;
+    }
+
+    return 0;
+err:
+    *y = NAN;
+    return rc;
+}
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include "interpolate/interpolate_stats.h"
+#include "interpolate_priv.h"
+
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+
+STATS_SECT_DECL(intpl_stats) g_intpl_stats;
+
+STATS_NAME_START(intpl_stats)
+    STATS_NAME(intpl_stats, lerp)
+    STATS_NAME(intpl_stats, find_x)
+    STATS_NAME(intpl_stats, nn)
+    STATS_NAME(intpl_stats, nn_arr)
+    STATS_NAME(intpl_stats, lin_y)
+    STATS_NAME(intpl_stats, lin_y_arr)
+    STATS_NAME(intpl_stats, lin_x)
+    STATS_NAME(intpl_stats, cubic_calc)
+    STATS_NAME(intpl_stats, cubic_arr)
+    STATS_NAME(intpl_stats, batch)
+    STATS_NAME(intpl_stats, search)
+    STATS_NAME(intpl_stats, search_iter)
+    STATS_NAME(intpl_stats, hint_hit)
+    STATS_NAME(intpl_stats, hint_miss)
+    STATS_NAME(intpl_stats, einval_size)
+    STATS_NAME(intpl_stats, einval_range)
+    STATS_NAME(intpl_stats, einval_delta)
+    STATS_NAME(intpl_stats, enomem)
+    STATS_NAME(intpl_stats, cache_hit)
+    STATS_NAME(intpl_stats, cache_miss)
+    STATS_NAME(intpl_stats, cache_evict)
+    STATS_NAME(intpl_stats, cubic_calc_usecs)
+STATS_NAME_END(intpl_stats)
+
+static int
+intpl_stats_print(struct stats_hdr *hdr, void *arg, char *name,
+    uint16_t stat_off)
+{
+    (void)arg;
+
+    printf("%s: %lu\n", name,
+        (unsigned long)*(uint32_t *)((uint8_t *)hdr + stat_off));
+
+    return 0;
+}
+
+#endif
+
+void
+intpl_stats_init(void)
+{
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+    int rc;
+
+    rc = stats_init_and_reg(STATS_HDR(g_intpl_stats),
+        STATS_SIZE_INIT_PARMS(g_intpl_stats, STATS_SIZE_32),
+        STATS_NAME_INIT_PARMS(intpl_stats), "intpl");
+    SYSINIT_PANIC_ASSERT(rc == 0);
+#endif
+}
+
+int
+intpl_stats_reset(void)
+{
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+    stats_reset(STATS_HDR(g_intpl_stats));
+#endif
+
+    return 0;
+}
+
+int
+intpl_stats_dump(void)
+{
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+    return stats_walk(STATS_HDR(g_intpl_stats), intpl_stats_print, NULL);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,280 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_svc.h"
+#include "interpolate_priv.h"
+
+#define SVC_DONE_SET(r)     __atomic_store_n(&(r)->done, 1, __ATOMIC_RELEASE)
+#define SVC_DONE_GET(r)     __atomic_load_n(&(r)->done, __ATOMIC_ACQUIRE)
+
+static int
+intpl_svc_eval(uint8_t kind, void *tbl, unsigned int n, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    switch (kind) {
+    case INTPL_SVC_NN:
+        return intpl_nn_batch(tbl, n, x, y, cnt, cur);
+    case INTPL_SVC_LIN_Y:
+        return intpl_lin_y_batch(tbl, n, x, y, cnt, cur);
+    default:
+        return intpl_cubic_batch(tbl, n, x, y, cnt, cur);
+    }
+}
+
+/**
+ * Completes a list of requests, one batch per table at a time. Requests
+ * for the same table are taken in groups of up to INTERPOLATE_SVC_BATCH
+ * and sorted by X, so the batch functions' cursor only has to walk forward.
+ */
+static void
+intpl_svc_run(struct intpl_svc *svc, struct intpl_svc_req *list)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    unsigned int cnt;
+    struct intpl_svc_req *first;
+    struct intpl_svc_req *r;
+    struct intpl_svc_req **pp;
+    struct intpl_cursor cur;
+
+    while (list != NULL) {
+        first = list;
+        cnt = 0;
+        pp = &list;
+        while (*pp != NULL && cnt < MYNEWT_VAL(INTERPOLATE_SVC_BATCH)) {
+            r = *pp;
+            if (r->tbl == first->tbl && r->kind == first->kind &&
+                r->n == first->n)
+            {
+                *pp = r->next;
+                svc->batch[cnt++] = r;
+            } else {
+                pp = &r->next;
+            }
+        }
+
+        /* Insertion sort, batches are small and often nearly sorted. */
+        for (i = 1; i < cnt; i++) {
+            r = svc->batch[i];
+            for (j = i; j > 0 && svc->batch[j - 1]->x > r->x; j--) {
+                svc->batch[j] = svc->batch[j - 1];
+            }
+            svc->batch[j] = r;
+        }
+        for (i = 0; i < cnt; i++) {
+            svc->x[i] = svc->batch[i]->x;
+        }
+
+        cur.idx = -1;
+        rc = intpl_svc_eval(first->kind, first->tbl, first->n, svc->x,
+            svc->y, cnt, &cur);
+        svc->batches++;
+
+        for (i = 0; i < cnt; i++) {
+            r = svc->batch[i];
+            r->y = svc->y[i];
+            r->rc = 0;
+            if (rc && isnan(r->y)) {
+                /* The batch only reports its first error, get this one. */
+                r->rc = intpl_svc_eval(r->kind, r->tbl, r->n, &r->x, &r->y,
+                    1, NULL);
+            }
+            svc->reqs++;
+            if (r->cb != NULL) {
+                r->cb(r);
+            }
+            SVC_DONE_SET(r);
+        }
+    }
+}
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+
+static void *
+intpl_svc_main(void *arg)
+{
+    struct intpl_svc *svc;
+    struct intpl_svc_req *list;
+
+    svc = (struct intpl_svc *)arg;
+
+    pthread_mutex_lock(&svc->lock);
+    for (;;) {
+        while (svc->pending == NULL && !svc->stop) {
+            pthread_cond_wait(&svc->work, &svc->lock);
+        }
+        if (svc->pending == NULL) {
+            /* Stopped, with nothing left to do. */
+            break;
+        }
+        list = svc->pending;
+        svc->pending = NULL;
+        pthread_mutex_unlock(&svc->lock);
+
+        intpl_svc_run(svc, list);
+
+        pthread_mutex_lock(&svc->lock);
+        pthread_cond_broadcast(&svc->done);
+    }
+    pthread_mutex_unlock(&svc->lock);
+
+    return NULL;
+}
+
+#else
+
+static void
+intpl_svc_event(struct os_event *ev)
+{
+    os_sr_t sr;
+    struct intpl_svc *svc;
+    struct intpl_svc_req *list;
+
+    svc = (struct intpl_svc *)ev->ev_arg;
+
+    OS_ENTER_CRITICAL(sr);
+    list = svc->pending;
+    svc->pending = NULL;
+    OS_EXIT_CRITICAL(sr);
+
+    intpl_svc_run(svc, list);
+}
+
+#endif
+
+int
+intpl_svc_init(struct intpl_svc *svc, struct os_eventq *evq)
+{
+    int rc;
+
+    svc->pending = NULL;
+    svc->reqs = 0;
+    svc->batches = 0;
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    (void)evq;
+    pthread_mutex_init(&svc->lock, NULL);
+    pthread_cond_init(&svc->work, NULL);
+    pthread_cond_init(&svc->done, NULL);
+    svc->stop = 0;
+    if (pthread_create(&svc->thread, NULL, intpl_svc_main, svc)) {
+        pthread_cond_destroy(&svc->done);
+        pthread_cond_destroy(&svc->work);
+        pthread_mutex_destroy(&svc->lock);
+        INTPL_STATS_INC(enomem);
+        rc = OS_ENOMEM;
+        goto err;
+    }
+#else
+    if (evq == NULL) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+    svc->evq = evq;
+    svc->ev = (struct os_event) {
+        .ev_cb = intpl_svc_event,
+        .ev_arg = svc,
+    };
+#endif
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_svc_deinit(struct intpl_svc *svc)
+{
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    pthread_mutex_lock(&svc->lock);
+    svc->stop = 1;
+    pthread_cond_signal(&svc->work);
+    pthread_mutex_unlock(&svc->lock);
+
+    pthread_join(svc->thread, NULL);
+
+    pthread_cond_destroy(&svc->done);
+    pthread_cond_destroy(&svc->work);
+    pthread_mutex_destroy(&svc->lock);
+#else
+    os_eventq_remove(svc->evq, &svc->ev);
+#endif
+
+    return 0;
+}
+
+int
+intpl_svc_submit(struct intpl_svc *svc, struct intpl_svc_req *req)
+{
+    int rc;
+#if !MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    os_sr_t sr;
+#endif
+
+    if (req->kind > INTPL_SVC_CUBIC || req->tbl == NULL) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    req->y = NAN;
+    req->rc = 0;
+    req->done = 0;
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    pthread_mutex_lock(&svc->lock);
+    req->next = svc->pending;
+    svc->pending = req;
+    pthread_cond_signal(&svc->work);
+    pthread_mutex_unlock(&svc->lock);
+#else
+    OS_ENTER_CRITICAL(sr);
+    req->next = svc->pending;
+    svc->pending = req;
+    OS_EXIT_CRITICAL(sr);
+
+    /* Does nothing if the event is already queued. */
+    os_eventq_put(svc->evq, &svc->ev);
+#endif
+
+    return 0;
+err:
+    return rc;
+}
+
+int
+intpl_svc_done(const struct intpl_svc_req *req)
+{
+    return SVC_DONE_GET(req);
+}
+
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+int
+intpl_svc_wait(struct intpl_svc *svc, struct intpl_svc_req *req)
+{
+    pthread_mutex_lock(&svc->lock);
+    while (!SVC_DONE_GET(req)) {
+        pthread_cond_wait(&svc->done, &svc->lock);
+    }
+    pthread_mutex_unlock(&svc->lock);
+
+    return req->rc;
+}
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include "interpolate/interpolate_swap.h"
+#include "interpolate_priv.h"
+
+#define SWAP_LOAD(p)        __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define SWAP_STORE(p, v)    __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define SWAP_INC(p)         __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define SWAP_DEC(p)         __atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST)
+
+int
+intpl_swap_init(struct intpl_swap *sw, uint8_t kind, void *buf0,
+    void *buf1, unsigned int cap)
+{
+    if (kind > INTPL_SWAP_XYC || buf0 == NULL || buf1 == NULL ||
+        buf0 == buf1 || cap < 2) {
+        return OS_EINVAL;
+    }
+
+    sw->buf[0] = buf0;
+    sw->buf[1] = buf1;
+    sw->n[0] = sw->n[1] = 0;
+    sw->readers[0] = sw->readers[1] = 0;
+    sw->gen[0] = sw->gen[1] = 0;
+    sw->front = 0;
+    sw->cap = cap;
+    sw->kind = kind;
+
+    return 0;
+}
+
+int
+intpl_swap_begin(struct intpl_swap *sw, void **tbl)
+{
+    uint32_t back;
+
+    /* Only the writer changes front, so it can not move under us. */
+    back = 1 - SWAP_LOAD(&sw->front);
+
+    /* Readers that pinned the back buffer before it was retired must be
+     * done with it. Readers pinning it from now on see that it is not
+     * published and back off, without reading it. */
+    if (SWAP_LOAD(&sw->readers[back]) != 0) {
+        *tbl = NULL;
+        return OS_EBUSY;
+    }
+
+    *tbl = sw->buf[back];
+
+    return 0;
+}
+
+int
+intpl_swap_publish(struct intpl_swap *sw, unsigned int n)
+{
+    uint32_t front;
+    uint32_t back;
+
+    if (n > sw->cap) {
+        return OS_EINVAL;
+    }
+
+    front = SWAP_LOAD(&sw->front);
+    back = 1 - front;
+    sw->n[back] = n;
+    sw->gen[back] = sw->gen[front] + 1;
+
+    /* Everything written to the buffer is visible before it is published. */
+    SWAP_STORE(&sw->front, back);
+
+    return 0;
+}
+
+void
+intpl_swap_acquire(struct intpl_swap *sw, struct intpl_swap_ref *ref)
+{
+    uint32_t slot;
+
+    for (;;) {
+        slot = SWAP_LOAD(&sw->front);
+        SWAP_INC(&sw->readers[slot]);
+        /* If the buffer is still published, the writer can not take it
+         * until we release it. */
+        if (SWAP_LOAD(&sw->front) == slot) {
+            break;
+        }
+        SWAP_DEC(&sw->readers[slot]);
+    }
+
+    ref->tbl = sw->buf[slot];
+    ref->n = sw->n[slot];
+    ref->gen = sw->gen[slot];
+    ref->slot = slot;
+}
+
+void
+intpl_swap_release(struct intpl_swap *sw, struct intpl_swap_ref *ref)
+{
+    SWAP_DEC(&sw->readers[ref->slot]);
+    ref->tbl = NULL;
+}
+
+int
+intpl_swap_lin_y(struct intpl_swap *sw, float x, float *y)
+{
+    int rc;
+    struct intpl_swap_ref ref;
+
+    if (sw->kind != INTPL_SWAP_XY) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    intpl_swap_acquire(sw, &ref);
+    rc = intpl_lin_y_arr((struct intpl_xy *)ref.tbl, ref.n, x, y);
+    intpl_swap_release(sw, &ref);
+
+    return rc;
+}
+
+int
+intpl_swap_nn(struct intpl_swap *sw, float x, float *y)
+{
+    int rc;
+    struct intpl_swap_ref ref;
+
+    if (sw->kind != INTPL_SWAP_XY) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    intpl_swap_acquire(sw, &ref);
+    rc = intpl_nn_arr((struct intpl_xy *)ref.tbl, ref.n, x, y);
+    intpl_swap_release(sw, &ref);
+
+    return rc;
+}
+
+int
+intpl_swap_cubic(struct intpl_swap *sw, float x, float *y)
+{
+    int rc;
+    int idx;
+    const struct intpl_xyc *xyc;
+    struct intpl_swap_ref ref;
+
+    if (sw->kind != INTPL_SWAP_XYC) {
+        *y = NAN;
+        return OS_EINVAL;
+    }
+
+    intpl_swap_acquire(sw, &ref);
+    xyc = (const struct intpl_xyc *)ref.tbl;
+
+    /* Make sure we have at least three values. */
+    if (ref.n < 3) {
+        INTPL_STATS_INC(einval_size);
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    rc = intpl_priv_find(&xyc[0].x, INTPL_PRIV_STRIDE(xyc), ref.n, x, &idx);
+    if (rc) {
+        goto err;
+    }
+
+    rc = intpl_priv_cubic_seg(&xyc[idx], x, y);
+    if (rc) {
+        goto err;
+    }
+
+    intpl_swap_release(sw, &ref);
+
+    return 0;
+err:
+    intpl_swap_release(sw, &ref);
+    *y = NAN;
+    return rc;
+}
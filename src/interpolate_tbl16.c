@@ -0,0 +1,569 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "interpolate/interpolate_tbl16.h"
+#include "interpolate_priv.h"
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+float
+intpl_f16_to_f32(uint16_t h)
+{
+#if defined(__F16C__)
+    return _cvtsh_ss(h);
+#elif defined(__ARM_FP16_FORMAT_IEEE)
+    __fp16 v;
+
+    memcpy(&v, &h, sizeof(v));
+    return (float)v;
+#else
+    uint32_t sign;
+    uint32_t exp;
+    uint32_t man;
+    uint32_t bits;
+    float f;
+
+    sign = (uint32_t)(h & 0x8000) << 16;
+    exp = (h >> 10) & 0x1F;
+    man = h & 0x3FF;
+
+    if (exp == 0) {
+        if (man == 0) {
+            /* Signed zero. */
+            bits = sign;
+        } else {
+            /* Subnormal, normalise the mantissa. */
+            exp = 127 - 15 + 1;
+            while (!(man & 0x400)) {
+                man <<= 1;
+                exp--;
+            }
+            bits = sign | (exp << 23) | ((man & 0x3FF) << 13);
+        }
+    } else if (exp == 31) {
+        /* Infinity or NaN. */
+        bits = sign | 0x7F800000 | (man << 13);
+    } else {
+        bits = sign | ((exp + 127 - 15) << 23) | (man << 13);
+    }
+
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+#endif
+}
+
+uint16_t
+intpl_f32_to_f16(float f)
+{
+    uint32_t bits;
+    uint32_t sign;
+    uint32_t man;
+    uint32_t rem;
+    uint32_t half;
+    uint32_t h;
+    int exp;
+    int shift;
+
+    memcpy(&bits, &f, sizeof(bits));
+    sign = (bits >> 16) & 0x8000;
+    exp = (int)((bits >> 23) & 0xFF);
+    man = bits & 0x7FFFFF;
+
+    if (exp == 0xFF) {
+        /* Infinity or NaN. */
+        return sign | 0x7C00 | (man ? 0x200 : 0);
+    }
+
+    exp = exp - 127 + 15;
+    if (exp >= 31) {
+        /* Too large, round to infinity. */
+        return sign | 0x7C00;
+    }
+
+    if (exp <= 0) {
+        /* Subnormal (or too small, round to zero). */
+        if (exp < -10) {
+            return sign;
+        }
+        man |= 0x800000;
+        shift = 14 - exp;
+        h = man >> shift;
+        rem = man & ((1u << shift) - 1);
+        half = 1u << (shift - 1);
+    } else {
+        h = ((uint32_t)exp << 10) | (man >> 13);
+        rem = man & 0x1FFF;
+        half = 0x1000;
+    }
+
+    /* Round to nearest even. A carry into the exponent is correct. */
+    if (rem > half || (rem == half && (h & 1))) {
+        h++;
+    }
+
+    return sign | h;
+}
+
+/* Reads stored value i, widened to float. */
+static inline float
+intpl_tbl16_get(uint8_t fmt, const void *p, unsigned int i, float scale,
+    float off)
+{
+    switch (fmt) {
+    case INTPL_FMT_F16:
+        return intpl_f16_to_f32(((const uint16_t *)p)[i]);
+    case INTPL_FMT_U16:
+        return (float)((const uint16_t *)p)[i] * scale + off;
+    default:
+        return ((const float *)p)[i];
+    }
+}
+
+#define INTPL_TBL16_X(tbl, i) \
+    intpl_tbl16_get((tbl)->fmt_x, (tbl)->x, (i), (tbl)->x_scale, (tbl)->x_off)
+#define INTPL_TBL16_Y(tbl, i) \
+    intpl_tbl16_get((tbl)->fmt_y, (tbl)->y, (i), (tbl)->y_scale, (tbl)->y_off)
+
+int
+intpl_tbl16_widen(uint8_t fmt, const void *src, float scale, float off,
+    float dst[], unsigned int n)
+{
+    unsigned int i;
+    const uint16_t *s16;
+
+    i = 0;
+    s16 = (const uint16_t *)src;
+
+    switch (fmt) {
+    case INTPL_FMT_F32:
+        memcpy(dst, src, n * sizeof(float));
+        break;
+    case INTPL_FMT_F16:
+#if defined(__F16C__) && defined(__AVX__)
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(
+                _mm_loadu_si128((const __m128i *)&s16[i])));
+        }
+#endif
+        for (; i < n; i++) {
+            dst[i] = intpl_f16_to_f32(s16[i]);
+        }
+        break;
+    case INTPL_FMT_U16:
+        /* Simple enough for the compiler to vectorise. */
+        for (; i < n; i++) {
+            dst[i] = (float)s16[i] * scale + off;
+        }
+        break;
+    default:
+        return OS_EINVAL;
+    }
+
+    return 0;
+}
+
+/* Returns the scale and offset used to store values in INTPL_FMT_U16. */
+static void
+intpl_tbl16_range(const float *v, unsigned int stride, unsigned int n,
+    float *scale, float *off)
+{
+    unsigned int i;
+    float min;
+    float max;
+
+    min = max = v[0];
+    for (i = 1; i < n; i++) {
+        min = v[i*stride] < min ? v[i*stride] : min;
+        max = v[i*stride] > max ? v[i*stride] : max;
+    }
+
+    *off = min;
+    *scale = (max - min) / 65535.0f;
+}
+
+/*
+ * Stores one value, and returns the value read back through 'rd' so the
+ * error can be measured.
+ */
+static int
+intpl_tbl16_put(uint8_t fmt, void *p, unsigned int i, float v, float scale,
+    float off, float *rd)
+{
+    float raw;
+    uint16_t h;
+
+    if (isnan(v)) {
+        return OS_EINVAL;
+    }
+
+    switch (fmt) {
+    case INTPL_FMT_F32:
+        if (p != NULL) {
+            ((float *)p)[i] = v;
+        }
+        *rd = v;
+        break;
+    case INTPL_FMT_F16:
+        if (v > 65504.0f || v < -65504.0f) {
+            return OS_EINVAL;
+        }
+        h = intpl_f32_to_f16(v);
+        if (p != NULL) {
+            ((uint16_t *)p)[i] = h;
+        }
+        *rd = intpl_f16_to_f32(h);
+        break;
+    case INTPL_FMT_U16:
+        raw = scale > 0.0f ? roundf((v - off) / scale) : 0.0f;
+        raw = raw < 0.0f ? 0.0f : (raw > 65535.0f ? 65535.0f : raw);
+        h = (uint16_t)raw;
+        if (p != NULL) {
+            ((uint16_t *)p)[i] = h;
+        }
+        *rd = (float)h * scale + off;
+        break;
+    default:
+        return OS_EINVAL;
+    }
+
+    return 0;
+}
+
+int
+intpl_tbl16_encode(const struct intpl_xy xy[], unsigned int n,
+    uint8_t fmt_x, uint8_t fmt_y, void *xbuf, void *ybuf,
+    struct intpl_tbl16 *tbl)
+{
+    int rc;
+    unsigned int i;
+    float xr;
+    float xr_prev;
+    float yr;
+
+    if (n < 2) {
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    tbl->x = xbuf;
+    tbl->y = ybuf;
+    tbl->n = n;
+    tbl->fmt_x = fmt_x;
+    tbl->fmt_y = fmt_y;
+    intpl_tbl16_range(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, &tbl->x_scale,
+        &tbl->x_off);
+    intpl_tbl16_range(&xy[0].y, INTPL_PRIV_STRIDE(xy), n, &tbl->y_scale,
+        &tbl->y_off);
+
+    xr_prev = 0.0f;
+    for (i = 0; i < n; i++) {
+        rc = intpl_tbl16_put(fmt_x, xbuf, i, xy[i].x, tbl->x_scale,
+            tbl->x_off, &xr);
+        if (rc) {
+            goto err;
+        }
+        /* Rounding must not merge or reorder x values. */
+        if (i > 0 && xr <= xr_prev) {
+            rc = OS_EINVAL;
+            goto err;
+        }
+        xr_prev = xr;
+
+        rc = intpl_tbl16_put(fmt_y, ybuf, i, xy[i].y, tbl->y_scale,
+            tbl->y_off, &yr);
+        if (rc) {
+            goto err;
+        }
+    }
+
+    return 0;
+err:
+    return rc;
+}
+
+/*
+ * Returns a bound on the linear interpolation error of a table stored in
+ * fmt_x/fmt_y, or a negative value if the table can not be stored.
+ */
+static float
+intpl_tbl16_bound(const struct intpl_xy xy[], unsigned int n, uint8_t fmt_x,
+    uint8_t fmt_y)
+{
+    unsigned int i;
+    float x_scale, x_off, y_scale, y_off;
+    float xr, yr;
+    float xr_prev;
+    float ex, ex_prev;
+    float ey, ey_prev;
+    float s, s_prev, s_next;
+    float e;
+    float bound;
+
+    intpl_tbl16_range(&xy[0].x, INTPL_PRIV_STRIDE(xy), n, &x_scale, &x_off);
+    intpl_tbl16_range(&xy[0].y, INTPL_PRIV_STRIDE(xy), n, &y_scale, &y_off);
+
+    bound = 0.0f;
+    xr_prev = ex_prev = ey_prev = s_prev = 0.0f;
+    for (i = 0; i < n; i++) {
+        if (intpl_tbl16_put(fmt_x, NULL, i, xy[i].x, x_scale, x_off, &xr) ||
+            intpl_tbl16_put(fmt_y, NULL, i, xy[i].y, y_scale, y_off, &yr) ||
+            (i > 0 && xr <= xr_prev)) {
+            return -1.0f;
+        }
+        ex = fabsf(xr - xy[i].x);
+        ey = fabsf(yr - xy[i].y);
+
+        if (i > 0) {
+            /* An error in x can move a lookup into the next segment, so
+             * use the steepest of the neighbouring slopes. */
+            s = fabsf((xy[i].y - xy[i-1].y) / (xy[i].x - xy[i-1].x));
+            s_next = s;
+            if (i + 1 < n) {
+                s_next = fabsf((xy[i+1].y - xy[i].y) /
+                    (xy[i+1].x - xy[i].x));
+            }
+            s = fmaxf(fmaxf(s, s_prev), s_next);
+            e = fmaxf(ey, ey_prev) + s * fmaxf(ex, ex_prev);
+            bound = fmaxf(bound, e);
+            s_prev = fabsf((xy[i].y - xy[i-1].y) / (xy[i].x - xy[i-1].x));
+        }
+
+        xr_prev = xr;
+        ex_prev = ex;
+        ey_prev = ey;
+    }
+
+    return bound;
+}
+
+int
+intpl_tbl16_pick(const struct intpl_xy xy[], unsigned int n, float tol,
+    uint8_t *fmt_x, uint8_t *fmt_y, float *err)
+{
+    uint8_t fx;
+    uint8_t fy;
+    unsigned int size;
+    unsigned int best_size;
+    float e;
+    float best_err;
+
+    if (n < 2) {
+        return OS_EINVAL;
+    }
+
+    /* Full precision is always possible, and has no error. */
+    *fmt_x = INTPL_FMT_F32;
+    *fmt_y = INTPL_FMT_F32;
+    best_size = 8;
+    best_err = 0.0f;
+
+    /* Try every combination, preferring the smallest, then most precise. */
+    for (fx = INTPL_FMT_F32; fx <= INTPL_FMT_U16; fx++) {
+        for (fy = INTPL_FMT_F32; fy <= INTPL_FMT_U16; fy++) {
+            size = (fx == INTPL_FMT_F32 ? 4 : 2) + (fy == INTPL_FMT_F32 ? 4 : 2);
+            e = intpl_tbl16_bound(xy, n, fx, fy);
+            if (e < 0.0f || e > tol) {
+                continue;
+            }
+            if (size < best_size || (size == best_size && e < best_err)) {
+                best_size = size;
+                best_err = e;
+                *fmt_x = fx;
+                *fmt_y = fy;
+            }
+        }
+    }
+
+    if (err != NULL) {
+        *err = best_err;
+    }
+
+    return 0;
+}
+
+/* Same result as intpl_find_x for the widened (ascending) x values. */
+static int
+intpl_tbl16_find(const struct intpl_tbl16 *tbl, float x,
+    struct intpl_cursor *cur, int *idx)
+{
+    int rc;
+    unsigned int lo;
+    unsigned int hi;
+    unsigned int mid;
+    float x0;
+    float xn;
+
+    if (tbl->n < 2) {
+        *idx = -1;
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    x0 = INTPL_TBL16_X(tbl, 0);
+    xn = INTPL_TBL16_X(tbl, tbl->n - 1);
+    if (x > xn) {
+        *idx = tbl->n;
+        rc = OS_EINVAL;
+        goto err;
+    } else if (x < x0) {
+        *idx = -1;
+        rc = OS_EINVAL;
+        goto err;
+    }
+
+    if (x == xn) {
+        *idx = tbl->n - 2;
+        return 0;
+    }
+
+    /* Check the last segment first. */
+    if (cur != NULL && cur->idx >= 0 && cur->idx < (int)tbl->n - 1 &&
+        INTPL_TBL16_X(tbl, cur->idx) <= x &&
+        x < INTPL_TBL16_X(tbl, cur->idx + 1)) {
+        INTPL_STATS_INC(hint_hit);
+        *idx = cur->idx;
+        return 0;
+    }
+
+    INTPL_STATS_INC(search);
+    lo = 0;
+    hi = tbl->n;
+    while (hi - lo > 1) {
+        INTPL_STATS_INC(search_iter);
+        mid = (hi + lo) >> 1;
+        if (x >= INTPL_TBL16_X(tbl, mid)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *idx = lo;
+    if (cur != NULL) {
+        cur->idx = lo;
+    }
+
+    return 0;
+err:
+    INTPL_STATS_INC(einval_range);
+    return rc;
+}
+
+int
+intpl_tbl16_nn(const struct intpl_tbl16 *tbl, float x, float *y)
+{
+    int rc;
+    int idx;
+    float x1;
+    float x3;
+
+    rc = intpl_tbl16_find(tbl, x, NULL, &idx);
+    if (rc) {
+        *y = NAN;
+        goto err;
+    }
+
+    /* Determine which value is closest, rounding up on 0.5. */
+    x1 = INTPL_TBL16_X(tbl, idx);
+    x3 = INTPL_TBL16_X(tbl, idx + 1);
+    *y = INTPL_TBL16_Y(tbl, (x3 - x <= x - x1) ? idx + 1 : idx);
+
+    return 0;
+err:
+    return rc;
+}
+
+/* Linear interpolation in segment idx, widening the values as needed. */
+static int
+intpl_tbl16_lin_seg(const struct intpl_tbl16 *tbl, int idx, float x,
+    float *y)
+{
+    float x1;
+    float x3;
+    float y1;
+    float y3;
+
+    x1 = INTPL_TBL16_X(tbl, idx);
+    x3 = INTPL_TBL16_X(tbl, idx + 1);
+    y1 = INTPL_TBL16_Y(tbl, idx);
+    y3 = INTPL_TBL16_Y(tbl, idx + 1);
+
+    /* Encoding guarantees increasing x, but tables can be built by hand. */
+    if (x3 - x1 < 1E-6F && x1 - x3 < 1E-6F) {
+        INTPL_STATS_INC(einval_delta);
+        return OS_EINVAL;
+    }
+
+    *y = ((x - x1) * (y3 - y1)) / (x3 - x1) + y1;
+
+    return 0;
+}
+
+int
+intpl_tbl16_lin_y(const struct intpl_tbl16 *tbl, float x, float *y)
+{
+    int rc;
+    int idx;
+
+    rc = intpl_tbl16_find(tbl, x, NULL, &idx);
+    if (rc == 0) {
+        rc = intpl_tbl16_lin_seg(tbl, idx, x, y);
+    }
+    if (rc) {
+        *y = NAN;
+    }
+
+    return rc;
+}
+
+int
+intpl_tbl16_lin_y_batch(const struct intpl_tbl16 *tbl, const float x[],
+    float y[], unsigned int cnt, struct intpl_cursor *cur)
+{
+    int rc;
+    int rc_first;
+    int idx;
+    unsigned int i;
+    struct intpl_cursor priv;
+
+    INTPL_STATS_INC(batch);
+
+    /* Use a cursor scoped to this call if none was provided. */
+    if (cur == NULL) {
+        priv.idx = -1;
+        cur = &priv;
+    }
+
+    rc_first = 0;
+    for (i = 0; i < cnt; i++) {
+        rc = intpl_tbl16_find(tbl, x[i], cur, &idx);
+        if (rc == 0) {
+            rc = intpl_tbl16_lin_seg(tbl, idx, x[i], &y[i]);
+        }
+        if (rc) {
+            y[i] = NAN;
+            rc_first = rc_first ? rc_first : rc;
+        }
+    }
+
+    return rc_first;
+}
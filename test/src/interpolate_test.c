@@ -25,12 +25,59 @@
 TEST_CASE_DECL(lerp)
 TEST_CASE_DECL(find_x_asc)
 TEST_CASE_DECL(find_x_desc)
+TEST_CASE_DECL(find_x_guess)
 TEST_CASE_DECL(nn)
 TEST_CASE_DECL(nn_arr)
 TEST_CASE_DECL(lin_y)
 TEST_CASE_DECL(lin_y_arr)
 TEST_CASE_DECL(lin_x)
 TEST_CASE_DECL(cubic_arr)
+TEST_CASE_DECL(mc_lin_y)
+TEST_CASE_DECL(mc_nn)
+TEST_CASE_DECL(mc_cubic)
+TEST_CASE_DECL(lin_y_batch)
+TEST_CASE_DECL(cubic_batch)
+TEST_CASE_DECL(par_batch)
+TEST_CASE_DECL(par_cubic_calc)
+TEST_CASE_DECL(stats)
+TEST_CASE_DECL(blob_crc)
+TEST_CASE_DECL(blob_xy)
+TEST_CASE_DECL(blob_cubic)
+TEST_CASE_DECL(blob_bkt)
+TEST_CASE_DECL(tbl16_f16)
+TEST_CASE_DECL(tbl16_lin_y)
+TEST_CASE_DECL(srch_bkt)
+TEST_CASE_DECL(srch_eval)
+TEST_CASE_DECL(srch_auto)
+TEST_CASE_DECL(resample_lin)
+TEST_CASE_DECL(resample_nn)
+TEST_CASE_DECL(resample_cubic)
+TEST_CASE_DECL(resample_cubic_fd)
+TEST_CASE_DECL(resample_mono)
+TEST_CASE_DECL(spline_deriv)
+TEST_CASE_DECL(spline_integral)
+TEST_CASE_DECL(spline_periodic)
+TEST_CASE_DECL(lin_x_arr)
+TEST_CASE_DECL(lin_x_idx)
+TEST_CASE_DECL(cubic_x)
+TEST_CASE_DECL(ring)
+TEST_CASE_DECL(ring_cubic)
+TEST_CASE_DECL(swap)
+TEST_CASE_DECL(swap_threads)
+TEST_CASE_DECL(lerp_arr)
+TEST_CASE_DECL(lerp_rgb)
+TEST_CASE_DECL(path_bezier)
+TEST_CASE_DECL(path_arc)
+TEST_CASE_DECL(path_poly)
+TEST_CASE_DECL(nnt)
+TEST_CASE_DECL(nnt_brute)
+TEST_CASE_DECL(fast)
+TEST_CASE_DECL(diff)
+TEST_CASE_DECL(svc)
+TEST_CASE_DECL(svc_threads)
+TEST_CASE_DECL(reg)
+TEST_CASE_DECL(akima)
+TEST_CASE_DECL(cheb)
 
 int
 intpl_fmt_test_all(void)
@@ -44,12 +91,59 @@ TEST_SUITE(intpl_fmt_test_suite)
     lerp();
     find_x_asc();
     find_x_desc();
+    find_x_guess();
     nn();
     nn_arr();
     lin_y();
     lin_y_arr();
     lin_x();
     cubic_arr();
+    mc_lin_y();
+    mc_nn();
+    mc_cubic();
+    lin_y_batch();
+    cubic_batch();
+    par_batch();
+    par_cubic_calc();
+    stats();
+    blob_crc();
+    blob_xy();
+    blob_cubic();
+    blob_bkt();
+    tbl16_f16();
+    tbl16_lin_y();
+    srch_bkt();
+    srch_eval();
+    srch_auto();
+    resample_lin();
+    resample_nn();
+    resample_cubic();
+    resample_cubic_fd();
+    resample_mono();
+    spline_deriv();
+    spline_integral();
+    spline_periodic();
+    lin_x_arr();
+    lin_x_idx();
+    cubic_x();
+    ring();
+    ring_cubic();
+    swap();
+    swap_threads();
+    lerp_arr();
+    lerp_rgb();
+    path_bezier();
+    path_arc();
+    path_poly();
+    nnt();
+    nnt_brute();
+    fast();
+    diff();
+    svc();
+    svc_threads();
+    reg();
+    akima();
+    cheb();
 }
 
 #if MYNEWT_VAL(SELFTEST)
@@ -20,6 +20,7 @@
 #define __INTERPOLATE_TEST_PRIV__
 
 #include <assert.h>
+#include <math.h>
 #include <stddef.h>
 #include "os/mynewt.h"
 #include "testutil/testutil.h"
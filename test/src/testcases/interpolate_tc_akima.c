@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_akima.h"
+
+#define AKIMA_TEST_N    (20)
+
+TEST_CASE(akima)
+{
+    int rc;
+    unsigned int i;
+    unsigned int k;
+    float x;
+    float y;
+    float xs[8];
+    float ys[8];
+    struct intpl_xyd xyd[AKIMA_TEST_N];
+    struct intpl_xyd ref[AKIMA_TEST_N];
+    struct intpl_cursor cur;
+
+    /* Linear data is reproduced exactly, with the line's slope at knots. */
+    for (i = 0; i < 6; i++) {
+        xyd[i].x = (float)(i * i);
+        xyd[i].y = 3.0f * xyd[i].x - 2.0f;
+    }
+    rc = intpl_akima_calc(xyd, 6);
+    TEST_ASSERT(rc == 0);
+    for (i = 0; i < 6; i++) {
+        TEST_ASSERT(fabsf(xyd[i].d - 3.0f) < 1e-5f);
+    }
+    for (x = 0.0f; x <= 25.0f; x += 0.75f) {
+        rc = intpl_akima(xyd, 6, x, &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(fabsf(y - (3.0f * x - 2.0f)) < 1e-4f);
+    }
+
+    /* A step: the flat runs either side stay flat, without overshoot. */
+    for (i = 0; i < 8; i++) {
+        xyd[i].x = (float)i;
+        xyd[i].y = (i < 4) ? 0.0f : 1.0f;
+    }
+    rc = intpl_akima_calc(xyd, 8);
+    TEST_ASSERT(rc == 0);
+    for (x = 0.0f; x <= 7.0f; x += 0.125f) {
+        rc = intpl_akima(xyd, 8, x, &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(y >= 0.0f && y <= 1.0f);
+        if (x <= 2.0f) {
+            TEST_ASSERT(y == 0.0f);
+        } else if (x >= 5.0f) {
+            TEST_ASSERT(y == 1.0f);
+        }
+    }
+
+    /* A smooth curve on uneven knots. */
+    for (i = 0; i < AKIMA_TEST_N; i++) {
+        xyd[i].x = 0.3f * i + 0.01f * (float)(i % 3);
+        xyd[i].y = sinf(xyd[i].x);
+    }
+    rc = intpl_akima_calc(xyd, AKIMA_TEST_N);
+    TEST_ASSERT(rc == 0);
+    for (x = 0.0f; x <= xyd[AKIMA_TEST_N - 1].x; x += 0.05f) {
+        rc = intpl_akima(xyd, AKIMA_TEST_N, x, &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(fabsf(y - sinf(x)) < 5e-3f);
+    }
+
+    /* Updating one knot gives the same slopes as a full rebuild. */
+    for (k = 0; k < AKIMA_TEST_N; k++) {
+        xyd[k].y += 0.5f;
+        rc = intpl_akima_update(xyd, AKIMA_TEST_N, k);
+        TEST_ASSERT(rc == 0);
+        for (i = 0; i < AKIMA_TEST_N; i++) {
+            ref[i] = xyd[i];
+        }
+        rc = intpl_akima_calc(ref, AKIMA_TEST_N);
+        TEST_ASSERT(rc == 0);
+        for (i = 0; i < AKIMA_TEST_N; i++) {
+            TEST_ASSERT(xyd[i].d == ref[i].d);
+        }
+    }
+
+    /* The batch matches the scalar call, in and out of order. */
+    for (i = 0; i < 8; i++) {
+        xs[i] = (float)((i * 5) % 8) * 0.7f;
+    }
+    xs[7] = 100.0f;
+    cur.idx = -1;
+    rc = intpl_akima_batch(xyd, AKIMA_TEST_N, xs, ys, 8, &cur);
+    TEST_ASSERT(rc == OS_EINVAL);
+    for (i = 0; i < 7; i++) {
+        rc = intpl_akima(xyd, AKIMA_TEST_N, xs[i], &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(ys[i] == y);
+    }
+    TEST_ASSERT(isnan(ys[7]));
+    rc = intpl_akima_batch(xyd, AKIMA_TEST_N, xs, ys, 7, NULL);
+    TEST_ASSERT(rc == 0);
+
+    /* Errors. */
+    rc = intpl_akima_calc(xyd, 2);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_akima(xyd, 2, 0.1f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    rc = intpl_akima(xyd, AKIMA_TEST_N, -1.0f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    rc = intpl_akima_update(xyd, AKIMA_TEST_N, AKIMA_TEST_N);
+    TEST_ASSERT(rc == OS_EINVAL);
+    xyd[5].x = xyd[4].x;
+    rc = intpl_akima_update(xyd, AKIMA_TEST_N, 5);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_akima_calc(xyd, AKIMA_TEST_N);
+    TEST_ASSERT(rc == OS_EINVAL);
+}
@@ -0,0 +1,218 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_par.h"
+
+#define BATCH_TBL_N     (16)
+#define BATCH_CNT       (200)
+
+/* Fills xy and xyc with the same, slightly non-uniform, curve. */
+static void
+batch_tbl_init(struct intpl_xy xy[], struct intpl_xyc xyc[])
+{
+    int rc;
+    unsigned int i;
+
+    memset(xyc, 0, BATCH_TBL_N * sizeof xyc[0]);
+    for (i = 0; i < BATCH_TBL_N; i++) {
+        xy[i].x = xyc[i].x = (float)i + 0.1f * (float)(i % 3);
+        xy[i].y = xyc[i].y = (float)((i * 7) % 5) - 2.0f;
+    }
+
+    rc = intpl_cubic_calc(xyc, BATCH_TBL_N, 1e30, 1e30);
+    TEST_ASSERT(rc == 0);
+}
+
+TEST_CASE(lin_y_batch)
+{
+    int rc;
+    unsigned int i;
+    float x[5];
+    float y[5];
+    float ref;
+    struct intpl_xy xy[BATCH_TBL_N];
+    struct intpl_xyc xyc[BATCH_TBL_N];
+    struct intpl_cursor cur;
+
+    batch_tbl_init(xy, xyc);
+
+    /* Mixed order, including the table limits. */
+    x[0] = 0.0f;
+    x[1] = 3.3f;
+    x[2] = 3.9f;
+    x[3] = 11.0f;
+    x[4] = xy[BATCH_TBL_N - 1].x;
+
+    /* Test 1: Matches intpl_lin_y_arr for every value. */
+    cur.idx = -1;
+    rc = intpl_lin_y_batch(xy, BATCH_TBL_N, x, y, 5, &cur);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 5; i++) {
+        rc = intpl_lin_y_arr(xy, BATCH_TBL_N, x[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[i], ref, 1E-6F, "lin_y_batch 1"));
+    }
+    TEST_ASSERT(cur.idx == BATCH_TBL_N - 2);
+
+    /* Test 2: Out of range values are NAN, the rest are still processed. */
+    x[1] = -1.0f;
+    rc = intpl_lin_y_batch(xy, BATCH_TBL_N, x, y, 5, NULL);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[1]));
+    TEST_ASSERT(!isnan(y[2]));
+}
+
+TEST_CASE(cubic_batch)
+{
+    int rc;
+    unsigned int i;
+    float x[4];
+    float y[4];
+    float ref;
+    struct intpl_xy xy[BATCH_TBL_N];
+    struct intpl_xyc xyc[BATCH_TBL_N];
+
+    batch_tbl_init(xy, xyc);
+
+    x[0] = 0.5f;
+    x[1] = 0.7f;
+    x[2] = 1.3f;
+    x[3] = 9.95f;
+
+    /* Test 1: Matches intpl_cubic_arr for every value. */
+    rc = intpl_cubic_batch(xyc, BATCH_TBL_N, x, y, 4, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 4; i++) {
+        rc = intpl_cubic_arr(xyc, BATCH_TBL_N, x[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[i], ref, 1E-6F, "cubic_batch 1"));
+    }
+
+    /* Test 2: Not enough samples. */
+    rc = intpl_cubic_batch(xyc, 2, x, y, 4, NULL);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[3]));
+}
+
+TEST_CASE(par_batch)
+{
+    int rc;
+    unsigned int i;
+    float span;
+    static float x[BATCH_CNT];
+    static float y[BATCH_CNT];
+    static float ref[BATCH_CNT];
+    struct intpl_xy xy[BATCH_TBL_N];
+    struct intpl_xyc xyc[BATCH_TBL_N];
+    struct intpl_pool pool;
+
+    batch_tbl_init(xy, xyc);
+    span = xy[BATCH_TBL_N - 1].x - xy[0].x;
+
+    rc = intpl_pool_init(&pool, 4);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Sorted values, split on segment boundaries. */
+    for (i = 0; i < BATCH_CNT; i++) {
+        x[i] = xy[0].x + span * (float)i / (float)(BATCH_CNT - 1);
+    }
+    rc = intpl_lin_y_batch(xy, BATCH_TBL_N, x, ref, BATCH_CNT, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_par_lin_y(&pool, xy, BATCH_TBL_N, x, y, BATCH_CNT, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(y, ref, sizeof y) == 0);
+
+    rc = intpl_cubic_batch(xyc, BATCH_TBL_N, x, ref, BATCH_CNT, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_par_cubic(&pool, xyc, BATCH_TBL_N, x, y, BATCH_CNT, 1);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(y, ref, sizeof y) == 0);
+
+    /* Test 2: Unsorted values, split evenly. */
+    for (i = 0; i < BATCH_CNT; i++) {
+        x[i] = xy[0].x + span * (float)((i * 37) % BATCH_CNT) /
+            (float)BATCH_CNT;
+    }
+    rc = intpl_nn_batch(xy, BATCH_TBL_N, x, ref, BATCH_CNT, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_par_nn(&pool, xy, BATCH_TBL_N, x, y, BATCH_CNT, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(y, ref, sizeof y) == 0);
+
+    /* Test 3: Errors are reported from any part. */
+    x[BATCH_CNT - 1] = span * 2.0f;
+    rc = intpl_par_lin_y(&pool, xy, BATCH_TBL_N, x, y, BATCH_CNT, 0);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[BATCH_CNT - 1]));
+
+    rc = intpl_pool_deinit(&pool);
+    TEST_ASSERT(rc == 0);
+}
+
+TEST_CASE(par_cubic_calc)
+{
+    int rc;
+    unsigned int i;
+    unsigned int pass;
+    float max;
+    float err;
+    static struct intpl_xyc ref[1000];
+    static struct intpl_xyc xyc[1000];
+    struct intpl_pool pool;
+
+    rc = intpl_pool_init(&pool, 5);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (pass = 0; pass < 2; pass++) {
+        memset(ref, 0, sizeof ref);
+        for (i = 0; i < 1000; i++) {
+            ref[i].x = (float)i * 0.01f + 0.002f * (float)(i % 7);
+            ref[i].y = sinf(ref[i].x * 3.0f) + 0.05f * (float)(i % 4);
+        }
+        memcpy(xyc, ref, sizeof xyc);
+
+        /* Pass 0 is a natural spline, pass 1 is clamped. */
+        if (pass == 0) {
+            rc = intpl_cubic_calc(ref, 1000, 1e30, 1e30);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = intpl_par_cubic_calc(&pool, xyc, 1000, 1e30, 1e30);
+            TEST_ASSERT_FATAL(rc == 0);
+        } else {
+            rc = intpl_cubic_calc(ref, 1000, 2.0f, -1.0f);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = intpl_par_cubic_calc(&pool, xyc, 1000, 2.0f, -1.0f);
+            TEST_ASSERT_FATAL(rc == 0);
+        }
+
+        /* Test 1: Within the documented tolerance of the sequential build. */
+        max = 0.0f;
+        for (i = 0; i < 1000; i++) {
+            max = fabsf(ref[i].y2) > max ? fabsf(ref[i].y2) : max;
+        }
+        for (i = 0; i < 1000; i++) {
+            err = fabsf(xyc[i].y2 - ref[i].y2);
+            TEST_ASSERT(err <= 1E-4F * max);
+        }
+    }
+
+    rc = intpl_pool_deinit(&pool);
+    TEST_ASSERT(rc == 0);
+}
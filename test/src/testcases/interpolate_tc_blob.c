@@ -0,0 +1,255 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_blob.h"
+
+TEST_CASE(blob_crc)
+{
+    /* Test 1: Standard CRC-32 check value. */
+    TEST_ASSERT(intpl_blob_crc32(0, "123456789", 9) == 0xCBF43926);
+
+    /* Test 2: The CRC can be calculated in pieces. */
+    TEST_ASSERT(intpl_blob_crc32(intpl_blob_crc32(0, "1234", 4),
+        "56789", 5) == 0xCBF43926);
+}
+
+TEST_CASE(blob_xy)
+{
+    int rc;
+    unsigned int i;
+    size_t len;
+    float y;
+    float ref;
+    uint32_t buf[64];
+    struct intpl_xy xy[6];
+    struct intpl_blob blob;
+
+    for (i = 0; i < 6; i++) {
+        xy[i].x = (float)i - 1.0f;
+        xy[i].y = (float)i - 3.0f;
+    }
+
+    /* Test 1: Serialize and open, checking the CRC. */
+    rc = intpl_blob_write_xy(buf, sizeof buf, xy, 6, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(len == sizeof(struct intpl_blob_hdr) + sizeof xy);
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(blob.data == (uint8_t *)buf + blob.hdr->data_off);
+
+    /* Test 2: Lookups run against the blob itself. */
+    rc = intpl_blob_lin_y(&blob, -0.25f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_lin_y_arr(xy, 6, -0.25f, &ref);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y, ref, 1E-6F, "blob_xy 2"));
+    rc = intpl_blob_nn(&blob, -0.25f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y, xy[1].y, 1E-6F, "blob_xy 2b"));
+
+    /* Test 3: Wrong table type. */
+    rc = intpl_blob_cubic(&blob, -0.25f, &y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 4: A corrupt table is only caught when verifying. */
+    ((uint8_t *)buf)[len - 1] ^= 0x01;
+    rc = intpl_blob_open(buf, len, 0, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 5: Truncated blob and output buffer. */
+    rc = intpl_blob_open(buf, len - 4, 0, &blob);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    rc = intpl_blob_write_xy(buf, len - 4, xy, 6, &len);
+    TEST_ASSERT_FATAL(rc == OS_ENOMEM);
+}
+
+TEST_CASE(blob_cubic)
+{
+    int rc;
+    size_t len;
+    float y[2];
+    uint32_t buf[64];
+    struct intpl_xyc xyc[7];
+    struct intpl_blob blob;
+    struct intpl_mc mc;
+    static const float mx[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    static const float my[8] = { 0, 10, 1, 20, 4, 30, 9, 40 };
+
+    memset(xyc, 0, sizeof xyc);
+    xyc[0].x = -3;
+    xyc[0].y = 0.0f;
+    xyc[1].x = -2;
+    xyc[1].y = 1.0f;
+    xyc[2].x = -1;
+    xyc[2].y = 2.0f;
+    xyc[3].x = 0;
+    xyc[3].y = .75f;
+    xyc[4].x = 1;
+    xyc[4].y = 0.0f;
+    xyc[5].x = 2;
+    xyc[5].y = 2.5f;
+    xyc[6].x = 3;
+    xyc[6].y = -1.25f;
+    rc = intpl_cubic_calc(xyc, 7, 1e30, 1e30);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: The stored y2 values are used without recalculating. */
+    rc = intpl_blob_write_xyc(buf, sizeof buf, xyc, 7, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    memset(xyc, 0, sizeof xyc);
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_cubic(&blob, -1.25f, &y[0]);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[0], 1.907918f, 1E-4F, "blob_cubic 1"));
+    rc = intpl_blob_cubic(&blob, 3.5f, &y[0]);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]));
+
+    /* Test 2: Multi-channel table, without y2. */
+    mc.x = mx;
+    mc.y = my;
+    mc.y2 = NULL;
+    mc.n = 4;
+    mc.ch = 2;
+    rc = intpl_blob_write_mc(buf, sizeof buf, &mc, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    memset(&mc, 0, sizeof mc);
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_mc(&blob, &mc);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(mc.n == 4 && mc.ch == 2 && mc.y2 == NULL);
+    rc = intpl_mc_lin_y(&mc, 2.5f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[0], 6.5f, 1E-6F, "blob_cubic 2a"));
+    TEST_ASSERT(f_is_equal(y[1], 35.0f, 1E-6F, "blob_cubic 2b"));
+}
+
+TEST_CASE(blob_bkt)
+{
+    int rc;
+    unsigned int i;
+    size_t len;
+    float x;
+    float y;
+    float ref;
+    static uint32_t buf[256];
+    static uint32_t first[17];
+    static struct intpl_xy xy[64];
+    static struct intpl_xyc xyc[64];
+    struct intpl_bkt bkt;
+    struct intpl_blob blob;
+    struct intpl_blob_hdr *hdr;
+
+    /* A log-spaced table, where the bucket index pays off. */
+    for (i = 0; i < 64; i++) {
+        xy[i].x = powf(1.1f, (float)i);
+        xy[i].y = sqrtf(xy[i].x);
+        xyc[i].x = xy[i].x;
+        xyc[i].y = xy[i].y;
+    }
+    rc = intpl_cubic_calc(xyc, 64, 1e30, 1e30);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: The index is stored after the table and found again. */
+    rc = intpl_bkt_init_xy(&bkt, first, sizeof first, xy, 64, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_write_xy_bkt(buf, sizeof buf, xy, 64, &bkt, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(len == sizeof(struct intpl_blob_hdr) + sizeof xy +
+        sizeof(uint32_t) + intpl_bkt_size(16));
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(blob.hdr->idx_kind == INTPL_BLOB_IDX_BKT);
+    TEST_ASSERT(blob.idx != NULL && blob.bkt.nb == 16);
+    TEST_ASSERT(blob.bkt.x0 == bkt.x0 && blob.bkt.scale == bkt.scale);
+
+    /* Test 2: Lookups through the index match the plain ones. */
+    for (x = 1.0f; x < xy[63].x; x *= 1.037f) {
+        rc = intpl_blob_lin_y(&blob, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        intpl_lin_y_arr(xy, 64, x, &ref);
+        TEST_ASSERT(y == ref);
+        rc = intpl_blob_nn(&blob, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        intpl_nn_arr(xy, 64, x, &ref);
+        TEST_ASSERT(y == ref);
+    }
+    rc = intpl_blob_lin_y(&blob, 0.5f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 3: A corrupt index never leads outside of the table. */
+    hdr = (struct intpl_blob_hdr *)buf;
+    ((uint32_t *)((uint8_t *)buf + hdr->idx_off))[5] = 0xFFFFFFF0;
+    ((uint32_t *)((uint8_t *)buf + hdr->idx_off))[9] = 0xFFFFFFFF;
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_blob_open(buf, len, 0, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (x = 1.0f; x < xy[63].x; x *= 1.037f) {
+        rc = intpl_blob_lin_y(&blob, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        intpl_lin_y_arr(xy, 64, x, &ref);
+        TEST_ASSERT(y == ref);
+    }
+
+    /* Test 4: An index length that does not match nb is rejected. */
+    hdr->idx_len -= sizeof(uint32_t);
+    rc = intpl_blob_open(buf, len, 0, &blob);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 5: Sizes that would wrap around on 32-bit targets. */
+    rc = intpl_blob_write_xy(buf, sizeof buf, xy, 2, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    hdr->n = 0x20000002;
+    rc = intpl_blob_open(buf, len, 0, &blob);
+    TEST_ASSERT(rc == OS_EINVAL);
+    hdr->n = 2;
+    hdr->kind = INTPL_BLOB_MC;
+    hdr->ch = 0xFFFF;
+    rc = intpl_blob_open(buf, len, 0, &blob);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 6: A spline blob with an index. */
+    rc = intpl_bkt_init_xyc(&bkt, first, sizeof first, xyc, 64, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_write_xyc_bkt(buf, sizeof buf, xyc, 64, &bkt, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(blob.idx != NULL);
+    for (x = 1.0f; x < xyc[63].x; x *= 1.037f) {
+        rc = intpl_blob_cubic(&blob, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        intpl_cubic_arr(xyc, 64, x, &ref);
+        TEST_ASSERT(y == ref);
+    }
+    rc = intpl_blob_cubic(&blob, 0.5f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+
+    /* Test 7: The index must belong to the table. */
+    rc = intpl_blob_write_xyc_bkt(buf, sizeof buf, xyc, 63, &bkt, &len);
+    TEST_ASSERT(rc == OS_EINVAL);
+}
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_cheb.h"
+#include "interpolate/interpolate_blob.h"
+
+#define CHEB_TEST_N     (201)
+
+TEST_CASE(cheb)
+{
+    int rc;
+    unsigned int i;
+    size_t len;
+    float x;
+    float y;
+    float xs[6] = { 0.0f, 9.5f, 2.25f, 10.0f, 5.0f, 10.5f };
+    float ys[6];
+    float c[64];
+    static struct intpl_xy xy[CHEB_TEST_N];
+    static uint32_t buf[128];
+    struct intpl_cheb cheb;
+    struct intpl_cheb bc;
+    struct intpl_blob blob;
+
+    /* Test 1: A straight line needs one segment of degree one. */
+    for (i = 0; i < 5; i++) {
+        xy[i].x = (float)i;
+        xy[i].y = 0.5f * xy[i].x + 1.0f;
+    }
+    rc = intpl_cheb_fit(&cheb, xy, 5, 1E-5F, c, 64);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(cheb.nseg == 1 && cheb.nc == 2);
+    rc = intpl_cheb(&cheb, 2.5f, &y);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(f_is_equal(y, 2.25f, 1E-5F, "cheb 1"));
+
+    /* Test 2: A dense calibration curve fits in far fewer coefficients. */
+    for (i = 0; i < CHEB_TEST_N; i++) {
+        xy[i].x = 0.05f * i;
+        xy[i].y = logf(1.0f + xy[i].x);
+    }
+    rc = intpl_cheb_fit(&cheb, xy, CHEB_TEST_N, 1E-3F, c, 64);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(cheb.nseg * cheb.nc <= 16);
+    TEST_ASSERT(cheb.x0 == 0.0f && cheb.x1 == xy[CHEB_TEST_N - 1].x);
+    for (i = 0; i < CHEB_TEST_N; i++) {
+        rc = intpl_cheb(&cheb, xy[i].x, &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(fabsf(y - xy[i].y) <= 1E-3F);
+    }
+    for (x = 0.0f; x <= 10.0f; x += 0.013f) {
+        rc = intpl_cheb(&cheb, x, &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(fabsf(y - logf(1.0f + x)) < 2E-3F);
+    }
+
+    /* Test 3: A tighter tolerance uses more coefficients. */
+    len = cheb.nseg * cheb.nc;
+    rc = intpl_cheb_fit(&cheb, xy, CHEB_TEST_N, 1E-4F, c, 64);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(cheb.nseg * cheb.nc > len);
+    for (i = 0; i < CHEB_TEST_N; i++) {
+        rc = intpl_cheb(&cheb, xy[i].x, &y);
+        TEST_ASSERT(fabsf(y - xy[i].y) <= 1E-4F);
+    }
+
+    /* Test 4: The batch matches the scalar call, with NAN out of range. */
+    rc = intpl_cheb_batch(&cheb, xs, ys, 6);
+    TEST_ASSERT(rc == OS_EINVAL);
+    for (i = 0; i < 5; i++) {
+        rc = intpl_cheb(&cheb, xs[i], &y);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(ys[i] == y);
+    }
+    TEST_ASSERT(isnan(ys[5]));
+
+    /* Test 5: The blob gives identical results, read in place. */
+    rc = intpl_blob_write_cheb(buf, sizeof buf, &cheb, &len);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(len == sizeof(struct intpl_blob_hdr) +
+        (2 + cheb.nseg * cheb.nc) * sizeof(float));
+    rc = intpl_blob_open(buf, len, 1, &blob);
+    TEST_ASSERT(rc == 0);
+    rc = intpl_blob_cheb(&blob, &bc);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(bc.c == (const float *)blob.data + 2);
+    rc = intpl_cheb_batch(&bc, xs, ys, 5);
+    TEST_ASSERT(rc == 0);
+    for (i = 0; i < 5; i++) {
+        intpl_cheb(&cheb, xs[i], &y);
+        TEST_ASSERT(ys[i] == y);
+    }
+    rc = intpl_blob_cubic(&blob, 1.0f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_blob_write_cheb(buf, len - 4, &cheb, &len);
+    TEST_ASSERT(rc == OS_ENOMEM);
+
+    /* Test 6: Errors. */
+    rc = intpl_cheb_fit(&cheb, xy, CHEB_TEST_N, 1E-6F, c, 4);
+    TEST_ASSERT(rc == OS_ENOMEM);
+    rc = intpl_cheb_fit(&cheb, xy, 1, 1E-3F, c, 64);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_cheb_fit(&cheb, xy, CHEB_TEST_N, -1.0f, c, 64);
+    TEST_ASSERT(rc == OS_EINVAL);
+    xy[3].x = xy[2].x;
+    rc = intpl_cheb_fit(&cheb, xy, CHEB_TEST_N, 1E-3F, c, 64);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_cheb(&bc, -0.5f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+}
@@ -0,0 +1,1364 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_akima.h"
+#include "interpolate/interpolate_blob.h"
+#include "interpolate/interpolate_cheb.h"
+#include "interpolate/interpolate_fast.h"
+#include "interpolate/interpolate_inv.h"
+#include "interpolate/interpolate_lerp.h"
+#include "interpolate/interpolate_mc.h"
+#include "interpolate/interpolate_nnt.h"
+#include "interpolate/interpolate_par.h"
+#include "interpolate/interpolate_resample.h"
+#include "interpolate/interpolate_ring.h"
+#include "interpolate/interpolate_spline.h"
+#include "interpolate/interpolate_srch.h"
+#include "interpolate/interpolate_tbl16.h"
+
+/*
+ * Differential harness: every interpolator runs over the same randomised
+ * tables and queries, and is compared against a double precision
+ * reference. Errors are in units of the last place of the larger of the
+ * reference and the largest |y| in the table, so that cancellation near
+ * zero isn't counted as error. Derivatives, integrals and inverse lookups
+ * are measured against the largest reference value instead.
+ *
+ * Multi-channel lookups return channel i % DIFF_MC_CH for query i, where
+ * each channel is the table scaled by diff_mc_scale. 16-bit tables are
+ * compared against the table they decode to, so only the arithmetic is
+ * measured, not the storage error. Inverse lookups use a second table
+ * with monotonic y. Akima splines are compared against the same Hermite
+ * construction in double, and the Chebyshev fit against the cubic through
+ * the four nearest points that it is fitted to. The colour blends round to
+ * integers, so they are measured in units of one channel step instead of
+ * ulp, against the factor they reduce it to.
+ *
+ * Not covered: intpl_lin_x, which takes a single segment and is used by
+ * intpl_lin_x_arr, and the periodic, path and easing functions, which have
+ * no table reference in common with the others and are checked against
+ * their own references in their tests.
+ *
+ * Speed is checked against the plain scalar function of the same family,
+ * as a ratio, so that the limits hold on any host and with sanitizers. The
+ * baselines themselves must reach INTERPOLATE_TEST_DIFF_FLOOR percent of
+ * the throughput recorded for them below.
+ */
+
+#define DIFF_N          (64)    /* Points per table. */
+#define DIFF_Q          (1024)  /* Queries per table. */
+#define DIFF_TABLES     (8)
+#define DIFF_REPS       (16)    /* Timed runs per table. */
+#define DIFF_MC_CH      (3)     /* Channels in the multi-channel table. */
+#define DIFF_NB         (16)    /* Buckets in the blob search index. */
+#define DIFF_THREADS    (4)     /* Threads in the worker pool. */
+#define DIFF_CHEB_C     (1024)  /* Room for the Chebyshev coefficients. */
+#define DIFF_CHEB_TOL   (1E-3F) /* Chebyshev fit tolerance, times ymag. */
+#define DIFF_BLOB_LEN   (sizeof(struct intpl_blob_hdr) + \
+                         DIFF_N * sizeof(struct intpl_xyc) + \
+                         (DIFF_NB + 2) * sizeof(uint32_t))
+
+enum diff_ref {
+    DIFF_REF_LERP,
+    DIFF_REF_LIN,
+    DIFF_REF_CUBIC,
+    DIFF_REF_NN,
+    DIFF_REF_LIN16,     /* Linear, on the decoded 16-bit table. */
+    DIFF_REF_NN16,      /* Nearest, on the decoded 16-bit table. */
+    DIFF_REF_MC_LIN,    /* Linear, channel i % DIFF_MC_CH. */
+    DIFF_REF_MC_CUBIC,  /* Cubic, channel i % DIFF_MC_CH. */
+    DIFF_REF_MC_NN,     /* Nearest, channel i % DIFF_MC_CH. */
+    DIFF_REF_RING,      /* Local cubic, as in intpl_ring_cubic. */
+    DIFF_REF_D1,        /* First derivative of the spline. */
+    DIFF_REF_D2,        /* Second derivative of the spline. */
+    DIFF_REF_INT,       /* Integral of the spline from the first x. */
+    DIFF_REF_LIN_X,     /* Linear inverse, on the monotonic table. */
+    DIFF_REF_CUBIC_X,   /* Spline inverse, on the monotonic table. */
+    DIFF_REF_LERP1,     /* lerp with the single factor t1. */
+    DIFF_REF_RGB565,    /* Channel i % 3 of RGB565 pixel i, in steps. */
+    DIFF_REF_RGB888,    /* Byte i, in steps. */
+    DIFF_REF_AKIMA,     /* Akima spline. */
+    DIFF_REF_LAGR,      /* Cubic through the four nearest points. */
+};
+
+struct diff_ctx {
+    struct intpl_xy xy[DIFF_N];
+    struct intpl_xyc xyc[DIFF_N];
+    double y2[DIFF_N];
+    float mid[DIFF_N - 1];
+    struct intpl_nnt nnt;
+    float q[DIFF_Q];            /* Sorted x queries. */
+    float t[DIFF_Q];            /* lerp factors. */
+    float v0[DIFF_Q];
+    float v1[DIFF_Q];
+    float t1;                   /* lerp factor for a whole array. */
+    float ymag;
+
+    /* Colour buffers, and the blend factor from 0 to 256. */
+    uint16_t px0[DIFF_Q];
+    uint16_t px1[DIFF_Q];
+    uint16_t px[DIFF_Q];
+    uint8_t b0[DIFF_Q];
+    uint8_t b1[DIFF_Q];
+    uint8_t b[DIFF_Q];
+    uint16_t t8;
+
+    /* 16-bit copy of xy, and what it decodes to. */
+    struct intpl_tbl16 t16;
+    uint16_t t16x[DIFF_N];
+    uint16_t t16y[DIFF_N];
+    struct intpl_xy xy16[DIFF_N];
+    float q16[DIFF_Q];          /* q, clamped to the range of xy16. */
+
+    /* Multi-channel copy of xy. */
+    struct intpl_mc mc;
+    float mcx[DIFF_N];
+    float mcy[DIFF_N * DIFF_MC_CH];
+    float mcy2[DIFF_N * DIFF_MC_CH];
+
+    /* Blobs of xy and xyc, with and without a bucket index. */
+    uint32_t bkt_buf[DIFF_NB + 1];
+    uint32_t blob_buf[3][DIFF_BLOB_LEN / sizeof(uint32_t)];
+    struct intpl_blob blob_xy;
+    struct intpl_blob blob_xy_bkt;
+    struct intpl_blob blob_xyc_bkt;
+
+    /* xy, held in a ring buffer that has wrapped around. */
+    struct intpl_ring ring;
+    struct intpl_xy ring_buf[DIFF_N];
+
+    /* Spline integrals, from xy[0].x to each query. */
+    float cum[DIFF_N];
+    float a0[DIFF_Q];
+
+    /* A table with monotonic y, and y queries for inverse lookups. */
+    struct intpl_xy mxy[DIFF_N];
+    struct intpl_xyc mxyc[DIFF_N];
+    double my2[DIFF_N];
+    struct intpl_yidx yi;
+    struct intpl_yidx yic;
+    float yi_buf[4 * DIFF_N];
+    float yic_buf[4 * DIFF_N];
+    float yq[DIFF_Q];
+
+    /* Akima copy of xy, with the knot slopes in double. */
+    struct intpl_xyd xyd[DIFF_N];
+    double akd[DIFF_N];
+
+    /* Chebyshev fit of xy. */
+    struct intpl_cheb cheb;
+    float cheb_c[DIFF_CHEB_C];
+
+    /* A pool, and a table for it to build the spline of. */
+    struct intpl_pool pool;
+    struct intpl_xyc pxyc[DIFF_N];
+};
+
+struct diff_var {
+    const char *name;
+    uint8_t ref;
+    int (*run)(struct diff_ctx *ctx, float out[]);
+    float max_ulp;              /* Negative to only report. */
+    int base;                   /* Index of the scalar baseline. */
+    float max_ratio;            /* Time limit relative to the baseline. */
+    float rec_mqps;             /* Recorded throughput of a baseline. */
+};
+
+struct diff_res {
+    double worst;
+    double sum;
+    unsigned int cnt;
+    int64_t usecs;
+};
+
+/* Channel scales of the multi-channel table; all exact in float. */
+static const float diff_mc_scale[DIFF_MC_CH] = { 1.0f, -1.0f, 0.5f };
+
+/* Channel i % 3 of pixel i, for an RGB565 pixel. */
+static unsigned int
+diff_565(uint16_t p, unsigned int i)
+{
+    return (i % 3 == 0) ? p >> 11 : (i % 3 == 1) ? (p >> 5) & 0x3F :
+        p & 0x1F;
+}
+
+static int
+diff_lerp(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_lerp(ctx->v0[i], ctx->v1[i], ctx->t[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_lerp_arr(struct diff_ctx *ctx, float out[])
+{
+    return intpl_lerp_arr_t(ctx->v0, ctx->v1, ctx->t, out, DIFF_Q);
+}
+
+static int
+diff_lerp_arr1(struct diff_ctx *ctx, float out[])
+{
+    return intpl_lerp_arr(ctx->v0, ctx->v1, ctx->t1, out, DIFF_Q);
+}
+
+static int
+diff_lerp_arr_clamp(struct diff_ctx *ctx, float out[])
+{
+    intpl_lerp_arr_clamp(ctx->v0, ctx->v1, ctx->t, out, DIFF_Q);
+    return 0;
+}
+
+static int
+diff_fast_lerp(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        out[i] = intpl_fast_lerp(ctx->v0[i], ctx->v1[i], ctx->t[i]);
+    }
+    return 0;
+}
+
+static int
+diff_lin_y_arr(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_lin_y_arr(ctx->xy, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_lin_y_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_lin_y_batch(ctx->xy, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_par_lin_y(struct diff_ctx *ctx, float out[])
+{
+    return intpl_par_lin_y(&ctx->pool, ctx->xy, DIFF_N, ctx->q, out, DIFF_Q,
+        1);
+}
+
+static int
+diff_lin_y_srch(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    struct intpl_srch srch;
+
+    intpl_srch_init(&srch, INTPL_SRCH_AUTO, NULL);
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_lin_y_srch(ctx->xy, DIFF_N, ctx->q[i], &out[i], &srch);
+    }
+    return 0;
+}
+
+static int
+diff_resample_lin(struct diff_ctx *ctx, float out[])
+{
+    return intpl_resample(ctx->xy, DIFF_N, INTPL_RS_LIN, ctx->q, out, DIFF_Q);
+}
+
+static int
+diff_fast_lin_arr(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        out[i] = intpl_fast_lin_arr(ctx->xy, DIFF_N, ctx->q[i]);
+    }
+    return 0;
+}
+
+static int
+diff_blob_lin_y(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_blob_lin_y(&ctx->blob_xy, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_blob_lin_y_bkt(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_blob_lin_y(&ctx->blob_xy_bkt, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_ring_lin_y(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_ring_lin_y(&ctx->ring, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_arr(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_arr(ctx->xyc, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cubic_batch(ctx->xyc, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_par_cubic(struct diff_ctx *ctx, float out[])
+{
+    return intpl_par_cubic(&ctx->pool, ctx->xyc, DIFF_N, ctx->q, out, DIFF_Q,
+        1);
+}
+
+/* The spline is built on the pool every time, then used once. */
+static int
+diff_par_cubic_calc(struct diff_ctx *ctx, float out[])
+{
+    int rc;
+    unsigned int i;
+
+    for (i = 0; i < DIFF_N; i++) {
+        ctx->pxyc[i].x = ctx->xy[i].x;
+        ctx->pxyc[i].y = ctx->xy[i].y;
+    }
+    rc = intpl_par_cubic_calc(&ctx->pool, ctx->pxyc, DIFF_N, 1E30F, 1E30F);
+    if (rc) {
+        return rc;
+    }
+    return intpl_cubic_batch(ctx->pxyc, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_cubic_srch(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    struct intpl_srch srch;
+
+    intpl_srch_init(&srch, INTPL_SRCH_AUTO, NULL);
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_srch(ctx->xyc, DIFF_N, ctx->q[i], &out[i], &srch);
+    }
+    return 0;
+}
+
+static int
+diff_resample_cubic(struct diff_ctx *ctx, float out[])
+{
+    return intpl_resample_cubic(ctx->xyc, DIFF_N, ctx->q, out, DIFF_Q);
+}
+
+static int
+diff_fast_cubic(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    unsigned int k;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        k = intpl_fast_find(ctx->xy, DIFF_N, ctx->q[i]);
+        out[i] = intpl_fast_cubic_seg(&ctx->xyc[k], ctx->q[i]);
+    }
+    return 0;
+}
+
+static int
+diff_blob_cubic_bkt(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_blob_cubic(&ctx->blob_xyc_bkt, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_nn_arr(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_nn_arr(ctx->xy, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_par_nn(struct diff_ctx *ctx, float out[])
+{
+    return intpl_par_nn(&ctx->pool, ctx->xy, DIFF_N, ctx->q, out, DIFF_Q, 1);
+}
+
+static int
+diff_nnt(struct diff_ctx *ctx, float out[])
+{
+    return intpl_nnt_batch(&ctx->nnt, ctx->q, out, DIFF_Q);
+}
+
+static int
+diff_nnt_sorted(struct diff_ctx *ctx, float out[])
+{
+    return intpl_nnt_sorted(&ctx->nnt, ctx->q, out, DIFF_Q);
+}
+
+static int
+diff_fast_nn(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    unsigned int k;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        k = intpl_fast_find(ctx->xy, DIFF_N, ctx->q[i]);
+        out[i] = intpl_fast_nn(&ctx->xy[k], &ctx->xy[k + 1], ctx->q[i]);
+    }
+    return 0;
+}
+
+static int
+diff_blob_nn(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_blob_nn(&ctx->blob_xy, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_ring_nn(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_ring_nn(&ctx->ring, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_tbl16_lin_y(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_tbl16_lin_y(&ctx->t16, ctx->q16[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_tbl16_lin_y_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_tbl16_lin_y_batch(&ctx->t16, ctx->q16, out, DIFF_Q, NULL);
+}
+
+static int
+diff_tbl16_nn(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_tbl16_nn(&ctx->t16, ctx->q16[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_mc_lin_y(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    float y[DIFF_MC_CH];
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_mc_lin_y(&ctx->mc, ctx->q[i], y);
+        out[i] = y[i % DIFF_MC_CH];
+    }
+    return 0;
+}
+
+static int
+diff_mc_cubic(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    float y[DIFF_MC_CH];
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_mc_cubic(&ctx->mc, ctx->q[i], y);
+        out[i] = y[i % DIFF_MC_CH];
+    }
+    return 0;
+}
+
+static int
+diff_mc_nn(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+    float y[DIFF_MC_CH];
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_mc_nn(&ctx->mc, ctx->q[i], y);
+        out[i] = y[i % DIFF_MC_CH];
+    }
+    return 0;
+}
+
+static int
+diff_ring_cubic(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_ring_cubic(&ctx->ring, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_d1(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_d1(ctx->xyc, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_d1_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cubic_d1_batch(ctx->xyc, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_cubic_d2(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_d2(ctx->xyc, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_d2_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cubic_d2_batch(ctx->xyc, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_cubic_integral(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_integral(ctx->xyc, DIFF_N, ctx->cum, ctx->a0[i],
+            ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_integral_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cubic_integral_batch(ctx->xyc, DIFF_N, ctx->cum, ctx->a0,
+        ctx->q, out, DIFF_Q);
+}
+
+static int
+diff_lin_x_arr(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_lin_x_arr(ctx->mxy, DIFF_N, ctx->yq[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_lin_x_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_lin_x_batch(ctx->mxy, DIFF_N, ctx->yq, out, DIFF_Q, NULL);
+}
+
+static int
+diff_lin_x_idx(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_lin_x_idx(ctx->mxy, DIFF_N, &ctx->yi, ctx->yq[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_lin_x_idx_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_lin_x_idx_batch(ctx->mxy, DIFF_N, &ctx->yi, ctx->yq, out,
+        DIFF_Q);
+}
+
+static int
+diff_cubic_x(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_x(ctx->mxyc, DIFF_N, NULL, ctx->yq[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cubic_x_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cubic_x_batch(ctx->mxyc, DIFF_N, NULL, ctx->yq, out, DIFF_Q,
+        NULL);
+}
+
+static int
+diff_cubic_x_idx(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cubic_x(ctx->mxyc, DIFF_N, &ctx->yic, ctx->yq[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_rgb565(struct diff_ctx *ctx, float out[])
+{
+    int rc;
+    unsigned int i;
+
+    rc = intpl_lerp_rgb565(ctx->px0, ctx->px1, ctx->t8, ctx->px, DIFF_Q);
+    for (i = 0; i < DIFF_Q; i++) {
+        out[i] = diff_565(ctx->px[i], i);
+    }
+    return rc;
+}
+
+static int
+diff_rgb888(struct diff_ctx *ctx, float out[])
+{
+    int rc;
+    unsigned int i;
+
+    rc = intpl_lerp_rgb888(ctx->b0, ctx->b1, ctx->t8, ctx->b, DIFF_Q);
+    for (i = 0; i < DIFF_Q; i++) {
+        out[i] = ctx->b[i];
+    }
+    return rc;
+}
+
+static int
+diff_akima(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_akima(ctx->xyd, DIFF_N, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_akima_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_akima_batch(ctx->xyd, DIFF_N, ctx->q, out, DIFF_Q, NULL);
+}
+
+static int
+diff_cheb(struct diff_ctx *ctx, float out[])
+{
+    unsigned int i;
+
+    for (i = 0; i < DIFF_Q; i++) {
+        intpl_cheb(&ctx->cheb, ctx->q[i], &out[i]);
+    }
+    return 0;
+}
+
+static int
+diff_cheb_batch(struct diff_ctx *ctx, float out[])
+{
+    return intpl_cheb_batch(&ctx->cheb, ctx->q, out, DIFF_Q);
+}
+
+/*
+ * Each family starts with its scalar baseline. Error limits are about
+ * twice what was measured, and speed limits leave room for noisy hosts:
+ * they are there to catch a variant becoming several times slower, not a
+ * few percent; lookups through an index get a little more, as setting it
+ * up costs more than the search it saves on tables this small, and so do
+ * the pool lookups, which hand each batch off to the threads.
+ * intpl_nn_arr and intpl_nn_batch don't round at the midpoint, so they and
+ * the lookups built on them are only reported. The multi-channel lookups
+ * do DIFF_MC_CH times the work, and the colour, Akima and Chebyshev
+ * functions do different work altogether, so they are their own baselines.
+ * Recorded throughputs are in Mq/s, measured with gcc -O2 on an x86-64
+ * host.
+ */
+static const struct diff_var diff_vars[] = {
+    { "lerp",           DIFF_REF_LERP,  diff_lerp,          2, 0, 0, 320 },
+    { "lerp_arr_t",     DIFF_REF_LERP,  diff_lerp_arr,      2, 0, 2, 0 },
+    { "lerp_arr_clamp", DIFF_REF_LERP,  diff_lerp_arr_clamp, 2, 0, 2, 0 },
+    { "lerp_arr",       DIFF_REF_LERP1, diff_lerp_arr1,     2, 0, 2, 0 },
+    { "fast_lerp",      DIFF_REF_LERP,  diff_fast_lerp,     4, 0, 2, 0 },
+    { "lin_y_arr",      DIFF_REF_LIN,   diff_lin_y_arr,     3, 5, 0, 44 },
+    { "lin_y_batch",    DIFF_REF_LIN,   diff_lin_y_batch,   3, 5, 2, 0 },
+    { "lin_y_srch",     DIFF_REF_LIN,   diff_lin_y_srch,    3, 5, 2, 0 },
+    { "par_lin_y",      DIFF_REF_LIN,   diff_par_lin_y,     3, 5, 3, 0 },
+    { "resample_lin",   DIFF_REF_LIN,   diff_resample_lin,  3, 5, 2, 0 },
+    { "fast_lin_arr",   DIFF_REF_LIN,   diff_fast_lin_arr,  3, 5, 2, 0 },
+    { "blob_lin_y",     DIFF_REF_LIN,   diff_blob_lin_y,    3, 5, 2, 0 },
+    { "blob_lin_y_bkt", DIFF_REF_LIN,   diff_blob_lin_y_bkt, 3, 5, 3, 0 },
+    { "ring_lin_y",     DIFF_REF_LIN,   diff_ring_lin_y,    3, 5, 2, 0 },
+    { "cubic_arr",      DIFF_REF_CUBIC, diff_cubic_arr,     4, 14, 0, 31 },
+    { "cubic_batch",    DIFF_REF_CUBIC, diff_cubic_batch,   4, 14, 2, 0 },
+    { "cubic_srch",     DIFF_REF_CUBIC, diff_cubic_srch,    4, 14, 2, 0 },
+    { "par_cubic",      DIFF_REF_CUBIC, diff_par_cubic,     4, 14, 3, 0 },
+    { "par_cubic_calc", DIFF_REF_CUBIC, diff_par_cubic_calc, 4, 14, 3, 0 },
+    { "resample_cubic", DIFF_REF_CUBIC, diff_resample_cubic, 4, 14, 2, 0 },
+    { "fast_cubic",     DIFF_REF_CUBIC, diff_fast_cubic,    4, 14, 2, 0 },
+    { "blob_cubic_bkt", DIFF_REF_CUBIC, diff_blob_cubic_bkt, 4, 14, 3, 0 },
+    { "nn_arr",         DIFF_REF_NN,    diff_nn_arr,        -1, 22, 0, 46 },
+    { "nnt",            DIFF_REF_NN,    diff_nnt,           0, 22, 2, 0 },
+    { "nnt_sorted",     DIFF_REF_NN,    diff_nnt_sorted,    0, 22, 2, 0 },
+    { "par_nn",         DIFF_REF_NN,    diff_par_nn,        -1, 22, 3, 0 },
+    { "fast_nn",        DIFF_REF_NN,    diff_fast_nn,       0, 22, 2, 0 },
+    { "blob_nn",        DIFF_REF_NN,    diff_blob_nn,       -1, 22, 2, 0 },
+    { "ring_nn",        DIFF_REF_NN,    diff_ring_nn,       0, 22, 2, 0 },
+    { "tbl16_lin_y",    DIFF_REF_LIN16, diff_tbl16_lin_y,   2, 29, 0, 19 },
+    { "tbl16_lin_batch", DIFF_REF_LIN16, diff_tbl16_lin_y_batch, 2, 29, 2, 0 },
+    { "tbl16_nn",       DIFF_REF_NN16,  diff_tbl16_nn,      0, 31, 0, 21 },
+    { "mc_lin_y",       DIFF_REF_MC_LIN, diff_mc_lin_y,     3, 32, 0, 37 },
+    { "mc_cubic",       DIFF_REF_MC_CUBIC, diff_mc_cubic,   5, 33, 0, 29 },
+    { "mc_nn",          DIFF_REF_MC_NN, diff_mc_nn,         0, 34, 0, 37 },
+    { "ring_cubic",     DIFF_REF_RING,  diff_ring_cubic,    8, 35, 0, 25 },
+    { "cubic_d1",       DIFF_REF_D1,    diff_cubic_d1,      4, 36, 0, 35 },
+    { "cubic_d1_batch", DIFF_REF_D1,    diff_cubic_d1_batch, 4, 36, 2, 0 },
+    { "cubic_d2",       DIFF_REF_D2,    diff_cubic_d2,      24, 38, 0, 44 },
+    { "cubic_d2_batch", DIFF_REF_D2,    diff_cubic_d2_batch, 24, 38, 2, 0 },
+    { "cubic_int",      DIFF_REF_INT,   diff_cubic_integral, 4, 40, 0, 19 },
+    { "cubic_int_batch", DIFF_REF_INT, diff_cubic_integral_batch,
+      4, 40, 2, 0 },
+    { "lin_x_arr",      DIFF_REF_LIN_X, diff_lin_x_arr,     3, 42, 0, 42 },
+    { "lin_x_batch",    DIFF_REF_LIN_X, diff_lin_x_batch,   3, 42, 2, 0 },
+    { "lin_x_idx",      DIFF_REF_LIN_X, diff_lin_x_idx,     3, 42, 3, 0 },
+    { "lin_x_idx_batch", DIFF_REF_LIN_X, diff_lin_x_idx_batch, 3, 42, 3, 0 },
+    { "cubic_x",        DIFF_REF_CUBIC_X, diff_cubic_x,     3, 46, 0, 11 },
+    { "cubic_x_batch",  DIFF_REF_CUBIC_X, diff_cubic_x_batch, 3, 46, 2, 0 },
+    { "cubic_x_idx",    DIFF_REF_CUBIC_X, diff_cubic_x_idx, 3, 46, 2, 0 },
+    { "rgb565",         DIFF_REF_RGB565, diff_rgb565,       1, 49, 0, 310 },
+    { "rgb888",         DIFF_REF_RGB888, diff_rgb888,       1, 50, 0, 430 },
+    { "akima",          DIFF_REF_AKIMA, diff_akima,         5, 51, 0, 41 },
+    { "akima_batch",    DIFF_REF_AKIMA, diff_akima_batch,   5, 51, 2, 0 },
+    { "cheb",           DIFF_REF_LAGR,  diff_cheb,          2E4, 53, 0, 90 },
+    { "cheb_batch",     DIFF_REF_LAGR,  diff_cheb_batch,    2E4, 53, 2, 0 },
+};
+
+#define DIFF_VARS   (sizeof(diff_vars) / sizeof(diff_vars[0]))
+
+/* Small LCG, so the tables are the same on every target. */
+static double
+diff_rand(uint32_t *seed)
+{
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (double)(*seed >> 8) / (double)(1UL << 24);
+}
+
+/* Natural spline second derivatives, as intpl_cubic_calc but in double. */
+static void
+diff_spline(const struct intpl_xy xy[], double y2[])
+{
+    int i;
+    double u[DIFF_N];
+    double sig;
+    double p;
+
+    y2[0] = u[0] = 0.0;
+    for (i = 1; i < DIFF_N - 1; i++) {
+        sig = ((double)xy[i].x - xy[i - 1].x) /
+            ((double)xy[i + 1].x - xy[i - 1].x);
+        p = sig * y2[i - 1] + 2.0;
+        y2[i] = (sig - 1.0) / p;
+        u[i] = ((double)xy[i + 1].y - xy[i].y) /
+            ((double)xy[i + 1].x - xy[i].x) -
+            ((double)xy[i].y - xy[i - 1].y) / ((double)xy[i].x - xy[i - 1].x);
+        u[i] = (6.0 * u[i] / ((double)xy[i + 1].x - xy[i - 1].x) -
+            sig * u[i - 1]) / p;
+    }
+    y2[DIFF_N - 1] = 0.0;
+    for (i = DIFF_N - 2; i >= 0; i--) {
+        y2[i] = y2[i] * y2[i + 1] + u[i];
+    }
+}
+
+/* The segment of xy containing x. */
+static int
+diff_seg(const struct intpl_xy xy[], double x)
+{
+    int k;
+
+    for (k = 0; k < DIFF_N - 2 && x > xy[k + 1].x; k++) {
+    }
+    return k;
+}
+
+/* The spline on segment k, or its first or second derivative. */
+static double
+diff_cubic(const struct intpl_xy xy[], const double y2[], int k, double x,
+    int deriv)
+{
+    double h;
+    double a;
+    double b;
+
+    h = (double)xy[k + 1].x - xy[k].x;
+    a = (xy[k + 1].x - x) / h;
+    b = (x - xy[k].x) / h;
+    switch (deriv) {
+    case 1:
+        return ((double)xy[k + 1].y - xy[k].y) / h +
+            (-(3.0 * a * a - 1.0) * y2[k] + (3.0 * b * b - 1.0) * y2[k + 1]) *
+            h / 6.0;
+    case 2:
+        return a * y2[k] + b * y2[k + 1];
+    default:
+        return a * xy[k].y + b * xy[k + 1].y + ((a * a * a - a) * y2[k] +
+            (b * b * b - b) * y2[k + 1]) * (h * h) / 6.0;
+    }
+}
+
+/* The integral of the spline on segment k, from xy[k].x to x. */
+static double
+diff_cubic_int(const struct intpl_xy xy[], const double y2[], int k,
+    double x)
+{
+    double h;
+    double b;
+    double a;
+
+    h = (double)xy[k + 1].x - xy[k].x;
+    b = (x - xy[k].x) / h;
+    a = 1.0 - b;
+    return h * (xy[k].y * (b - 0.5 * b * b) + xy[k + 1].y * 0.5 * b * b +
+        (y2[k] * (0.5 * a * a - 0.25 * a * a * a * a - 0.25) +
+         y2[k + 1] * (0.25 * b * b * b * b - 0.5 * b * b)) * (h * h) / 6.0);
+}
+
+/* The slope at sample i, as in intpl_ring_slope. */
+static double
+diff_ring_slope(const struct intpl_xy xy[], int i)
+{
+    double h0;
+    double h1;
+
+    if (i == 0) {
+        return ((double)xy[1].y - xy[0].y) / ((double)xy[1].x - xy[0].x);
+    }
+    if (i == DIFF_N - 1) {
+        return ((double)xy[i].y - xy[i - 1].y) /
+            ((double)xy[i].x - xy[i - 1].x);
+    }
+    h0 = (double)xy[i].x - xy[i - 1].x;
+    h1 = (double)xy[i + 1].x - xy[i].x;
+    return (((double)xy[i + 1].y - xy[i].y) / h1 * h0 +
+        ((double)xy[i].y - xy[i - 1].y) / h0 * h1) / (h0 + h1);
+}
+
+/* Slope of segment j, extrapolated past the ends as intpl_akima_m. */
+static double
+diff_akima_m(const struct intpl_xy xy[], int j)
+{
+    if (j < 0) {
+        return 2.0 * diff_akima_m(xy, j + 1) - diff_akima_m(xy, j + 2);
+    }
+    if (j > DIFF_N - 2) {
+        return 2.0 * diff_akima_m(xy, j - 1) - diff_akima_m(xy, j - 2);
+    }
+    return ((double)xy[j + 1].y - xy[j].y) / ((double)xy[j + 1].x - xy[j].x);
+}
+
+/* The Akima knot slopes, as intpl_akima_calc but in double. */
+static void
+diff_akima_slopes(const struct intpl_xy xy[], double d[])
+{
+    int i;
+    double w0;
+    double w1;
+
+    for (i = 0; i < DIFF_N; i++) {
+        w0 = fabs(diff_akima_m(xy, i + 1) - diff_akima_m(xy, i));
+        w1 = fabs(diff_akima_m(xy, i - 1) - diff_akima_m(xy, i - 2));
+        if (w0 + w1 > 0.0) {
+            d[i] = (w0 * diff_akima_m(xy, i - 1) +
+                w1 * diff_akima_m(xy, i)) / (w0 + w1);
+        } else {
+            d[i] = 0.5 * (diff_akima_m(xy, i - 1) + diff_akima_m(xy, i));
+        }
+    }
+}
+
+/* Cubic Hermite interpolation on segment k, with slopes d0 and d1. */
+static double
+diff_hermite(const struct intpl_xy xy[], int k, double d0, double d1,
+    double x)
+{
+    double h;
+    double t;
+
+    h = (double)xy[k + 1].x - xy[k].x;
+    t = (x - xy[k].x) / h;
+    return (2.0 * t * t * t - 3.0 * t * t + 1.0) * xy[k].y +
+        (t * t * t - 2.0 * t * t + t) * d0 * h +
+        (-2.0 * t * t * t + 3.0 * t * t) * xy[k + 1].y +
+        (t * t * t - t * t) * d1 * h;
+}
+
+/* The cubic through the four points nearest segment k, in Lagrange form. */
+static double
+diff_lagr(const struct intpl_xy xy[], int k, double x)
+{
+    int i;
+    int j;
+    double l;
+    double y;
+
+    k = (k < 1) ? 1 : (k > DIFF_N - 3) ? DIFF_N - 3 : k;
+    y = 0.0;
+    for (i = k - 1; i <= k + 2; i++) {
+        l = xy[i].y;
+        for (j = k - 1; j <= k + 2; j++) {
+            if (j != i) {
+                l *= (x - xy[j].x) / ((double)xy[i].x - xy[j].x);
+            }
+        }
+        y += l;
+    }
+    return y;
+}
+
+static double
+diff_ref(const struct diff_ctx *ctx, uint8_t ref, unsigned int i)
+{
+    int k;
+    int j;
+    double x;
+    double y;
+    double h;
+    double t;
+    double lo;
+    double hi;
+    double s;
+    const struct intpl_xy *xy;
+
+    switch (ref) {
+    case DIFF_REF_LERP:
+        return (1.0 - ctx->t[i]) * ctx->v0[i] + (double)ctx->t[i] * ctx->v1[i];
+    case DIFF_REF_LERP1:
+        return (1.0 - ctx->t1) * ctx->v0[i] + (double)ctx->t1 * ctx->v1[i];
+    case DIFF_REF_RGB565:
+        /* The factor is reduced to 5 bits. */
+        t = (ctx->t8 >> 3) / 32.0;
+        return (1.0 - t) * diff_565(ctx->px0[i], i) +
+            t * diff_565(ctx->px1[i], i);
+    case DIFF_REF_RGB888:
+        t = ctx->t8 / 256.0;
+        return (1.0 - t) * ctx->b0[i] + t * ctx->b1[i];
+    }
+
+    s = 1.0;
+    switch (ref) {
+    case DIFF_REF_LIN16:
+    case DIFF_REF_NN16:
+        xy = ctx->xy16;
+        x = ctx->q16[i];
+        ref = (ref == DIFF_REF_LIN16) ? DIFF_REF_LIN : DIFF_REF_NN;
+        break;
+    case DIFF_REF_MC_LIN:
+    case DIFF_REF_MC_CUBIC:
+    case DIFF_REF_MC_NN:
+        xy = ctx->xy;
+        x = ctx->q[i];
+        s = diff_mc_scale[i % DIFF_MC_CH];
+        ref = DIFF_REF_LIN + (ref - DIFF_REF_MC_LIN);
+        break;
+    case DIFF_REF_LIN_X:
+    case DIFF_REF_CUBIC_X:
+        xy = ctx->mxy;
+        y = ctx->yq[i];
+        for (k = 0; k < DIFF_N - 2 && y > xy[k + 1].y; k++) {
+        }
+        if (ref == DIFF_REF_LIN_X) {
+            return xy[k].x + (y - xy[k].y) * ((double)xy[k + 1].x - xy[k].x) /
+                ((double)xy[k + 1].y - xy[k].y);
+        }
+        /* The spline is monotonic here, so bisection finds the root. */
+        lo = xy[k].x;
+        hi = xy[k + 1].x;
+        for (j = 0; j < 100; j++) {
+            x = 0.5 * (lo + hi);
+            if (diff_cubic(xy, ctx->my2, k, x, 0) < y) {
+                lo = x;
+            } else {
+                hi = x;
+            }
+        }
+        return 0.5 * (lo + hi);
+    default:
+        xy = ctx->xy;
+        x = ctx->q[i];
+        break;
+    }
+
+    k = diff_seg(xy, x);
+    switch (ref) {
+    case DIFF_REF_LIN:
+        return s * (xy[k].y + (x - xy[k].x) *
+            ((double)xy[k + 1].y - xy[k].y) / ((double)xy[k + 1].x - xy[k].x));
+    case DIFF_REF_NN:
+        return s * ((x >= 0.5 * ((double)xy[k].x + xy[k + 1].x)) ?
+            xy[k + 1].y : xy[k].y);
+    case DIFF_REF_RING:
+        h = (double)xy[k + 1].x - xy[k].x;
+        t = (x - xy[k].x) / h;
+        return (2.0 * t * t * t - 3.0 * t * t + 1.0) * xy[k].y +
+            (t * t * t - 2.0 * t * t + t) * diff_ring_slope(xy, k) * h +
+            (-2.0 * t * t * t + 3.0 * t * t) * xy[k + 1].y +
+            (t * t * t - t * t) * diff_ring_slope(xy, k + 1) * h;
+    case DIFF_REF_D1:
+        return diff_cubic(xy, ctx->y2, k, x, 1);
+    case DIFF_REF_D2:
+        return diff_cubic(xy, ctx->y2, k, x, 2);
+    case DIFF_REF_AKIMA:
+        return diff_hermite(xy, k, ctx->akd[k], ctx->akd[k + 1], x);
+    case DIFF_REF_LAGR:
+        return diff_lagr(xy, k, x);
+    case DIFF_REF_INT:
+        y = diff_cubic_int(xy, ctx->y2, k, x);
+        for (j = 0; j < k; j++) {
+            y += diff_cubic_int(xy, ctx->y2, j, xy[j + 1].x);
+        }
+        return y;
+    default:
+        return s * diff_cubic(xy, ctx->y2, k, x, 0);
+    }
+}
+
+/* Whether a reference is a table value, where ymag is the error scale. */
+static int
+diff_ref_is_y(uint8_t ref)
+{
+    return ref != DIFF_REF_D1 && ref != DIFF_REF_D2 &&
+        ref != DIFF_REF_INT && ref != DIFF_REF_LIN_X &&
+        ref != DIFF_REF_CUBIC_X;
+}
+
+/* The error of v, in ulp or, for the integer colour blends, in steps. */
+static double
+diff_err(uint8_t ref, float v, double r, double mag)
+{
+    double base;
+
+    if (isnan(v)) {
+        return 1E30;
+    }
+    if (ref == DIFF_REF_RGB565 || ref == DIFF_REF_RGB888) {
+        return fabs(v - r);
+    }
+
+    base = fabs(r) > mag ? fabs(r) : mag;
+    return fabs(v - r) / ldexp(1.0, ilogb(base) - 23);
+}
+
+/* The copies of xy in the other table types. */
+static int
+diff_copies(struct diff_ctx *ctx)
+{
+    unsigned int i;
+    unsigned int c;
+    float y[DIFF_N];
+    size_t len;
+    struct intpl_bkt bkt;
+
+    /* x in 16-bit steps over the range, y in half precision. */
+    intpl_tbl16_encode(ctx->xy, DIFF_N, INTPL_FMT_U16, INTPL_FMT_F16,
+        ctx->t16x, ctx->t16y, &ctx->t16);
+    intpl_tbl16_widen(INTPL_FMT_U16, ctx->t16x, ctx->t16.x_scale,
+        ctx->t16.x_off, y, DIFF_N);
+    for (i = 0; i < DIFF_N; i++) {
+        ctx->xy16[i].x = y[i];
+    }
+    intpl_tbl16_widen(INTPL_FMT_F16, ctx->t16y, 0.0f, 0.0f, y, DIFF_N);
+    for (i = 0; i < DIFF_N; i++) {
+        ctx->xy16[i].y = y[i];
+    }
+    for (i = 0; i < DIFF_Q; i++) {
+        ctx->q16[i] = ctx->q[i] < ctx->xy16[0].x ? ctx->xy16[0].x :
+            ctx->q[i] > ctx->xy16[DIFF_N - 1].x ? ctx->xy16[DIFF_N - 1].x :
+            ctx->q[i];
+    }
+
+    for (i = 0; i < DIFF_N; i++) {
+        ctx->mcx[i] = ctx->xy[i].x;
+        for (c = 0; c < DIFF_MC_CH; c++) {
+            ctx->mcy[i * DIFF_MC_CH + c] = diff_mc_scale[c] * ctx->xy[i].y;
+        }
+    }
+    ctx->mc.x = ctx->mcx;
+    ctx->mc.y = ctx->mcy;
+    ctx->mc.y2 = ctx->mcy2;
+    ctx->mc.n = DIFF_N;
+    ctx->mc.ch = DIFF_MC_CH;
+    intpl_mc_cubic_calc(&ctx->mc);
+
+    intpl_blob_write_xy(ctx->blob_buf[0], sizeof(ctx->blob_buf[0]), ctx->xy,
+        DIFF_N, &len);
+    intpl_blob_open(ctx->blob_buf[0], len, 1, &ctx->blob_xy);
+    intpl_bkt_init_xy(&bkt, ctx->bkt_buf, sizeof(ctx->bkt_buf), ctx->xy,
+        DIFF_N, DIFF_NB);
+    intpl_blob_write_xy_bkt(ctx->blob_buf[1], sizeof(ctx->blob_buf[1]),
+        ctx->xy, DIFF_N, &bkt, &len);
+    intpl_blob_open(ctx->blob_buf[1], len, 1, &ctx->blob_xy_bkt);
+    intpl_bkt_init_xyc(&bkt, ctx->bkt_buf, sizeof(ctx->bkt_buf), ctx->xyc,
+        DIFF_N, DIFF_NB);
+    intpl_blob_write_xyc_bkt(ctx->blob_buf[2], sizeof(ctx->blob_buf[2]),
+        ctx->xyc, DIFF_N, &bkt, &len);
+    intpl_blob_open(ctx->blob_buf[2], len, 1, &ctx->blob_xyc_bkt);
+
+    /* Start with older samples, so the table wraps around the ring. */
+    intpl_ring_init(&ctx->ring, ctx->ring_buf, DIFF_N);
+    for (i = 0; i < DIFF_N / 3; i++) {
+        intpl_ring_push(&ctx->ring, ctx->xy[0].x - 100.0f + i, 0.0f);
+    }
+    for (i = 0; i < DIFF_N; i++) {
+        intpl_ring_push(&ctx->ring, ctx->xy[i].x, ctx->xy[i].y);
+    }
+
+    intpl_cubic_cum(ctx->xyc, DIFF_N, ctx->cum);
+    for (i = 0; i < DIFF_Q; i++) {
+        ctx->a0[i] = ctx->xy[0].x;
+    }
+
+    for (i = 0; i < DIFF_N; i++) {
+        ctx->xyd[i].x = ctx->xy[i].x;
+        ctx->xyd[i].y = ctx->xy[i].y;
+    }
+    intpl_akima_calc(ctx->xyd, DIFF_N);
+    diff_akima_slopes(ctx->xy, ctx->akd);
+
+    return intpl_cheb_fit(&ctx->cheb, ctx->xy, DIFF_N,
+        DIFF_CHEB_TOL * ctx->ymag, ctx->cheb_c, DIFF_CHEB_C);
+}
+
+static int
+diff_table(struct diff_ctx *ctx, uint32_t *seed)
+{
+    unsigned int i;
+    double amp;
+    double span;
+
+    amp = 1.0 + 99.0 * diff_rand(seed);
+    ctx->xy[0].x = (float)(-10.0 * diff_rand(seed));
+    ctx->ymag = 0.0f;
+    for (i = 0; i < DIFF_N; i++) {
+        if (i > 0) {
+            ctx->xy[i].x = ctx->xy[i - 1].x + (float)(0.05 + diff_rand(seed));
+        }
+        ctx->xy[i].y = (float)(amp * sin(ctx->xy[i].x) + 0.1 * ctx->xy[i].x);
+        ctx->ymag = fabsf(ctx->xy[i].y) > ctx->ymag ?
+            fabsf(ctx->xy[i].y) : ctx->ymag;
+        ctx->xyc[i].x = ctx->xy[i].x;
+        ctx->xyc[i].y = ctx->xy[i].y;
+
+        /* Slope of at least 1.5, so the spline is monotonic too. */
+        ctx->mxy[i].x = ctx->xy[i].x;
+        ctx->mxy[i].y = (float)(2.0 * ctx->xy[i].x + 0.5 * sin(ctx->xy[i].x));
+        ctx->mxyc[i].x = ctx->mxy[i].x;
+        ctx->mxyc[i].y = ctx->mxy[i].y;
+    }
+    intpl_cubic_calc(ctx->xyc, DIFF_N, 1E30F, 1E30F);
+    diff_spline(ctx->xy, ctx->y2);
+    intpl_nnt_init(&ctx->nnt, ctx->xy, DIFF_N, ctx->mid);
+    intpl_cubic_calc(ctx->mxyc, DIFF_N, 1E30F, 1E30F);
+    diff_spline(ctx->mxy, ctx->my2);
+    intpl_yidx_init_xy(&ctx->yi, ctx->yi_buf, sizeof(ctx->yi_buf), ctx->mxy,
+        DIFF_N);
+    intpl_yidx_init_xyc(&ctx->yic, ctx->yic_buf, sizeof(ctx->yic_buf),
+        ctx->mxyc, DIFF_N);
+
+    /* One random query per stratum, so the queries are sorted. */
+    span = (double)ctx->xy[DIFF_N - 1].x - ctx->xy[0].x;
+    for (i = 0; i < DIFF_Q; i++) {
+        ctx->q[i] = (float)(ctx->xy[0].x +
+            span * (i + diff_rand(seed)) / DIFF_Q);
+        if (ctx->q[i] > ctx->xy[DIFF_N - 1].x) {
+            ctx->q[i] = ctx->xy[DIFF_N - 1].x;
+        }
+        ctx->t[i] = (float)diff_rand(seed);
+        ctx->v0[i] = ctx->xy[i % DIFF_N].y;
+        ctx->v1[i] = ctx->xy[(i + 7) % DIFF_N].y;
+        ctx->px0[i] = (uint16_t)(65536.0 * diff_rand(seed));
+        ctx->px1[i] = (uint16_t)(65536.0 * diff_rand(seed));
+        ctx->b0[i] = (uint8_t)(256.0 * diff_rand(seed));
+        ctx->b1[i] = (uint8_t)(256.0 * diff_rand(seed));
+    }
+    ctx->t1 = (float)diff_rand(seed);
+    ctx->t8 = (uint16_t)(257.0 * diff_rand(seed));
+
+    /* The same for y, over the monotonic table. */
+    span = (double)ctx->mxy[DIFF_N - 1].y - ctx->mxy[0].y;
+    for (i = 0; i < DIFF_Q; i++) {
+        ctx->yq[i] = (float)(ctx->mxy[0].y +
+            span * (i + diff_rand(seed)) / DIFF_Q);
+        if (ctx->yq[i] > ctx->mxy[DIFF_N - 1].y) {
+            ctx->yq[i] = ctx->mxy[DIFF_N - 1].y;
+        }
+    }
+
+    return diff_copies(ctx);
+}
+
+TEST_CASE(diff)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    uint32_t seed;
+    int64_t start;
+    double e;
+    double mag;
+    double mqps;
+    static struct diff_ctx ctx;
+    static float out[DIFF_Q];
+    static double ref[DIFF_Q];
+    static struct diff_res res[DIFF_VARS];
+    const struct diff_var *v;
+    struct diff_res *r;
+
+    memset(res, 0, sizeof(res));
+    rc = intpl_pool_init(&ctx.pool, DIFF_THREADS);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    seed = 2018;
+    for (k = 0; k < DIFF_TABLES; k++) {
+        rc = diff_table(&ctx, &seed);
+        TEST_ASSERT(rc == 0);
+        if (rc != 0) {
+            break;
+        }
+        for (i = 0; i < DIFF_VARS; i++) {
+            v = &diff_vars[i];
+            r = &res[i];
+
+            mag = diff_ref_is_y(v->ref) ? ctx.ymag : 0.0;
+            for (j = 0; j < DIFF_Q; j++) {
+                ref[j] = diff_ref(&ctx, v->ref, j);
+                mag = fabs(ref[j]) > mag ? fabs(ref[j]) : mag;
+            }
+
+            rc = v->run(&ctx, out);
+            TEST_ASSERT(rc == 0);
+            for (j = 0; j < DIFF_Q; j++) {
+                e = diff_err(v->ref, out[j], ref[j], mag);
+                r->worst = (e > r->worst) ? e : r->worst;
+                r->sum += e;
+                r->cnt++;
+            }
+
+            start = os_get_uptime_usec();
+            for (j = 0; j < DIFF_REPS; j++) {
+                v->run(&ctx, out);
+            }
+            r->usecs += os_get_uptime_usec() - start;
+        }
+    }
+
+    printf("  %-16s %10s %10s %10s\n", "variant", "max ulp", "mean ulp",
+        "Mq/s");
+    for (i = 0; i < DIFF_VARS; i++) {
+        r = &res[i];
+        printf("  %-16s %10.2f %10.3f %10.2f\n", diff_vars[i].name, r->worst,
+            r->sum / r->cnt, (double)DIFF_TABLES * DIFF_REPS * DIFF_Q /
+            (r->usecs > 0 ? r->usecs : 1));
+    }
+
+    for (i = 0; i < DIFF_VARS; i++) {
+        v = &diff_vars[i];
+        r = &res[i];
+        if (v->max_ulp >= 0.0f && r->worst > v->max_ulp) {
+            printf("  %s: %.2f ulp > %.2f\n", v->name, r->worst, v->max_ulp);
+            TEST_ASSERT(0);
+        }
+        /* Allow a millisecond for timer resolution. */
+        if (v->max_ratio > 0.0f &&
+            r->usecs > v->max_ratio * res[v->base].usecs + 1000)
+        {
+            printf("  %s: %lld us > %.1f x %lld us\n", v->name,
+                (long long)r->usecs, v->max_ratio,
+                (long long)res[v->base].usecs);
+            TEST_ASSERT(0);
+        }
+        mqps = (double)DIFF_TABLES * DIFF_REPS * DIFF_Q /
+            (r->usecs > 0 ? r->usecs : 1);
+        if (mqps < v->rec_mqps * MYNEWT_VAL(INTERPOLATE_TEST_DIFF_FLOOR) /
+            100.0) {
+            printf("  %s: %.2f Mq/s < %d%% of %.1f Mq/s\n", v->name, mqps,
+                MYNEWT_VAL(INTERPOLATE_TEST_DIFF_FLOOR), v->rec_mqps);
+            TEST_ASSERT(0);
+        }
+    }
+
+    intpl_pool_deinit(&ctx.pool);
+}
@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_fast.h"
+
+TEST_CASE(fast)
+{
+    int rc;
+    int idx;
+    unsigned int i;
+    unsigned int j;
+    float x;
+    float y;
+    float ref;
+    float yu[5];
+    struct intpl_xy xy[5] = {
+        { -1.0f, 2.0f }, { 0.0f, 0.0f }, { 0.5f, 1.0f }, { 2.0f, 4.0f },
+        { 5.0f, -2.0f }
+    };
+    struct intpl_xyc xyc[5];
+
+    for (i = 0; i < 5; i++) {
+        xyc[i].x = xy[i].x;
+        xyc[i].y = xy[i].y;
+    }
+    rc = intpl_cubic_calc(xyc, 5, 1E30F, 1E30F);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 5; i++) {
+        yu[i] = xy[i].y;
+    }
+
+    /* Test 1: Same results as the checked functions on valid input. */
+    for (i = 0; i <= 60; i++) {
+        x = -1.0f + i * 0.1f;
+
+        rc = intpl_find_x(xy, 5, x, &idx);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(intpl_fast_find(xy, 5, x) == (unsigned int)idx);
+
+        rc = intpl_lin_y_arr(xy, 5, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        y = intpl_fast_lin_arr(xy, 5, x);
+        TEST_ASSERT(f_is_equal(y, ref, 1E-5F, "fast lin_arr"));
+
+        rc = intpl_cubic_arr(xyc, 5, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        y = intpl_fast_cubic_seg(&xyc[idx], x);
+        TEST_ASSERT(f_is_equal(y, ref, 1E-5F, "fast cubic_seg"));
+
+        /* A uniform grid with dx = 1.5. */
+        if (x <= 5.0f) {
+            y = intpl_fast_lin_uni(yu, 5, -1.0f, 1.0f / 1.5f, x);
+            j = (unsigned int)((x + 1.0f) / 1.5f);
+            j = (j > 3) ? 3 : j;
+            rc = intpl_lerp(yu[j], yu[j + 1], (x + 1.0f) / 1.5f - j, &ref);
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(f_is_equal(y, ref, 1E-5F, "fast lin_uni"));
+        }
+    }
+
+    /* Test 2: lerp and the true nearest neighbour midpoint. */
+    rc = intpl_lerp(0.1f, 0.2f, 0.25f, &ref);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(intpl_fast_lerp(0.1f, 0.2f, 0.25f), ref, 1E-6F,
+        "fast lerp"));
+    TEST_ASSERT(intpl_fast_nn(&xy[2], &xy[3], 1.24f) == xy[2].y);
+    TEST_ASSERT(intpl_fast_nn(&xy[2], &xy[3], 1.25f) == xy[3].y);
+    TEST_ASSERT(intpl_fast_nn(&xy[2], &xy[3], 1.26f) == xy[3].y);
+
+    /* Test 3: The ends of a table clamp the search. */
+    TEST_ASSERT(intpl_fast_find(xy, 5, -3.0f) == 0);
+    TEST_ASSERT(intpl_fast_find(xy, 5, 9.0f) == 3);
+
+#if MYNEWT_VAL(INTERPOLATE_FAST_CHECKED)
+    /* Test 4: Invalid input gives NAN in checked builds. */
+    TEST_ASSERT(isnan(intpl_fast_lerp(0.1f, 0.2f, 1.5f)));
+    TEST_ASSERT(isnan(intpl_fast_lin_arr(xy, 5, 5.5f)));
+    TEST_ASSERT(isnan(intpl_fast_nn(&xy[2], &xy[3], 2.5f)));
+    TEST_ASSERT(isnan(intpl_fast_lin_uni(yu, 5, -1.0f, 1.0f / 1.5f, 5.5f)));
+    TEST_ASSERT(isnan(intpl_fast_cubic_seg(&xyc[0], 0.5f)));
+#else
+    /* Test 4: Unchecked builds extrapolate from the end segments. */
+    y = intpl_fast_lin_arr(xy, 5, 6.0f);
+    TEST_ASSERT(f_is_equal(y, -4.0f, 1E-5F, "fast extrapolate"));
+#endif
+}
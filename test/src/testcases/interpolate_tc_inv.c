@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_inv.h"
+
+TEST_CASE(lin_x_arr)
+{
+    int rc;
+    unsigned int i;
+    float y[40];
+    float x[40];
+    float v;
+    struct intpl_xy asc[16];
+    struct intpl_xy desc[16];
+
+    for (i = 0; i < 16; i++) {
+        asc[i].x = desc[i].x = (float)i * 0.5f;
+        asc[i].y = (float)(i * i) + (float)i;
+        desc[i].y = -asc[i].y;
+    }
+
+    /* Test 1: Round trip through intpl_lin_y_arr, ascending y. */
+    for (i = 0; i < 40; i++) {
+        x[i] = (float)i * 0.19f;
+        rc = intpl_lin_y_arr(asc, 16, x[i], &y[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_lin_x_arr(asc, 16, y[i], &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(v, x[i], 1E-5F, "lin_x_arr 1"));
+    }
+
+    /* Test 2: Batch, descending y. */
+    for (i = 0; i < 40; i++) {
+        y[i] = -y[i];
+    }
+    rc = intpl_lin_x_batch(desc, 16, y, x, 40, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 40; i++) {
+        TEST_ASSERT(f_is_equal(x[i], (float)i * 0.19f, 1E-5F, "lin_x_arr 2"));
+    }
+
+    /* Test 3: Out of range. */
+    rc = intpl_lin_x_arr(asc, 16, -1.0f, &v);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(v));
+}
+
+TEST_CASE(lin_x_idx)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    float y[50];
+    float x[50];
+    float v;
+    float buf[128];
+    struct intpl_xy xy[50];
+    struct intpl_yidx yi;
+
+    for (i = 0; i < 50; i++) {
+        xy[i].x = (float)i * 0.25f;
+        xy[i].y = sinf(xy[i].x);
+    }
+    TEST_ASSERT(intpl_yidx_size(50) == (49 + 4) * 2 * sizeof(float));
+    rc = intpl_yidx_init_xy(&yi, buf, sizeof(buf), xy, 50);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: The lowest x is found, matching a linear scan. */
+    for (i = 0; i < 50; i++) {
+        y[i] = -0.99f + (float)i * 0.04f;
+    }
+    rc = intpl_lin_x_idx_batch(xy, 50, &yi, y, x, 50);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 50; i++) {
+        for (j = 0; j < 49; j++) {
+            if ((xy[j].y <= y[i] && y[i] <= xy[j+1].y) ||
+                (xy[j].y >= y[i] && y[i] >= xy[j+1].y)) {
+                break;
+            }
+        }
+        TEST_ASSERT_FATAL(j < 49);
+        TEST_ASSERT(x[i] >= xy[j].x && x[i] <= xy[j+1].x);
+        rc = intpl_lin_y_arr(xy, 50, x[i], &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(v, y[i], 1E-5F, "lin_x_idx 1"));
+    }
+
+    /* Test 2: Values that are never reached. */
+    rc = intpl_lin_x_idx(xy, 50, &yi, 1.5f, &v);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(v));
+}
+
+TEST_CASE(cubic_x)
+{
+    int rc;
+    unsigned int i;
+    float x;
+    float y;
+    float v;
+    float ref;
+    float buf[64];
+    struct intpl_xyc mono[20];
+    struct intpl_xyc wave[20];
+    struct intpl_yidx yi;
+
+    for (i = 0; i < 20; i++) {
+        mono[i].x = wave[i].x = (float)i * 0.3f;
+        mono[i].y = expf(mono[i].x * 0.5f);
+        wave[i].y = sinf(wave[i].x);
+    }
+    rc = intpl_cubic_calc(mono, 20, 1e30f, 1e30f);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_calc(wave, 20, 1e30f, 1e30f);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Round trip through intpl_cubic_arr, monotonic knots. */
+    for (i = 0; i < 57; i++) {
+        x = (float)i * 0.1f;
+        rc = intpl_cubic_arr(mono, 20, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_cubic_x(mono, 20, NULL, y, &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(v, x, 1E-4F, "cubic_x 1"));
+    }
+
+    /* Test 2: Non-monotonic spline, through a y-range index. The result
+     * maps back to y, and no lower x does. */
+    rc = intpl_yidx_init_xyc(&yi, buf, sizeof(buf), wave, 20);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 40; i++) {
+        y = -0.95f + (float)i * 0.049f;
+        rc = intpl_cubic_x(wave, 20, &yi, y, &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_cubic_arr(wave, 20, v, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(ref, y, 1E-4F, "cubic_x 2"));
+        for (x = 0.0f; x < v - 0.01f; x += 0.005f) {
+            rc = intpl_cubic_arr(wave, 20, x, &ref);
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(y < 0.0f ? ref > y : ref < y);
+        }
+    }
+
+    /* Test 3: The peak of the spline lies between knots, and is found. */
+    rc = intpl_cubic_arr(wave, 20, 1.5708f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(y > wave[5].y && y > wave[6].y);
+    rc = intpl_cubic_x(wave, 20, &yi, y - 1E-5F, &v);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(v > wave[5].x && v < 1.5708f);
+
+    /* Test 4: Values that are never reached. */
+    rc = intpl_cubic_x(wave, 20, &yi, 2.0f, &v);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(v));
+}
@@ -17,8 +17,10 @@
  * under the License.
  */
 
+#include <stdlib.h>
 #include <string.h>
 #include "interpolate_test_priv.h"
+#include "interpolate/interpolate_lerp.h"
 
 TEST_CASE(lerp)
 {
@@ -57,3 +59,151 @@ TEST_CASE(lerp)
     rc = intpl_lerp(v0, v1, t, &v);
     TEST_ASSERT_FATAL(rc == OS_EINVAL);
 }
+
+TEST_CASE(lerp_arr)
+{
+    int rc;
+    unsigned int i;
+    float v0[19];
+    float v1[19];
+    float t[19];
+    float v[19];
+    float ref;
+    float e[19];
+
+    /* Odd length so that the vector loops leave a tail. */
+    for (i = 0; i < 19; i++) {
+        v0[i] = 0.25f * i - 1.0f;
+        v1[i] = 3.0f - 0.5f * i;
+        t[i] = i / 18.0f;
+    }
+
+    /* Test 1: One factor for the whole array matches intpl_lerp. */
+    rc = intpl_lerp_arr(v0, v1, 0.3f, v, 19);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 19; i++) {
+        rc = intpl_lerp(v0[i], v1[i], 0.3f, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(v[i], ref, 1E-6F, "lerp_arr 1"));
+    }
+
+    /* Test 2: An invalid factor fails the whole array. */
+    rc = intpl_lerp_arr(v0, v1, 1.01f, v, 19);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    for (i = 0; i < 19; i++) {
+        TEST_ASSERT(isnan(v[i]));
+    }
+
+    /* Test 3: A factor per element, in place over v0. */
+    memcpy(v, v0, sizeof(v));
+    rc = intpl_lerp_arr_t(v, v1, t, v, 19);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 19; i++) {
+        rc = intpl_lerp(v0[i], v1[i], t[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(v[i], ref, 1E-6F, "lerp_arr 3"));
+    }
+
+    /* Test 4: Only the elements with an invalid factor are NAN. */
+    t[2] = -0.5f;
+    t[17] = 1.5f;
+    rc = intpl_lerp_arr_t(v0, v1, t, v, 19);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    for (i = 0; i < 19; i++) {
+        if ((i == 2) || (i == 17)) {
+            TEST_ASSERT(isnan(v[i]));
+        } else {
+            TEST_ASSERT(!isnan(v[i]));
+        }
+    }
+
+    /* Test 5: Clamping instead of checking. */
+    intpl_lerp_arr_clamp(v0, v1, t, v, 19);
+    TEST_ASSERT(f_is_equal(v[2], v0[2], 1E-6F, "lerp_arr 5a"));
+    TEST_ASSERT(f_is_equal(v[17], v1[17], 1E-6F, "lerp_arr 5b"));
+    TEST_ASSERT(f_is_equal(v[9], 0.5f * (v0[9] + v1[9]), 1E-6F,
+        "lerp_arr 5c"));
+
+    /* Test 6: Every curve keeps its end points, and the array form matches. */
+    for (i = 0; i < 19; i++) {
+        t[i] = i / 18.0f;
+    }
+    for (i = INTPL_EASE_LINEAR; i <= INTPL_EASE_SMOOTHERSTEP; i++) {
+        TEST_ASSERT(f_is_equal(intpl_ease(i, 0.0f), 0.0f, 1E-6F, "ease 0"));
+        TEST_ASSERT(f_is_equal(intpl_ease(i, 1.0f), 1.0f, 1E-6F, "ease 1"));
+        TEST_ASSERT(f_is_equal(intpl_ease(i, 2.0f), 1.0f, 1E-6F, "ease 2"));
+        rc = intpl_ease_arr(i, t, e, 19);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(e[9], intpl_ease(i, t[9]), 1E-6F, "ease 3"));
+    }
+    TEST_ASSERT(f_is_equal(intpl_ease(INTPL_EASE_SMOOTHSTEP, 0.25f),
+        0.15625f, 1E-6F, "ease 4"));
+    TEST_ASSERT(f_is_equal(intpl_ease(INTPL_EASE_IN_OUT_CUBIC, 0.75f),
+        0.9375f, 1E-6F, "ease 5"));
+
+    /* Test 7: Unknown curve. */
+    TEST_ASSERT(isnan(intpl_ease(200, 0.5f)));
+    rc = intpl_ease_arr(200, t, e, 19);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(e[0]));
+}
+
+TEST_CASE(lerp_rgb)
+{
+    int rc;
+    unsigned int i;
+    unsigned int c;
+    unsigned int t8;
+    uint16_t a[5] = { 0x0000, 0xFFFF, 0xF800, 0x07E0, 0x1234 };
+    uint16_t b[5] = { 0xFFFF, 0x0000, 0x001F, 0xF81F, 0xABCD };
+    uint16_t o[5];
+    uint8_t a8[9] = { 0, 255, 10, 20, 30, 40, 200, 100, 128 };
+    uint8_t b8[9] = { 255, 0, 250, 20, 60, 0, 100, 200, 129 };
+    uint8_t o8[9];
+    int ca;
+    int cb;
+    int co;
+    int ref;
+    /* Shift and mask for red, green and blue. */
+    static const int sh[3] = { 11, 5, 0 };
+    static const int mk[3] = { 0x1F, 0x3F, 0x1F };
+
+    /* Test 1: The end points are exact. */
+    rc = intpl_lerp_rgb565(a, b, 0, o, 5);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(o, a, sizeof(o)) == 0);
+    rc = intpl_lerp_rgb565(a, b, 256, o, 5);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(o, b, sizeof(o)) == 0);
+
+    /* Test 2: Each channel within one step of the exact blend. */
+    for (t8 = 0; t8 <= 256; t8 += 8) {
+        rc = intpl_lerp_rgb565(a, b, t8, o, 5);
+        TEST_ASSERT_FATAL(rc == 0);
+        for (i = 0; i < 5; i++) {
+            for (c = 0; c < 3; c++) {
+                ca = (a[i] >> sh[c]) & mk[c];
+                cb = (b[i] >> sh[c]) & mk[c];
+                co = (o[i] >> sh[c]) & mk[c];
+                ref = (ca * (256 - (int)t8) + cb * (int)t8) / 256;
+                TEST_ASSERT(abs(co - ref) <= 1);
+            }
+        }
+    }
+
+    /* Test 3: 8-bit channels, then in place over a8. */
+    rc = intpl_lerp_rgb888(a8, b8, 64, o8, 9);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 9; i++) {
+        TEST_ASSERT(o8[i] == (a8[i] * 192 + b8[i] * 64) >> 8);
+    }
+    rc = intpl_lerp_rgb888(a8, b8, 256, a8, 9);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(memcmp(a8, b8, sizeof(a8)) == 0);
+
+    /* Test 4: Factor out of range. */
+    rc = intpl_lerp_rgb565(a, b, 257, o, 5);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    rc = intpl_lerp_rgb888(a8, b8, 300, o8, 9);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+}
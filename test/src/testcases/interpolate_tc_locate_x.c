@@ -193,3 +193,51 @@ TEST_CASE(find_x_desc)
     TEST_ASSERT_FATAL(rc == OS_EINVAL);
     TEST_ASSERT(idx == -1);
 }
+
+TEST_CASE(find_x_guess)
+{
+    int rc;
+    int rc_ref;
+    int idx;
+    int idx_ref;
+    unsigned int i;
+    unsigned int pass;
+    float x;
+    static struct intpl_xy xy[100];
+
+    for (pass = 0; pass < 3; pass++) {
+        for (i = 0; i < 100; i++) {
+            if (pass == 0) {
+                /* Nearly uniform, ascending. */
+                xy[i].x = (float)i + 0.3f * sinf((float)i);
+            } else if (pass == 1) {
+                /* Nearly uniform, descending. */
+                xy[i].x = 100.0f - (float)i - 0.3f * sinf((float)i);
+            } else {
+                /* Strongly non-uniform, so every guess is poor. */
+                xy[i].x = (float)(i * i * i) * 0.001f;
+            }
+            xy[i].y = (float)i;
+        }
+
+        /* Test 1: Identical to intpl_find_x, including the limits, the
+         * knots themselves and out of range values. */
+        for (i = 0; i <= 1020; i++) {
+            x = xy[0].x + (xy[99].x - xy[0].x) * ((float)i - 10.0f) / 1000.0f;
+            rc = intpl_find_x_guess(xy, 100, x, &idx);
+            rc_ref = intpl_find_x(xy, 100, x, &idx_ref);
+            TEST_ASSERT(rc == rc_ref);
+            TEST_ASSERT(idx == idx_ref);
+        }
+        for (i = 0; i < 100; i++) {
+            rc = intpl_find_x_guess(xy, 100, xy[i].x, &idx);
+            rc_ref = intpl_find_x(xy, 100, xy[i].x, &idx_ref);
+            TEST_ASSERT(rc == rc_ref);
+            TEST_ASSERT(idx == idx_ref);
+        }
+    }
+
+    /* Test 2: Too few values. */
+    rc = intpl_find_x_guess(xy, 1, xy[0].x, &idx);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+}
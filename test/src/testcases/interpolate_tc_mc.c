@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_mc.h"
+
+/* Three channels sharing the same x values. */
+static const float mc_x[7] = { -3, -2, -1, 0, 1, 2, 3 };
+static const float mc_y[7 * 3] = {
+    0.0f,   -3.0f,  10.0f,
+    1.0f,   -2.0f,  20.0f,
+    2.0f,   -1.0f,  15.0f,
+    0.75f,  0.0f,   12.0f,
+    0.0f,   1.0f,   30.0f,
+    2.5f,   2.0f,   25.0f,
+    -1.25f, 3.0f,   5.0f
+};
+
+TEST_CASE(mc_lin_y)
+{
+    int rc;
+    unsigned int c;
+    unsigned int i;
+    float y[3];
+    float ref;
+    struct intpl_mc mc;
+    struct intpl_xy xy[7];
+
+    mc.x = mc_x;
+    mc.y = mc_y;
+    mc.y2 = NULL;
+    mc.n = 7;
+    mc.ch = 3;
+
+    /* Test 1: Every channel matches intpl_lin_y_arr on the same data. */
+    rc = intpl_mc_lin_y(&mc, -1.25f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (c = 0; c < mc.ch; c++) {
+        for (i = 0; i < mc.n; i++) {
+            xy[i].x = mc_x[i];
+            xy[i].y = mc_y[i * mc.ch + c];
+        }
+        rc = intpl_lin_y_arr(xy, mc.n, -1.25f, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[c], ref, 1E-4F, "mc_lin_y 1"));
+    }
+
+    /* Test 2: x == upper limit. */
+    rc = intpl_mc_lin_y(&mc, 3.0f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[2], 5.0f, 1E-4F, "mc_lin_y 2"));
+
+    /* Test 3: Out of range sets every channel to NAN. */
+    rc = intpl_mc_lin_y(&mc, 3.5f, y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]) && isnan(y[1]) && isnan(y[2]));
+}
+
+TEST_CASE(mc_nn)
+{
+    int rc;
+    float y[3];
+    struct intpl_mc mc;
+
+    mc.x = mc_x;
+    mc.y = mc_y;
+    mc.y2 = NULL;
+    mc.n = 7;
+    mc.ch = 3;
+
+    /* Test 1: Closer to the lower row. */
+    rc = intpl_mc_nn(&mc, -1.6f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[0], 1.0f, 1E-4F, "mc_nn 1a"));
+    TEST_ASSERT(f_is_equal(y[2], 20.0f, 1E-4F, "mc_nn 1b"));
+
+    /* Test 2: Exactly on the midpoint rounds up. */
+    rc = intpl_mc_nn(&mc, 1.5f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[1], 2.0f, 1E-4F, "mc_nn 2"));
+}
+
+TEST_CASE(mc_cubic)
+{
+    int rc;
+    unsigned int c;
+    unsigned int i;
+    float y[3];
+    float y2[7 * 3];
+    float ref;
+    struct intpl_mc mc;
+    struct intpl_xyc xyc[7];
+
+    mc.x = mc_x;
+    mc.y = mc_y;
+    mc.y2 = y2;
+    mc.n = 7;
+    mc.ch = 3;
+
+    rc = intpl_mc_cubic_calc(&mc);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Channel 0 matches the single channel cubic_arr test. */
+    rc = intpl_mc_cubic(&mc, -1.25f, y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(y[0], 1.907918f, 1E-4F, "mc_cubic 1"));
+
+    /* Test 2: Every channel matches intpl_cubic_arr on the same data. */
+    for (c = 0; c < mc.ch; c++) {
+        memset(xyc, 0, sizeof xyc);
+        for (i = 0; i < mc.n; i++) {
+            xyc[i].x = mc_x[i];
+            xyc[i].y = mc_y[i * mc.ch + c];
+        }
+        rc = intpl_cubic_calc(xyc, mc.n, 1e30, 1e30);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_cubic_arr(xyc, mc.n, 0.4f, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_mc_cubic(&mc, 0.4f, y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[c], ref, 1E-4F, "mc_cubic 2"));
+    }
+
+    /* Test 3: Not enough samples. */
+    mc.n = 2;
+    rc = intpl_mc_cubic(&mc, -2.5f, y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+}
@@ -0,0 +1,157 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_nnt.h"
+
+/* Small LCG, so the test points are the same on every target. */
+static float
+nnt_rand(uint32_t *seed)
+{
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (float)(*seed >> 8) / (float)(1UL << 24);
+}
+
+/* Brute force reference, ties going to the later point. */
+static unsigned int
+nnt_ref(const struct intpl_xy xy[], unsigned int n, float x)
+{
+    unsigned int i;
+    unsigned int best;
+
+    best = 0;
+    for (i = 1; i < n; i++) {
+        if (fabsf(x - xy[i].x) <= fabsf(x - xy[best].x)) {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+TEST_CASE(nnt)
+{
+    int rc;
+    unsigned int i;
+    unsigned int idx;
+    float y;
+    float mid[4];
+    struct intpl_nnt nnt;
+    struct intpl_xy xy[5] = {
+        { 0.0f, 10.0f }, { 1.0f, 11.0f }, { 3.0f, 12.0f }, { 4.0f, 13.0f },
+        { 10.0f, 14.0f }
+    };
+    float x[8] = { 0.0f, 0.49f, 0.5f, 2.0f, 1.99f, 6.9f, 7.0f, 10.0f };
+    unsigned int ref[8] = { 0, 0, 1, 2, 1, 3, 4, 4 };
+
+    /* Test 1: Too few points. */
+    rc = intpl_nnt_init(&nnt, xy, 1, mid);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 2: True midpoints, rounding up on the midpoint itself. */
+    rc = intpl_nnt_init(&nnt, xy, 5, mid);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 8; i++) {
+        rc = intpl_nnt_idx(&nnt, x[i], &idx);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(idx == ref[i]);
+        rc = intpl_nnt(&nnt, x[i], &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(y == xy[ref[i]].y);
+    }
+
+    /* Test 3: Out of range. */
+    rc = intpl_nnt(&nnt, -0.01f, &y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    rc = intpl_nnt(&nnt, 10.01f, &y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 4: Sorted and unsorted batches agree with single lookups. */
+    {
+        float xb[6] = { 0.2f, 2.0f, 11.0f, 6.0f, 9.0f, 0.6f };
+        float yb[6];
+        float ys[6];
+
+        rc = intpl_nnt_batch(&nnt, xb, yb, 6);
+        TEST_ASSERT_FATAL(rc == OS_EINVAL);
+        rc = intpl_nnt_sorted(&nnt, xb, ys, 6);
+        TEST_ASSERT_FATAL(rc == OS_EINVAL);
+        for (i = 0; i < 6; i++) {
+            rc = intpl_nnt(&nnt, xb[i], &y);
+            if (rc) {
+                TEST_ASSERT(isnan(yb[i]) && isnan(ys[i]));
+            } else {
+                TEST_ASSERT(yb[i] == y && ys[i] == y);
+            }
+        }
+    }
+}
+
+TEST_CASE(nnt_brute)
+{
+    int rc;
+    unsigned int i;
+    unsigned int k;
+    unsigned int got;
+    unsigned int best;
+    uint32_t seed;
+    float x[200];
+    float y[200];
+    float ys[200];
+    float mid[63];
+    struct intpl_xy xy[64];
+    struct intpl_nnt nnt;
+
+    seed = 42;
+    for (k = 0; k < 2; k++) {
+        /* Uneven spacing, ascending then descending. */
+        xy[0].x = (k == 0) ? -5.0f : 5.0f;
+        xy[0].y = 0.0f;
+        for (i = 1; i < 64; i++) {
+            xy[i].x = xy[i - 1].x +
+                ((k == 0) ? 1.0f : -1.0f) * (0.01f + nnt_rand(&seed));
+            xy[i].y = (float)i;
+        }
+        rc = intpl_nnt_init(&nnt, xy, 64, mid);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        /* Queries in order of the table, then random. */
+        for (i = 0; i < 200; i++) {
+            x[i] = xy[0].x + (xy[63].x - xy[0].x) * i / 199.0f;
+        }
+        x[199] = xy[63].x;
+        for (i = 0; i < 2; i++) {
+            rc = intpl_nnt_sorted(&nnt, x, ys, 200);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = intpl_nnt_batch(&nnt, x, y, 200);
+            TEST_ASSERT_FATAL(rc == 0);
+            for (got = 0; got < 200; got++) {
+                best = nnt_ref(xy, 64, x[got]);
+                TEST_ASSERT(ys[got] == y[got]);
+                /* Equal distance to the reference, allowing for rounding. */
+                TEST_ASSERT(fabsf(x[got] - xy[(unsigned int)y[got]].x) <=
+                    fabsf(x[got] - xy[best].x) + 1E-5F);
+            }
+            for (got = 0; got < 200; got++) {
+                x[got] = xy[0].x + (xy[63].x - xy[0].x) * nnt_rand(&seed);
+            }
+        }
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_path.h"
+
+TEST_CASE(path_bezier)
+{
+    int rc;
+    unsigned int i;
+    float t[5] = { 0.0f, 0.25f, 1.5f, 0.75f, 1.0f };
+    float a;
+    float b;
+    float c;
+    float ab;
+    float bc;
+    struct intpl_xy pt;
+    struct intpl_xy out[9];
+    struct intpl_xy p2[3] = { { 0.0f, 0.0f }, { 1.0f, 2.0f }, { 3.0f, 0.0f } };
+    struct intpl_xy p3[4] = {
+        { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 2.0f, 1.0f }, { 2.0f, -1.0f }
+    };
+
+    /* Test 1: The end points are exact. */
+    rc = intpl_bezier2(p2, 0.0f, &pt);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(pt.x == p2[0].x && pt.y == p2[0].y);
+    rc = intpl_bezier3(p3, 1.0f, &pt);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(pt.x == p3[3].x && pt.y == p3[3].y);
+
+    /* Test 2: Matches de Casteljau with intpl_lerp. */
+    for (i = 0; i <= 8; i++) {
+        rc = intpl_bezier3(p3, i / 8.0f, &pt);
+        TEST_ASSERT_FATAL(rc == 0);
+        intpl_lerp(p3[0].y, p3[1].y, i / 8.0f, &a);
+        intpl_lerp(p3[1].y, p3[2].y, i / 8.0f, &b);
+        intpl_lerp(p3[2].y, p3[3].y, i / 8.0f, &c);
+        intpl_lerp(a, b, i / 8.0f, &ab);
+        intpl_lerp(b, c, i / 8.0f, &bc);
+        intpl_lerp(ab, bc, i / 8.0f, &a);
+        TEST_ASSERT(f_is_equal(pt.y, a, 1E-5F, "path_bezier 2"));
+    }
+    rc = intpl_bezier2(p2, 0.5f, &pt);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(pt.x, 1.25f, 1E-6F, "path_bezier 2x"));
+    TEST_ASSERT(f_is_equal(pt.y, 1.0f, 1E-6F, "path_bezier 2y"));
+
+    /* Test 3: t out of range. */
+    rc = intpl_bezier2(p2, -0.1f, &pt);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(pt.x) && isnan(pt.y));
+
+    /* Test 4: Batch evaluation keeps going past a bad t. */
+    rc = intpl_bezier_batch(p3, 3, t, out, 5);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(out[2].x));
+    rc = intpl_bezier3(p3, 0.75f, &pt);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(out[3].x == pt.x && out[3].y == pt.y);
+    rc = intpl_bezier_batch(p3, 4, t, out, 5);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 5: Filling a trajectory at even t. */
+    rc = intpl_bezier_fill(p2, 2, out, 9);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(out[8].x == p2[2].x && out[8].y == p2[2].y);
+    rc = intpl_bezier2(p2, 0.375f, &pt);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(out[3].x == pt.x && out[3].y == pt.y);
+}
+
+TEST_CASE(path_arc)
+{
+    int rc;
+    unsigned int i;
+    float d;
+    float dmin;
+    float dmax;
+    struct intpl_xy pt;
+    struct intpl_xy lut[64];
+    struct intpl_xy out[33];
+    struct intpl_bez_arc arc;
+    struct intpl_cursor cur;
+    struct intpl_xy line[4] = {
+        { 0.0f, 0.0f }, { 0.1f, 0.0f }, { 0.2f, 0.0f }, { 3.0f, 0.0f }
+    };
+    struct intpl_xy bend[4] = {
+        { 0.0f, 0.0f }, { 0.0f, 2.0f }, { 1.0f, 2.0f }, { 3.0f, 0.0f }
+    };
+
+    /* Test 1: Table too small, or bad degree. */
+    rc = intpl_bez_arc_init(&arc, line, 3, lut, 1);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    rc = intpl_bez_arc_init(&arc, line, 0, lut, 64);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /*
+     * Test 2: Control points bunched on a straight line move slowly at the
+     * start in t, but the arc length lookup gives x = distance.
+     */
+    rc = intpl_bez_arc_init(&arc, line, 3, lut, 64);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(arc.len, 3.0f, 1E-4F, "path_arc len"));
+    cur.idx = -1;
+    for (i = 0; i <= 30; i++) {
+        rc = intpl_bez_arc_at(&arc, i * 0.1f, &pt, &cur);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(pt.x, i * 0.1f, 5E-3F, "path_arc 2"));
+    }
+
+    /* Test 3: Out of range. */
+    rc = intpl_bez_arc_at(&arc, 3.5f, &pt, NULL);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(pt.x) && isnan(pt.y));
+
+    /* Test 4: Constant speed along a bend. */
+    rc = intpl_bez_arc_init(&arc, bend, 3, lut, 64);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_bez_arc_fill(&arc, out, 33);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(out[0].x == bend[0].x && out[0].y == bend[0].y);
+    TEST_ASSERT(f_is_equal(out[32].x, bend[3].x, 1E-5F, "path_arc 4x"));
+    TEST_ASSERT(f_is_equal(out[32].y, bend[3].y, 1E-5F, "path_arc 4y"));
+    dmin = dmax = hypotf(out[1].x - out[0].x, out[1].y - out[0].y);
+    for (i = 1; i < 32; i++) {
+        d = hypotf(out[i + 1].x - out[i].x, out[i + 1].y - out[i].y);
+        dmin = (d < dmin) ? d : dmin;
+        dmax = (d > dmax) ? d : dmax;
+    }
+    TEST_ASSERT(dmax - dmin < 0.01f * arc.len / 32);
+
+    /* Test 5: A curve collapsed to a point. */
+    for (i = 1; i < 4; i++) {
+        bend[i] = bend[0];
+    }
+    rc = intpl_bez_arc_init(&arc, bend, 3, lut, 8);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(arc.len == 0.0f);
+    rc = intpl_bez_arc_at(&arc, 0.0f, &pt, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(pt.x == bend[0].x && pt.y == bend[0].y);
+}
+
+TEST_CASE(path_poly)
+{
+    int rc;
+    unsigned int i;
+    float s[5];
+    struct intpl_xy pt;
+    struct intpl_xy out[8];
+    struct intpl_poly poly;
+    struct intpl_cursor cur;
+    struct intpl_xy pts[5] = {
+        { 0.0f, 0.0f }, { 3.0f, 0.0f }, { 3.0f, 0.0f }, { 3.0f, 4.0f },
+        { 2.0f, 4.0f }
+    };
+
+    /* Test 1: Too few points. */
+    rc = intpl_poly_init(&poly, pts, 1, s);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+
+    /* Test 2: Length, with a repeated point. */
+    rc = intpl_poly_init(&poly, pts, 5, s);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(poly.len, 8.0f, 1E-6F, "path_poly len"));
+
+    /* Test 3: Points by distance, across the corner. */
+    cur.idx = -1;
+    rc = intpl_poly_at(&poly, 2.5f, &pt, &cur);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(pt.x, 2.5f, 1E-6F, "path_poly 3a"));
+    rc = intpl_poly_at(&poly, 3.0f, &pt, &cur);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(pt.x, 3.0f, 1E-6F, "path_poly 3b"));
+    TEST_ASSERT(f_is_equal(pt.y, 0.0f, 1E-6F, "path_poly 3c"));
+    rc = intpl_poly_at(&poly, 5.0f, &pt, &cur);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(pt.x, 3.0f, 1E-6F, "path_poly 3d"));
+    TEST_ASSERT(f_is_equal(pt.y, 2.0f, 1E-6F, "path_poly 3e"));
+
+    /* Test 4: Out of range. */
+    rc = intpl_poly_at(&poly, -0.5f, &pt, NULL);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(pt.x) && isnan(pt.y));
+
+    /* Test 5: An evenly spaced trajectory. */
+    rc = intpl_poly_fill(&poly, out, 8);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 7; i++) {
+        rc = intpl_poly_at(&poly, i * 8.0f / 7.0f, &pt, NULL);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(out[i].x, pt.x, 1E-5F, "path_poly 5x"));
+        TEST_ASSERT(f_is_equal(out[i].y, pt.y, 1E-5F, "path_poly 5y"));
+    }
+    TEST_ASSERT(out[7].x == pts[4].x && out[7].y == pts[4].y);
+}
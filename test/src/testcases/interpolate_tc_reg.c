@@ -0,0 +1,160 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_reg.h"
+
+#define REG_TEST_PTS    (16)
+#define REG_TEST_NB     (4)
+
+static os_membuf_t reg_test_buf[OS_MEMPOOL_SIZE(3,
+    INTPL_REG_BLOCK_SIZE(REG_TEST_PTS, REG_TEST_NB))];
+
+/* The expected spline result, from a table built directly. */
+static float
+reg_test_ref(const struct intpl_reg_src *src, float x)
+{
+    unsigned int i;
+    float y;
+    struct intpl_xyc xyc[REG_TEST_PTS];
+
+    for (i = 0; i < src->n; i++) {
+        xyc[i].x = src->xy[i].x;
+        xyc[i].y = src->xy[i].y;
+    }
+    intpl_cubic_calc(xyc, src->n, src->yp1, src->ypn);
+    intpl_cubic_batch(xyc, src->n, &x, &y, 1, NULL);
+
+    return y;
+}
+
+TEST_CASE(reg)
+{
+    int rc;
+    unsigned int i;
+    unsigned int k;
+    float x[4] = { 0.0f, 1.5f, 9.0f, 3.25f };
+    float y[4];
+    float ref;
+    static struct intpl_xy xy[5][REG_TEST_PTS];
+    struct intpl_reg_src src[5];
+    struct intpl_reg reg;
+    const struct intpl_reg_ent *ent;
+
+    /* Five curves of 8 to 16 points, with IDs 10, 20, ... 50. */
+    for (k = 0; k < 5; k++) {
+        src[k].id = 10 * (k + 1);
+        src[k].xy = xy[k];
+        src[k].n = 8 + 2 * k;
+        src[k].yp1 = (k == 2) ? 0.0f : 1E30F;
+        src[k].ypn = 1E30F;
+        for (i = 0; i < src[k].n; i++) {
+            xy[k][i].x = i * 0.5f;
+            xy[k][i].y = (float)((i * (k + 3)) % 5) - k;
+        }
+    }
+
+    /* Test 1: Sources out of order, or too large for a block. */
+    rc = intpl_reg_init(&reg, src, 5, reg_test_buf, 3, 12, REG_TEST_NB);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    src[1].id = 5;
+    rc = intpl_reg_init(&reg, src, 5, reg_test_buf, 3, REG_TEST_PTS,
+        REG_TEST_NB);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    src[1].id = 20;
+    rc = intpl_reg_init(&reg, src, 5, reg_test_buf, 3, REG_TEST_PTS,
+        REG_TEST_NB);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 2: Unknown ID. */
+    rc = intpl_reg_cubic(&reg, 25, 1.0f, &y[0]);
+    TEST_ASSERT(rc == OS_ENOENT);
+    TEST_ASSERT(isnan(y[0]));
+    TEST_ASSERT(reg.misses == 0);
+
+    /* Test 3: Results match tables built directly, in every slot. */
+    for (k = 0; k < 5; k++) {
+        for (i = 0; i <= 14; i++) {
+            if (i * 0.25f > xy[k][src[k].n - 1].x) {
+                break;
+            }
+            rc = intpl_reg_cubic(&reg, src[k].id, i * 0.25f, &y[0]);
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(y[0] == reg_test_ref(&src[k], i * 0.25f));
+            rc = intpl_reg_lin_y(&reg, src[k].id, i * 0.25f, &y[0]);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = intpl_lin_y_arr(xy[k], src[k].n, i * 0.25f, &ref);
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(y[0] == ref);
+        }
+    }
+    TEST_ASSERT(reg.misses == 5);
+    TEST_ASSERT(reg.evictions == 2);
+
+    /* Test 4: Least recently used goes first. 30, 40, 50 are built. */
+    reg.hits = reg.misses = reg.evictions = 0;
+    rc = intpl_reg_get(&reg, 30, &ent);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ent->src == &src[2]);
+    rc = intpl_reg_get(&reg, 10, &ent);     /* Drops 40. */
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_reg_get(&reg, 50, &ent);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_reg_get(&reg, 30, &ent);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(reg.hits == 3 && reg.misses == 1 && reg.evictions == 1);
+    rc = intpl_reg_get(&reg, 40, &ent);     /* Drops 10. */
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_reg_get(&reg, 50, &ent);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(reg.hits == 4 && reg.misses == 2 && reg.evictions == 2);
+    TEST_ASSERT(reg.mru->src->id == 50 && reg.lru->src->id == 30);
+
+    /* Test 5: A batch, with one value out of range. */
+    rc = intpl_reg_cubic_batch(&reg, 20, x, y, 4);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[2]));
+    TEST_ASSERT(y[3] == reg_test_ref(&src[1], x[3]));
+
+    /* Test 6: Flushing returns every block to the pool. */
+    intpl_reg_flush(&reg);
+    TEST_ASSERT(reg.mru == NULL && reg.lru == NULL);
+    TEST_ASSERT(reg.pool.mp_num_free == 3);
+    reg.misses = 0;
+    rc = intpl_reg_cubic(&reg, 20, 1.0f, &y[0]);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(reg.misses == 1);
+
+    /* Test 7: A two point table has linear lookups, but no spline. */
+    src[0].n = 2;
+    rc = intpl_reg_init(&reg, src, 1, reg_test_buf, 3, 2, REG_TEST_NB);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_reg_lin_y(&reg, 10, 0.25f, &y[0]);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_lin_y_arr(xy[0], 2, 0.25f, &ref);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(y[0] == ref);
+    rc = intpl_reg_cubic(&reg, 10, 0.25f, &y[0]);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]));
+    rc = intpl_reg_cubic_batch(&reg, 10, x, y, 2);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]) && isnan(y[1]));
+    TEST_ASSERT(reg.misses == 1);
+}
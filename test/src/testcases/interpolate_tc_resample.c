@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_resample.h"
+
+TEST_CASE(resample_lin)
+{
+    int rc;
+    unsigned int i;
+    float x[300];
+    float y[300];
+    float yu[300];
+    float ref;
+    struct intpl_xy src[50];
+
+    for (i = 0; i < 50; i++) {
+        src[i].x = (float)(i * i) * 0.1f;
+        src[i].y = cosf((float)i * 0.3f);
+    }
+
+    /* Test 1: Ascending destination, running past both ends. */
+    for (i = 0; i < 300; i++) {
+        x[i] = -5.0f + (float)i * 0.85f;
+    }
+    rc = intpl_resample(src, 50, INTPL_RS_LIN, x, y, 300);
+    TEST_ASSERT(rc == OS_EINVAL);
+    for (i = 0; i < 300; i++) {
+        if (intpl_lin_y_arr(src, 50, x[i], &ref)) {
+            TEST_ASSERT(isnan(y[i]));
+        } else {
+            TEST_ASSERT(f_is_equal(y[i], ref, 1E-5F, "resample_lin 1"));
+        }
+    }
+
+    /* Test 2: The uniform path gives the same values. */
+    rc = intpl_resample_uni(src, 50, INTPL_RS_LIN, -5.0f, 0.85f, yu, 300);
+    TEST_ASSERT(rc == OS_EINVAL);
+    for (i = 0; i < 300; i++) {
+        TEST_ASSERT((isnan(y[i]) && isnan(yu[i])) || y[i] == yu[i]);
+    }
+
+    /* Test 3: Destination values going backwards. */
+    for (i = 0; i < 100; i++) {
+        x[i] = 240.0f - (float)i * 2.4f;
+    }
+    rc = intpl_resample(src, 50, INTPL_RS_LIN, x, y, 100);
+    TEST_ASSERT(rc == 0);
+    for (i = 0; i < 100; i++) {
+        rc = intpl_lin_y_arr(src, 50, x[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[i], ref, 1E-5F, "resample_lin 3"));
+    }
+
+    /* Test 4: Invalid source and step. */
+    src[10].x = src[9].x;
+    rc = intpl_resample(src, 50, INTPL_RS_LIN, x, y, 100);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]));
+    rc = intpl_resample_uni(src, 9, INTPL_RS_LIN, 0.0f, 0.0f, y, 100);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y[0]));
+}
+
+TEST_CASE(resample_nn)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    unsigned int best;
+    float y[500];
+    float xv;
+    struct intpl_xy src[40];
+
+    for (i = 0; i < 40; i++) {
+        src[i].x = (float)i + 0.3f * sinf((float)i);
+        src[i].y = (float)i;
+    }
+
+    /* Test 1: Matches a brute force nearest neighbour search. */
+    rc = intpl_resample_uni(src, 40, INTPL_RS_NN, 0.0f, 0.077f, y, 500);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 500; i++) {
+        xv = (float)i * 0.077f;
+        best = 0;
+        for (j = 1; j < 40; j++) {
+            if (fabsf(src[j].x - xv) < fabsf(src[best].x - xv)) {
+                best = j;
+            }
+        }
+        TEST_ASSERT(y[i] == src[best].y);
+    }
+}
+
+TEST_CASE(resample_cubic)
+{
+    int rc;
+    unsigned int i;
+    float x[200];
+    float y[200];
+    float yu[200];
+    float ref;
+    struct intpl_xyc src[30];
+
+    for (i = 0; i < 30; i++) {
+        src[i].x = (float)i * 0.5f + 0.01f * (float)(i * i);
+        src[i].y = sinf(src[i].x);
+    }
+    rc = intpl_cubic_calc(src, 30, 1e30f, 1e30f);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Matches intpl_cubic_arr, including the last x value. */
+    for (i = 0; i < 200; i++) {
+        x[i] = (float)i * (src[29].x / 199.0f);
+    }
+    x[199] = src[29].x;
+    rc = intpl_resample_cubic(src, 30, x, y, 200);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 200; i++) {
+        rc = intpl_cubic_arr(src, 30, x[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[i], ref, 1E-5F, "resample_cubic 1"));
+    }
+
+    /* Test 2: Uniform destination. */
+    rc = intpl_resample_cubic_uni(src, 30, 0.0f, 0.1f, yu, 100);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 100; i++) {
+        rc = intpl_cubic_arr(src, 30, (float)i * 0.1f, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(yu[i], ref, 1E-5F, "resample_cubic 2"));
+    }
+}
+
+TEST_CASE(resample_cubic_fd)
+{
+    int rc;
+    unsigned int i;
+    float y[2000];
+    float ref[2000];
+    float err;
+    struct intpl_xyc src[12];
+
+    for (i = 0; i < 12; i++) {
+        src[i].x = (float)(i * i);
+        src[i].y = 100.0f * sinf((float)i * 0.6f);
+    }
+    rc = intpl_cubic_calc(src, 12, 1e30f, 1e30f);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Long segments, with the step not dividing the segments. */
+    rc = intpl_resample_cubic_fd(src, 12, -1.0f, 0.0613f, y, 2000);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_resample_cubic_uni(src, 12, -1.0f, 0.0613f, ref, 2000);
+    TEST_ASSERT(rc == OS_EINVAL);
+    err = 0.0f;
+    for (i = 0; i < 2000; i++) {
+        TEST_ASSERT(isnan(y[i]) == isnan(ref[i]));
+        if (!isnan(ref[i]) && fabsf(y[i] - ref[i]) > err) {
+            err = fabsf(y[i] - ref[i]);
+        }
+    }
+    TEST_ASSERT(isnan(y[0]) && !isnan(y[17]) && isnan(y[1999]));
+    TEST_ASSERT(err < 1E-3F);
+
+    /* Test 2: More values than INTPL_RS_FD_RESYNC in a single segment. */
+    rc = intpl_resample_cubic_fd(src, 12, 100.0f, 0.001f, y, 2000);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_resample_cubic_uni(src, 12, 100.0f, 0.001f, ref, 2000);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 2000; i++) {
+        TEST_ASSERT(f_is_equal(y[i], ref[i], 1E-3F, "resample_cubic_fd 2"));
+    }
+}
+
+TEST_CASE(resample_mono)
+{
+    int rc;
+    unsigned int i;
+    float y[400];
+    struct intpl_xy src[8] = {
+        { 0.0f, 0.0f }, { 1.0f, 0.1f }, { 2.0f, 0.1f }, { 2.5f, 5.0f },
+        { 4.0f, 5.2f }, { 5.0f, 9.0f }, { 7.0f, 9.0f }, { 8.0f, 9.5f },
+    };
+
+    /* Test 1: Monotone data stays monotone, without overshoot. */
+    rc = intpl_resample_uni(src, 8, INTPL_RS_MONO, 0.0f, 0.02f, y, 400);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 1; i < 400; i++) {
+        TEST_ASSERT(y[i] >= y[i-1]);
+    }
+
+    /* Test 2: Flat sections stay flat, and the curve passes the knots. */
+    for (i = 50; i <= 100; i++) {
+        TEST_ASSERT(f_is_equal(y[i], 0.1f, 1E-6F, "resample_mono 2"));
+    }
+    TEST_ASSERT(f_is_equal(y[125], 5.0f, 1E-5F, "resample_mono 2"));
+    TEST_ASSERT(f_is_equal(y[250], 9.0f, 1E-5F, "resample_mono 2"));
+}
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_ring.h"
+
+TEST_CASE(ring)
+{
+    int rc;
+    unsigned int i;
+    unsigned int j;
+    unsigned int best;
+    float x;
+    float y;
+    float ref;
+    struct intpl_xy buf[16];
+    struct intpl_xy lin[16];
+    struct intpl_ring ring;
+
+    rc = intpl_ring_init(&ring, buf, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Too few samples, and timestamps going backwards. */
+    rc = intpl_ring_lin_y(&ring, 0.0f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    TEST_ASSERT(intpl_ring_push(&ring, 1.0f, 1.0f) == 0);
+    TEST_ASSERT(intpl_ring_push(&ring, 1.0f, 2.0f) == OS_EINVAL);
+    TEST_ASSERT(intpl_ring_pop(&ring) == 0);
+    TEST_ASSERT(intpl_ring_pop(&ring) == OS_ENOENT);
+
+    /* Test 2: Wrap around several times, and compare lookups against a
+     * linear copy of the ring. */
+    for (i = 0; i < 100; i++) {
+        x = (float)i * 0.5f + 0.01f * (float)(i % 7);
+        rc = intpl_ring_push(&ring, x, sinf(x));
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    TEST_ASSERT(ring.cnt == 16);
+    for (i = 0; i < 16; i++) {
+        lin[i] = *intpl_ring_at(&ring, i);
+    }
+    TEST_ASSERT(intpl_ring_at(&ring, 16) == NULL);
+    for (x = lin[0].x; x <= lin[15].x; x += 0.037f) {
+        rc = intpl_ring_lin_y(&ring, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_lin_y_arr(lin, 16, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(y == ref);
+        rc = intpl_ring_nn(&ring, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        best = 0;
+        for (j = 1; j < 16; j++) {
+            if (fabsf(lin[j].x - x) <= fabsf(lin[best].x - x)) {
+                best = j;
+            }
+        }
+        TEST_ASSERT(y == lin[best].y);
+    }
+
+    /* Test 3: Newest timestamp, and lookups going back in time. */
+    rc = intpl_ring_lin_y(&ring, lin[15].x, &y);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(y == lin[15].y);
+    rc = intpl_ring_lin_y(&ring, lin[2].x, &y);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(y == lin[2].y);
+    rc = intpl_ring_lin_y(&ring, lin[0].x - 0.1f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 4: Evicting old samples keeps the cursor valid. */
+    rc = intpl_ring_lin_y(&ring, lin[6].x + 0.1f, &y);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(intpl_ring_evict(&ring, lin[4].x) == 4);
+    TEST_ASSERT(ring.cur.idx == 2);
+    rc = intpl_ring_lin_y(&ring, lin[6].x + 0.2f, &y);
+    TEST_ASSERT(rc == 0);
+    rc = intpl_lin_y_arr(lin, 16, lin[6].x + 0.2f, &ref);
+    TEST_ASSERT(y == ref);
+}
+
+TEST_CASE(ring_cubic)
+{
+    int rc;
+    unsigned int i;
+    float x;
+    float y;
+    struct intpl_xy buf[10];
+    struct intpl_ring ring;
+
+    rc = intpl_ring_init(&ring, buf, 10);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Quadratic data is reproduced away from the ends. */
+    for (i = 0; i < 25; i++) {
+        x = (float)i + 0.3f * (float)(i % 3);
+        rc = intpl_ring_push(&ring, x, 0.5f * x * x - x + 2.0f);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    for (x = intpl_ring_at(&ring, 1)->x; x <= intpl_ring_at(&ring, 8)->x;
+         x += 0.05f) {
+        rc = intpl_ring_cubic(&ring, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y, 0.5f * x * x - x + 2.0f, 1E-3F,
+            "ring_cubic 1"));
+    }
+
+    /* Test 2: The curve passes through the samples. */
+    for (i = 0; i < 10; i++) {
+        rc = intpl_ring_cubic(&ring, intpl_ring_at(&ring, i)->x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y, intpl_ring_at(&ring, i)->y, 1E-4F,
+            "ring_cubic 2"));
+    }
+}
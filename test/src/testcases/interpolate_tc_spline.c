@@ -0,0 +1,226 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_spline.h"
+
+/* f(x) = x^3 - 2x^2 + 1, which a clamped spline reproduces exactly. */
+static float
+spline_f(float x)
+{
+    return x * x * x - 2.0f * x * x + 1.0f;
+}
+
+static float
+spline_fi(float x)
+{
+    return 0.25f * x * x * x * x - (2.0f / 3.0f) * x * x * x + x;
+}
+
+static void
+spline_setup(struct intpl_xyc xyc[], unsigned int n)
+{
+    int rc;
+    unsigned int i;
+
+    for (i = 0; i < n; i++) {
+        xyc[i].x = -1.0f + 0.15f * (float)i + 0.002f * (float)(i * i);
+        xyc[i].y = spline_f(xyc[i].x);
+    }
+    rc = intpl_cubic_calc(xyc, n,
+        3.0f * xyc[0].x * xyc[0].x - 4.0f * xyc[0].x,
+        3.0f * xyc[n-1].x * xyc[n-1].x - 4.0f * xyc[n-1].x);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+TEST_CASE(spline_deriv)
+{
+    int rc;
+    unsigned int i;
+    float x[50];
+    float d1[50];
+    float d2[50];
+    float v;
+    struct intpl_xyc xyc[20];
+
+    spline_setup(xyc, 20);
+
+    /* Test 1: Scalar and batch derivatives match the analytic ones. */
+    for (i = 0; i < 50; i++) {
+        x[i] = -1.0f + (float)i * 0.07f;
+    }
+    rc = intpl_cubic_d1_batch(xyc, 20, x, d1, 50, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_d2_batch(xyc, 20, x, d2, 50, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 50; i++) {
+        TEST_ASSERT(f_is_equal(d1[i], 3.0f * x[i] * x[i] - 4.0f * x[i],
+            1E-3F, "spline_deriv 1"));
+        TEST_ASSERT(f_is_equal(d2[i], 6.0f * x[i] - 4.0f, 1E-2F,
+            "spline_deriv 1"));
+        rc = intpl_cubic_d1(xyc, 20, x[i], &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(v == d1[i]);
+        rc = intpl_cubic_d2(xyc, 20, x[i], &v);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(v == d2[i]);
+    }
+
+    /* Test 2: Out of range. */
+    rc = intpl_cubic_d1(xyc, 20, -2.0f, &v);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(v));
+    x[3] = 100.0f;
+    rc = intpl_cubic_d2_batch(xyc, 20, x, d2, 50, NULL);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(d2[3]) && !isnan(d2[4]));
+}
+
+TEST_CASE(spline_integral)
+{
+    int rc;
+    unsigned int i;
+    float a[20];
+    float b[20];
+    float res[20];
+    float cum[20];
+    float v;
+    struct intpl_xyc xyc[20];
+
+    spline_setup(xyc, 20);
+    rc = intpl_cubic_cum(xyc, 20, cum);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: The cumulative array holds the integral to each knot. */
+    for (i = 0; i < 20; i++) {
+        TEST_ASSERT(f_is_equal(cum[i], spline_fi(xyc[i].x) -
+            spline_fi(xyc[0].x), 1E-4F, "spline_integral 1"));
+    }
+
+    /* Test 2: Integrals between arbitrary limits, in either direction. */
+    for (i = 0; i < 20; i++) {
+        a[i] = -0.95f + (float)i * 0.11f;
+        b[i] = 2.5f - (float)i * 0.17f;
+    }
+    rc = intpl_cubic_integral_batch(xyc, 20, cum, a, b, res, 20);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 20; i++) {
+        TEST_ASSERT(f_is_equal(res[i], spline_fi(b[i]) - spline_fi(a[i]),
+            1E-4F, "spline_integral 2"));
+    }
+
+    /* Test 3: Empty interval, and limits out of range. */
+    rc = intpl_cubic_integral(xyc, 20, cum, 0.3f, 0.3f, &v);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(v == 0.0f);
+    rc = intpl_cubic_integral(xyc, 20, cum, 0.3f, 10.0f, &v);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(v));
+}
+
+/* A smooth function with period 2 pi. */
+static float
+spline_p(float x)
+{
+    return sinf(x) + 0.5f * cosf(2.0f * x);
+}
+
+TEST_CASE(spline_periodic)
+{
+    int rc;
+    unsigned int i;
+    float p;
+    float x;
+    float y;
+    float y0;
+    float yl;
+    float yr;
+    float xs[40];
+    float ys[40];
+    struct intpl_xyc xyc[16];
+
+    /* Uneven knots over one period, starting away from zero. */
+    p = 2.0f * (float)M_PI;
+    for (i = 0; i < 16; i++) {
+        xyc[i].x = 0.3f + p * (i + 0.3f * (i % 3)) / 16.0f;
+        xyc[i].y = spline_p(xyc[i].x);
+    }
+
+    /* Test 1: Invalid input. */
+    rc = intpl_cubic_calc_periodic(xyc, 2, p);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_cubic_calc_periodic(xyc, 16, xyc[15].x - xyc[0].x);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    rc = intpl_cubic_calc_periodic(xyc, 16, p);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 2: Knots are hit exactly, and the curve follows f everywhere. */
+    for (i = 0; i < 16; i++) {
+        rc = intpl_cubic_periodic(xyc, 16, p, xyc[i].x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y, xyc[i].y, 1E-6F, "periodic knot"));
+    }
+    for (i = 0; i <= 200; i++) {
+        x = -10.0f + i * 0.1f;
+        rc = intpl_cubic_periodic(xyc, 16, p, x, &y);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y, spline_p(x), 2E-2F, "periodic f"));
+        rc = intpl_cubic_periodic(xyc, 16, p, x + p, &y0);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y, y0, 1E-4F, "periodic wrap"));
+    }
+
+    /* Test 3: No kink where the table wraps around. */
+    rc = intpl_cubic_periodic(xyc, 16, p, xyc[0].x, &y0);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_periodic(xyc, 16, p, xyc[0].x - 1E-3F, &yl);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_periodic(xyc, 16, p, xyc[0].x + 1E-3F, &yr);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal((y0 - yl) / 1E-3F, (yr - y0) / 1E-3F, 1E-2F,
+        "periodic slope"));
+
+    /* Test 4: Batch lookups match, and bad values are NAN. */
+    for (i = 0; i < 40; i++) {
+        xs[i] = -3.0f + i * 0.37f;
+    }
+    xs[7] = NAN;
+    rc = intpl_cubic_periodic_batch(xyc, 16, p, xs, ys, 40, NULL);
+    TEST_ASSERT(rc == OS_EINVAL);
+    for (i = 0; i < 40; i++) {
+        rc = intpl_cubic_periodic(xyc, 16, p, xs[i], &y);
+        if (i == 7) {
+            TEST_ASSERT(rc == OS_EINVAL);
+            TEST_ASSERT(isnan(ys[i]) && isnan(y));
+        } else {
+            TEST_ASSERT(ys[i] == y);
+        }
+    }
+
+    /* Test 5: Constant data gives a flat spline. */
+    for (i = 0; i < 16; i++) {
+        xyc[i].y = 2.5f;
+    }
+    rc = intpl_cubic_calc_periodic(xyc, 16, p);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 16; i++) {
+        TEST_ASSERT(fabsf(xyc[i].y2) < 1E-5F);
+    }
+}
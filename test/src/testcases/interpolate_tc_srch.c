@@ -0,0 +1,261 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_srch.h"
+
+TEST_CASE(srch_bkt)
+{
+    int rc;
+    int idx;
+    int ref;
+    unsigned int i;
+    unsigned int k;
+    float x;
+    uint32_t buf[33];
+    struct intpl_xy xy[256];
+    struct intpl_xy xyd[256];
+    struct intpl_bkt bkt;
+    struct intpl_bkt bktd;
+    struct intpl_srch srch;
+
+    /* Log-spaced table from 20 Hz to 20 kHz, and a descending copy. */
+    for (i = 0; i < 256; i++) {
+        xy[i].x = 20.0f * powf(1000.0f, (float)i / 255.0f);
+        xy[i].y = (float)i;
+        xyd[255-i] = xy[i];
+    }
+
+    /* Test 1: Memory overhead. */
+    TEST_ASSERT(intpl_bkt_size(32) == sizeof(buf));
+
+    /* Test 2: Invalid arguments. */
+    rc = intpl_bkt_init_xy(&bkt, buf, sizeof(buf) - 1, xy, 256, 32);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_bkt_init_xy(&bkt, buf, sizeof(buf), xy, 256, 0);
+    TEST_ASSERT(rc == OS_EINVAL);
+    rc = intpl_srch_init(&srch, INTPL_SRCH_BUCKET, NULL);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 3: Every strategy matches intpl_find_x, ascending. */
+    rc = intpl_bkt_init_xy(&bkt, buf, sizeof(buf), xy, 256, 32);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (k = INTPL_SRCH_BISECT; k <= INTPL_SRCH_BUCKET; k++) {
+        rc = intpl_srch_init(&srch, k, &bkt);
+        TEST_ASSERT_FATAL(rc == 0);
+        for (i = 0; i <= 4000; i++) {
+            x = 10.0f + (float)i * 5.0f;
+            ref = 0;
+            rc = intpl_find_x(xy, 256, x, &ref);
+            TEST_ASSERT_FATAL(intpl_find_x_srch(xy, 256, x, &srch, &idx) == rc);
+            if (rc == 0) {
+                TEST_ASSERT(idx == ref);
+            }
+        }
+        for (i = 0; i < 256; i++) {
+            rc = intpl_find_x(xy, 256, xy[i].x, &ref);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = intpl_find_x_srch(xy, 256, xy[i].x, &srch, &idx);
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(idx == ref);
+        }
+    }
+
+    /* Test 4: The bucket index also works on descending tables. */
+    rc = intpl_bkt_init_xy(&bktd, buf, sizeof(buf), xyd, 256, 32);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &bktd);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 256; i++) {
+        x = xyd[i].x * 1.001f;
+        rc = intpl_find_x(xyd, 256, x, &ref);
+        TEST_ASSERT_FATAL(intpl_find_x_srch(xyd, 256, x, &srch, &idx) == rc);
+        if (rc == 0) {
+            TEST_ASSERT(idx == ref);
+        }
+    }
+
+    /* Test 5: An index built for another table size is rejected. */
+    rc = intpl_find_x_srch(xyd, 128, 100.0f, &srch, &idx);
+    TEST_ASSERT(rc == OS_EINVAL);
+}
+
+TEST_CASE(srch_eval)
+{
+    int rc;
+    unsigned int i;
+    float x;
+    float y;
+    float ref;
+    uint32_t buf[17];
+    uint32_t bufc[17];
+    struct intpl_xy xy[64];
+    struct intpl_xyc xyc[64];
+    struct intpl_bkt bkt;
+    struct intpl_bkt bktc;
+    struct intpl_srch srch;
+    struct intpl_srch srchc;
+
+    for (i = 0; i < 64; i++) {
+        xy[i].x = xyc[i].x = powf(1.1f, (float)i);
+        xy[i].y = xyc[i].y = sinf((float)i * 0.2f);
+    }
+    rc = intpl_cubic_calc(xyc, 64, 1e30f, 1e30f);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = intpl_bkt_init_xy(&bkt, buf, sizeof(buf), xy, 64, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_srch_init(&srch, INTPL_SRCH_BUCKET, &bkt);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Linear and nearest neighbour match the _arr functions. */
+    for (i = 0; i < 200; i++) {
+        x = 1.0f + (float)i * 2.0f;
+        rc = intpl_lin_y_arr(xy, 64, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_lin_y_srch(xy, 64, x, &y, &srch);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(y == ref);
+        rc = intpl_nn_arr(xy, 64, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_nn_srch(xy, 64, x, &y, &srch);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(y == ref);
+    }
+
+    /* Test 2: Cubic matches intpl_cubic_arr, with a separate index. */
+    rc = intpl_bkt_init_xyc(&bktc, bufc, sizeof(bufc), xyc, 64, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_srch_init(&srchc, INTPL_SRCH_BUCKET, &bktc);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 200; i++) {
+        x = 1.0f + (float)i * 2.0f;
+        rc = intpl_cubic_arr(xyc, 64, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_cubic_srch(xyc, 64, x, &y, &srchc);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(y == ref);
+    }
+
+    /* Test 3: Out of range. */
+    rc = intpl_lin_y_srch(xy, 64, 0.5f, &y, &srch);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    rc = intpl_cubic_srch(xyc, 2, 1.5f, &y, &srch);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+}
+
+/* Runs 'cnt' lookups through 'srch', checking them against intpl_find_x.
+ * Sequential lookups step through the table, others use an LCG. */
+static void
+srch_auto_run(struct intpl_xy xy[], unsigned int n, struct intpl_srch *srch,
+    int sequential, unsigned int cnt)
+{
+    int rc;
+    int idx;
+    int ref;
+    unsigned int i;
+    uint32_t seed;
+    float x;
+    float span;
+
+    seed = 12345;
+    span = xy[n-1].x - xy[0].x;
+    for (i = 0; i < cnt; i++) {
+        if (sequential) {
+            x = xy[0].x + span * (float)(i % 1000) / 1000.0f;
+        } else {
+            seed = seed * 1664525u + 1013904223u;
+            x = xy[0].x + span * (float)(seed >> 8) / 16777216.0f;
+        }
+        rc = intpl_find_x(xy, n, x, &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        rc = intpl_find_x_srch(xy, n, x, srch, &idx);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(idx == ref);
+    }
+}
+
+TEST_CASE(srch_auto)
+{
+    int rc;
+    unsigned int i;
+    uint32_t buf[65];
+    struct intpl_xy lin[512];
+    struct intpl_xy log[512];
+    struct intpl_bkt bkt;
+    struct intpl_srch srch;
+    struct intpl_srch_diag diag;
+
+    for (i = 0; i < 512; i++) {
+        lin[i].x = (float)i * 0.25f;
+        log[i].x = 20.0f * powf(1000.0f, (float)i / 511.0f);
+        lin[i].y = log[i].y = (float)i;
+    }
+    rc = intpl_bkt_init_xy(&bkt, buf, sizeof(buf), log, 512, 64);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Sequential lookups select the cursor. */
+    rc = intpl_srch_init(&srch, INTPL_SRCH_AUTO, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    srch_auto_run(log, 512, &srch, 1, 4 * INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.kind == INTPL_SRCH_AUTO);
+    TEST_ASSERT(diag.active == INTPL_SRCH_CURSOR);
+    TEST_ASSERT(diag.hit_pct >= 75);
+    TEST_ASSERT(diag.queries == 4 * INTPL_SRCH_WINDOW);
+
+    /* Test 2: Random lookups switch to the bucket index when there is one. */
+    rc = intpl_srch_init(&srch, INTPL_SRCH_AUTO, &bkt);
+    TEST_ASSERT_FATAL(rc == 0);
+    srch_auto_run(log, 512, &srch, 0, 4 * INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.active == INTPL_SRCH_BUCKET);
+    TEST_ASSERT(diag.switches == 1);
+
+    /* Test 3: ... to interpolation search on uniform tables ... */
+    rc = intpl_srch_init(&srch, INTPL_SRCH_AUTO, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    srch_auto_run(lin, 512, &srch, 0, 4 * INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.active == INTPL_SRCH_GUESS);
+    TEST_ASSERT(diag.guess_pct >= 75);
+
+    /* Test 4: ... and to bisection otherwise. */
+    rc = intpl_srch_init(&srch, INTPL_SRCH_AUTO, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    srch_auto_run(log, 512, &srch, 0, 4 * INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.active == INTPL_SRCH_BISECT);
+
+    /* Test 5: The profile follows a change in the query pattern. */
+    srch_auto_run(log, 512, &srch, 1, 4 * INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.active == INTPL_SRCH_CURSOR);
+    TEST_ASSERT(diag.switches >= 2);
+
+    /* Test 6: Fixed strategies report themselves, with no profile. */
+    rc = intpl_srch_init(&srch, INTPL_SRCH_GALLOP, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    srch_auto_run(log, 512, &srch, 0, INTPL_SRCH_WINDOW);
+    intpl_srch_diag(&srch, &diag);
+    TEST_ASSERT(diag.active == INTPL_SRCH_GALLOP);
+    TEST_ASSERT(diag.queries == 0);
+}
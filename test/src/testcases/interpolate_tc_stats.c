@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_stats.h"
+
+TEST_CASE(stats)
+{
+#if MYNEWT_VAL(INTERPOLATE_STATS)
+    int rc;
+    float y;
+    struct intpl_xy xy[4];
+    struct intpl_xyc xyc[4];
+
+    memset(xyc, 0, sizeof xyc);
+    xy[0].x = xyc[0].x = 0.0f;
+    xy[0].y = xyc[0].y = 1.0f;
+    xy[1].x = xyc[1].x = 1.0f;
+    xy[1].y = xyc[1].y = 2.0f;
+    xy[2].x = xyc[2].x = 2.0f;
+    xy[2].y = xyc[2].y = 0.0f;
+    xy[3].x = xyc[3].x = 3.0f;
+    xy[3].y = xyc[3].y = 4.0f;
+
+    rc = intpl_stats_reset();
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Calls, searches and out of range errors are counted. */
+    rc = intpl_lin_y_arr(xy, 4, 1.5f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_lin_y_arr(xy, 4, 3.5f, &y);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(g_intpl_stats.lin_y_arr == 2);
+    TEST_ASSERT(g_intpl_stats.lin_y == 1);
+    TEST_ASSERT(g_intpl_stats.search == 2);
+    TEST_ASSERT(g_intpl_stats.search_iter == 2);
+    TEST_ASSERT(g_intpl_stats.einval_range == 1);
+
+    /* Test 2: Too few samples. */
+    rc = intpl_cubic_calc(xyc, 2, 1e30, 1e30);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(g_intpl_stats.einval_size == 1);
+
+    /* Test 3: The pklo/pkhi shortcut only hits in the first segment. */
+    rc = intpl_cubic_calc(xyc, 4, 1e30, 1e30);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_arr(xyc, 4, 0.5f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_cubic_arr(xyc, 4, 2.5f, &y);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(g_intpl_stats.hint_hit == 1);
+    TEST_ASSERT(g_intpl_stats.hint_miss == 1);
+    TEST_ASSERT(g_intpl_stats.cubic_calc == 2);
+
+    rc = intpl_stats_dump();
+    TEST_ASSERT(rc == 0);
+#endif
+}
@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_par.h"
+#include "interpolate/interpolate_svc.h"
+
+struct svc_test {
+    struct intpl_svc svc;
+#if !MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    struct os_eventq evq;
+#endif
+    struct intpl_xy xy[16];
+    struct intpl_xyc xyc[16];
+    unsigned int called;
+    unsigned int bad;
+};
+
+static void
+svc_test_cb(struct intpl_svc_req *req)
+{
+    struct svc_test *st;
+
+    st = (struct svc_test *)req->arg;
+    __atomic_add_fetch(&st->called, 1, __ATOMIC_SEQ_CST);
+}
+
+/* Waits for requests, or runs the service here when it has no thread. */
+static void
+svc_test_wait(struct svc_test *st, struct intpl_svc_req req[],
+    unsigned int cnt)
+{
+    unsigned int i;
+
+    for (i = 0; i < cnt; i++) {
+#if MYNEWT_VAL(INTERPOLATE_PTHREAD)
+        intpl_svc_wait(&st->svc, &req[i]);
+#else
+        while (!intpl_svc_done(&req[i])) {
+            os_eventq_run(&st->evq);
+        }
+#endif
+    }
+}
+
+static void
+svc_test_init(struct svc_test *st)
+{
+    unsigned int i;
+
+    for (i = 0; i < 16; i++) {
+        st->xy[i].x = st->xyc[i].x = i * 0.5f;
+        st->xy[i].y = st->xyc[i].y = (float)(i * i % 7);
+    }
+    intpl_cubic_calc(st->xyc, 16, 1E30F, 1E30F);
+    st->called = 0;
+    st->bad = 0;
+#if !MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    os_eventq_init(&st->evq);
+    intpl_svc_init(&st->svc, &st->evq);
+#else
+    intpl_svc_init(&st->svc, NULL);
+#endif
+}
+
+/* The expected result of a request, from a batch of one. */
+static int
+svc_test_ref(struct svc_test *st, const struct intpl_svc_req *req, float *y)
+{
+    switch (req->kind) {
+    case INTPL_SVC_NN:
+        return intpl_nn_batch(st->xy, 16, &req->x, y, 1, NULL);
+    case INTPL_SVC_LIN_Y:
+        return intpl_lin_y_batch(st->xy, 16, &req->x, y, 1, NULL);
+    default:
+        return intpl_cubic_batch(st->xyc, 16, &req->x, y, 1, NULL);
+    }
+}
+
+static void
+svc_test_fill(struct svc_test *st, struct intpl_svc_req *req,
+    unsigned int i, unsigned int seed)
+{
+    req->kind = (i + seed) % 3;
+    req->tbl = (req->kind == INTPL_SVC_CUBIC) ? (void *)st->xyc :
+        (void *)st->xy;
+    req->n = 16;
+    /* Scattered, not sorted. */
+    req->x = (float)((i * 37 + seed * 11) % 75) * 0.1f;
+    req->cb = svc_test_cb;
+    req->arg = st;
+}
+
+static void
+svc_test_fn(void *arg, unsigned int part, unsigned int nparts)
+{
+    int rc;
+    unsigned int i;
+    unsigned int k;
+    float y;
+    struct svc_test *st;
+    struct intpl_svc_req req[16];
+
+    (void)nparts;
+
+    st = (struct svc_test *)arg;
+    for (k = 0; k < 50; k++) {
+        for (i = 0; i < 16; i++) {
+            svc_test_fill(st, &req[i], i, part * 50 + k);
+            rc = intpl_svc_submit(&st->svc, &req[i]);
+            if (rc) {
+                __atomic_add_fetch(&st->bad, 1, __ATOMIC_SEQ_CST);
+            }
+        }
+        svc_test_wait(st, req, 16);
+        for (i = 0; i < 16; i++) {
+            rc = svc_test_ref(st, &req[i], &y);
+            if (rc != req[i].rc || (rc == 0 && y != req[i].y)) {
+                __atomic_add_fetch(&st->bad, 1, __ATOMIC_SEQ_CST);
+            }
+        }
+    }
+}
+
+TEST_CASE(svc)
+{
+    int rc;
+    unsigned int i;
+    float y;
+    static struct svc_test st;
+    struct intpl_svc_req req[40];
+
+    svc_test_init(&st);
+
+    /* Test 1: Invalid requests are refused. */
+    svc_test_fill(&st, &req[0], 0, 0);
+    req[0].kind = 3;
+    rc = intpl_svc_submit(&st.svc, &req[0]);
+    TEST_ASSERT(rc == OS_EINVAL);
+    req[0].kind = INTPL_SVC_LIN_Y;
+    req[0].tbl = NULL;
+    rc = intpl_svc_submit(&st.svc, &req[0]);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 2: Mixed tables and lookups, one out of range, no callback. */
+    for (i = 0; i < 40; i++) {
+        svc_test_fill(&st, &req[i], i, 0);
+    }
+    req[5].x = 8.0f;
+    req[6].cb = NULL;
+    for (i = 0; i < 40; i++) {
+        rc = intpl_svc_submit(&st.svc, &req[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    svc_test_wait(&st, req, 40);
+    TEST_ASSERT(st.called == 39);
+    for (i = 0; i < 40; i++) {
+        TEST_ASSERT(intpl_svc_done(&req[i]));
+        rc = svc_test_ref(&st, &req[i], &y);
+        TEST_ASSERT(req[i].rc == rc);
+        if (rc == 0) {
+            TEST_ASSERT(req[i].y == y);
+        }
+    }
+    TEST_ASSERT(req[5].rc == OS_EINVAL);
+    TEST_ASSERT(isnan(req[5].y));
+
+#if !MYNEWT_VAL(INTERPOLATE_PTHREAD)
+    /* Without a thread, all 40 were queued: one batch per table. */
+    TEST_ASSERT(st.svc.batches == 3);
+#endif
+
+    intpl_svc_deinit(&st.svc);
+    TEST_ASSERT(st.svc.reqs == 40);
+}
+
+TEST_CASE(svc_threads)
+{
+    int rc;
+    static struct svc_test st;
+    struct intpl_pool pool;
+
+    /* Test 1: Four tasks submitting bursts of requests at once. Without
+     * INTERPOLATE_PTHREAD the parts run one after the other. */
+    svc_test_init(&st);
+    rc = intpl_pool_init(&pool, 4);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_pool_run(&pool, svc_test_fn, &st);
+    TEST_ASSERT(rc == 0);
+    intpl_pool_deinit(&pool);
+    intpl_svc_deinit(&st.svc);
+    TEST_ASSERT(st.bad == 0);
+    TEST_ASSERT(st.svc.reqs == 4 * 50 * 16);
+    TEST_ASSERT(st.svc.batches < st.svc.reqs);
+}
@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_par.h"
+#include "interpolate/interpolate_swap.h"
+
+struct swap_test {
+    struct intpl_swap sw;
+    unsigned int published;
+    unsigned int bad;
+};
+
+/* Part 0 publishes new versions, where every y equals the version, while
+ * the other parts check that they only ever see complete tables. */
+static void
+swap_test_fn(void *arg, unsigned int part, unsigned int nparts)
+{
+    struct swap_test *st;
+    struct intpl_swap_ref ref;
+    const struct intpl_xyc *xyc;
+    struct intpl_xyc *w;
+    unsigned int i;
+    unsigned int j;
+    void *tbl;
+
+    (void)nparts;
+
+    st = arg;
+    if (part == 0) {
+        for (i = 1; i <= 2000; i++) {
+            while (intpl_swap_begin(&st->sw, &tbl) == OS_EBUSY) {
+            }
+            w = tbl;
+            for (j = 0; j < 8; j++) {
+                w[j].x = (float)j;
+                w[j].y = (float)i;
+            }
+            intpl_cubic_calc(w, 8, 1e30f, 1e30f);
+            intpl_swap_publish(&st->sw, 8);
+        }
+        st->published = i - 1;
+        return;
+    }
+
+    for (i = 0; i < 20000; i++) {
+        intpl_swap_acquire(&st->sw, &ref);
+        xyc = ref.tbl;
+        if (ref.gen != 0) {
+            if (ref.n != 8) {
+                __atomic_add_fetch(&st->bad, 1, __ATOMIC_SEQ_CST);
+            }
+            for (j = 0; j < ref.n; j++) {
+                if (xyc[j].y != (float)ref.gen || xyc[j].y2 != 0.0f) {
+                    __atomic_add_fetch(&st->bad, 1, __ATOMIC_SEQ_CST);
+                }
+            }
+        }
+        intpl_swap_release(&st->sw, &ref);
+    }
+}
+
+TEST_CASE(swap)
+{
+    int rc;
+    float y;
+    void *tbl;
+    struct intpl_xy *xy;
+    struct intpl_xy a[4];
+    struct intpl_xy b[4];
+    struct intpl_swap sw;
+    struct intpl_swap_ref ref;
+
+    rc = intpl_swap_init(&sw, INTPL_SWAP_XY, a, b, 4);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* Test 1: Nothing published yet. */
+    rc = intpl_swap_lin_y(&sw, 1.0f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(y));
+    rc = intpl_swap_cubic(&sw, 1.0f, &y);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    /* Test 2: Publish a table. */
+    rc = intpl_swap_begin(&sw, &tbl);
+    TEST_ASSERT_FATAL(rc == 0);
+    xy = tbl;
+    xy[0].x = 0.0f;
+    xy[0].y = 0.0f;
+    xy[1].x = 1.0f;
+    xy[1].y = 10.0f;
+    rc = intpl_swap_publish(&sw, 2);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_swap_lin_y(&sw, 0.5f, &y);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(y == 5.0f);
+
+    /* Test 3: A reader holding a table keeps it alive across a publish,
+     * and blocks the writer from reusing it. */
+    intpl_swap_acquire(&sw, &ref);
+    TEST_ASSERT(ref.gen == 1 && ref.n == 2);
+    rc = intpl_swap_begin(&sw, &tbl);
+    TEST_ASSERT_FATAL(rc == 0);
+    xy = tbl;
+    xy[0].x = 0.0f;
+    xy[0].y = 0.0f;
+    xy[1].x = 1.0f;
+    xy[1].y = 20.0f;
+    rc = intpl_swap_publish(&sw, 2);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_swap_lin_y(&sw, 0.5f, &y);
+    TEST_ASSERT(y == 10.0f);
+    TEST_ASSERT(((const struct intpl_xy *)ref.tbl)[1].y == 10.0f);
+    rc = intpl_swap_begin(&sw, &tbl);
+    TEST_ASSERT(rc == OS_EBUSY);
+    intpl_swap_release(&sw, &ref);
+    rc = intpl_swap_begin(&sw, &tbl);
+    TEST_ASSERT(rc == 0);
+
+    /* Test 4: Invalid arguments. */
+    TEST_ASSERT(intpl_swap_publish(&sw, 5) == OS_EINVAL);
+    TEST_ASSERT(intpl_swap_init(&sw, INTPL_SWAP_XY, a, a, 4) == OS_EINVAL);
+}
+
+TEST_CASE(swap_threads)
+{
+    int rc;
+    struct intpl_xyc a[8];
+    struct intpl_xyc b[8];
+    struct intpl_pool pool;
+    struct swap_test st;
+
+    /* Test 1: One writer and three readers. Without INTERPOLATE_PTHREAD
+     * the parts run one after the other. */
+    st.published = 0;
+    st.bad = 0;
+    rc = intpl_swap_init(&st.sw, INTPL_SWAP_XYC, a, b, 8);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_pool_init(&pool, 4);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_pool_run(&pool, swap_test_fn, &st);
+    TEST_ASSERT(rc == 0);
+    intpl_pool_deinit(&pool);
+    TEST_ASSERT(st.published == 2000);
+    TEST_ASSERT(st.bad == 0);
+}
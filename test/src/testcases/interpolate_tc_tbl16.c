@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "interpolate_test_priv.h"
+#include "interpolate/interpolate_tbl16.h"
+
+TEST_CASE(tbl16_f16)
+{
+    uint32_t h;
+    float f;
+
+    /* Test 1: Known values. */
+    TEST_ASSERT(intpl_f32_to_f16(1.0f) == 0x3C00);
+    TEST_ASSERT(intpl_f32_to_f16(-2.0f) == 0xC000);
+    TEST_ASSERT(intpl_f32_to_f16(65504.0f) == 0x7BFF);
+    TEST_ASSERT(intpl_f32_to_f16(5.9604645E-8F) == 0x0001);
+    TEST_ASSERT(intpl_f32_to_f16(1E6F) == 0x7C00);
+    TEST_ASSERT(intpl_f16_to_f32(0x3555) == 0.333251953125f);
+
+    /* Test 2: Ties round to even. */
+    TEST_ASSERT(intpl_f32_to_f16(1.0f + 1.0f / 2048.0f) == 0x3C00);
+    TEST_ASSERT(intpl_f32_to_f16(1.0f + 3.0f / 2048.0f) == 0x3C02);
+
+    /* Test 3: Every finite half survives a round trip. */
+    for (h = 0; h < 0x10000; h++) {
+        if ((h & 0x7C00) == 0x7C00) {
+            continue;
+        }
+        f = intpl_f16_to_f32((uint16_t)h);
+        TEST_ASSERT(intpl_f32_to_f16(f) == h);
+    }
+}
+
+TEST_CASE(tbl16_lin_y)
+{
+    int rc;
+    unsigned int i;
+    uint8_t fx;
+    uint8_t fy;
+    float err;
+    float x[64];
+    float y[64];
+    float ref;
+    float out[16];
+    uint16_t xbuf[32];
+    uint16_t ybuf[32];
+    struct intpl_xy xy[32];
+    struct intpl_tbl16 tbl;
+
+    for (i = 0; i < 32; i++) {
+        xy[i].x = (float)i * 0.5f;
+        xy[i].y = 20.0f + 5.0f * sinf(xy[i].x);
+    }
+
+    /* Test 1: A loose tolerance allows 16-bit x and y. */
+    rc = intpl_tbl16_pick(xy, 32, 0.01f, &fx, &fy, &err);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(fx != INTPL_FMT_F32 && fy != INTPL_FMT_F32);
+    TEST_ASSERT(err <= 0.01f);
+
+    /* Test 2: No tolerance keeps y in full precision, while x (multiples
+     * of 0.5) is exact in half precision. */
+    rc = intpl_tbl16_pick(xy, 32, 0.0f, &fx, &fy, &err);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(fx == INTPL_FMT_F16 && fy == INTPL_FMT_F32);
+    TEST_ASSERT(err == 0.0f);
+
+    /* Test 3: Lookups stay within the error bound. */
+    rc = intpl_tbl16_pick(xy, 32, 0.01f, &fx, &fy, &err);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = intpl_tbl16_encode(xy, 32, fx, fy, xbuf, ybuf, &tbl);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 64; i++) {
+        x[i] = 0.1f + (float)i * 0.24f;
+    }
+    rc = intpl_tbl16_lin_y_batch(&tbl, x, y, 64, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 64; i++) {
+        rc = intpl_lin_y_arr(xy, 32, x[i], &ref);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(f_is_equal(y[i], ref, err + 1E-5F, "tbl16_lin_y 3"));
+    }
+
+    /* Test 4: Scalar lookups match the batch. */
+    rc = intpl_tbl16_lin_y(&tbl, x[17], &ref);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ref == y[17]);
+    rc = intpl_tbl16_nn(&tbl, 1.3f, &ref);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(f_is_equal(ref, xy[3].y, err + 1E-5F, "tbl16_lin_y 4"));
+
+    /* Test 5: Widening the whole y array. */
+    rc = intpl_tbl16_widen(tbl.fmt_y, tbl.y, tbl.y_scale, tbl.y_off, out, 16);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < 16; i++) {
+        TEST_ASSERT(f_is_equal(out[i], xy[i].y, err + 1E-5F, "tbl16 5"));
+    }
+
+    /* Test 6: Out of range. */
+    rc = intpl_tbl16_lin_y(&tbl, -1.0f, &ref);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+    TEST_ASSERT(isnan(ref));
+
+    /* Test 7: Values too large for half precision. */
+    xy[3].y = 1E5F;
+    rc = intpl_tbl16_encode(xy, 32, INTPL_FMT_F32, INTPL_FMT_F16, x, ybuf,
+        &tbl);
+    TEST_ASSERT_FATAL(rc == OS_EINVAL);
+}